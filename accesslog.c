@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <arpa/inet.h>
+#include "accesslog.h"
+
+#define LOG_BUF_SIZE (64 << 10) // formatted lines collected before a writev
+#define LOG_LINE_MAX 4096       // longest line a record can format to, escapes included
+#define LOG_IOV_MAX 64          // ring segments gathered into one writev
+#define LOG_IDLE_NS 10000000    // pause after a pass that found nothing
+
+static struct access_ring **rings;  // every worker's ring, fixed before the thread starts
+static int nrings;
+
+static const char *log_path;
+static enum access_log_format log_format;
+static int log_fd = -1;
+static pthread_t log_thread;
+static int log_running;
+static int stop_requested;          // set by accesslog_stop, polled by the log thread
+static int reopen_requested;        // set from signal handlers, hence atomics only
+
+static char out[LOG_BUF_SIZE];      // only touched by the log thread
+
+int access_ring_init(struct access_ring *ring, uint32_t size) {
+    uint32_t n = 2;
+
+    while (n < size && n < (1u << 24)) {
+        n <<= 1;
+    }
+    struct access_ring **grown = realloc(rings, (nrings + 1) * sizeof(*rings));
+    if (grown == NULL) {
+        return -1;
+    }
+    rings = grown;
+
+    ring->slots = malloc(n * sizeof(*ring->slots));
+    if (ring->slots == NULL) {
+        return -1;
+    }
+    ring->mask = n - 1;
+    ring->head = ring->tail = 0;
+    ring->dropped = 0;
+    rings[nrings++] = ring;
+    return 0;
+}
+
+void access_ring_push(struct access_ring *ring, const struct access_record *rec) {
+    if (ring->slots == NULL) {
+        return;//logging is off
+    }
+
+    uint32_t head = ring->head;//only this thread writes it
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) > ring->mask) {
+        __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+        return;
+    }
+    memcpy(&ring->slots[head & ring->mask], rec, sizeof(*rec));
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);//publishes the slot
+}
+
+unsigned long accesslog_dropped(void) {
+    unsigned long total = 0;
+
+    for (int i = 0; i < nrings; i++) {
+        total += __atomic_load_n(&rings[i]->dropped, __ATOMIC_RELAXED);
+    }
+    return total;
+}
+
+static int open_log(void) {
+    if (strcmp(log_path, "-") == 0) {
+        return STDOUT_FILENO;
+    }
+    return open(log_path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+}
+
+// Swap in a freshly opened file so a rotated-away one can be compressed or removed
+static void reopen_log(void) {
+    if (log_fd == STDOUT_FILENO) {
+        return;
+    }
+
+    int fd = open_log();
+    if (fd < 0) {
+        perror(log_path);//keep writing to the old file
+        return;
+    }
+    close(log_fd);
+    log_fd = fd;
+}
+
+// Write every segment, continuing after short writes. Lines that cannot be
+// written (disk full, broken pipe) are lost; the log must not stall the server.
+static void write_all(struct iovec *iov, int n) {
+    while (n > 0) {
+        ssize_t w = writev(log_fd, iov, n);
+        if (w < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        while (n > 0 && (size_t)w >= iov->iov_len) {
+            w -= iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + w;
+            iov->iov_len -= w;
+        }
+    }
+}
+
+// Append s quoted for a CLF field: '"', '\\' and bytes outside printable
+// ASCII become escapes, as Apache writes them
+static char *put_clf(char *p, const char *s, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+
+    if (len == 0) {
+        *p++ = '-';
+        return p;
+    }
+    for (size_t i = 0; i < len; i++) {
+        unsigned char ch = s[i];
+
+        if (ch == '"' || ch == '\\') {
+            *p++ = '\\';
+            *p++ = ch;
+        } else if (ch < 0x20 || ch >= 0x7f) {
+            *p++ = '\\';
+            *p++ = 'x';
+            *p++ = hex[ch >> 4];
+            *p++ = hex[ch & 15];
+        } else {
+            *p++ = ch;
+        }
+    }
+    return p;
+}
+
+// Append s as the body of a JSON string
+static char *put_json(char *p, const char *s, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+
+    for (size_t i = 0; i < len; i++) {
+        unsigned char ch = s[i];
+
+        if (ch == '"' || ch == '\\') {
+            *p++ = '\\';
+            *p++ = ch;
+        } else if (ch < 0x20 || ch == 0x7f) {
+            memcpy(p, "\\u00", 4);
+            p[4] = hex[ch >> 4];
+            p[5] = hex[ch & 15];
+            p += 6;
+        } else {
+            *p++ = ch;
+        }
+    }
+    return p;
+}
+
+static char *put_str(char *p, const char *s) {
+    size_t len = strlen(s);
+
+    memcpy(p, s, len);
+    return p + len;
+}
+
+// Timestamps for the second being formatted; records arrive in bursts from
+// the same second, so localtime_r and strftime run about once a second
+static struct {
+    time_t sec;
+    char clf[32];   // 17/Oct/2026:12:00:00 +0200
+    char iso[24];   // 2026-10-17T12:00:00
+    char zone[8];   // +0200
+} stamp = { -1, "", "", "" };
+
+static void update_stamp(time_t sec) {
+    struct tm tm;
+
+    if (sec == stamp.sec) {
+        return;
+    }
+    localtime_r(&sec, &tm);
+    strftime(stamp.clf, sizeof(stamp.clf), "%d/%b/%Y:%H:%M:%S %z", &tm);
+    strftime(stamp.iso, sizeof(stamp.iso), "%Y-%m-%dT%H:%M:%S", &tm);
+    strftime(stamp.zone, sizeof(stamp.zone), "%z", &tm);
+    stamp.sec = sec;
+}
+
+// Format one record as a line at p; returns the end of the line
+static char *format_record(char *p, const struct access_record *r) {
+    char addr[INET_ADDRSTRLEN];
+    struct in_addr in = { r->addr };
+
+    inet_ntop(AF_INET, &in, addr, sizeof(addr));
+    update_stamp(r->start.tv_sec);
+
+    if (log_format == LOG_JSON) {
+        p += sprintf(p, "{\"time\":\"%s.%03ld%s\",\"remote_addr\":\"%s\",\"remote_port\":%u,\"method\":\"",
+                     stamp.iso, r->start.tv_nsec / 1000000, stamp.zone, addr, r->port);
+        p = put_json(p, r->method, r->method_len);
+        p = put_str(p, "\",\"target\":\"");
+        p = put_json(p, r->target, r->target_len);
+        p = put_str(p, "\",\"protocol\":\"");
+        if (r->method_len != 0) {
+            p += sprintf(p, "HTTP/1.%u", r->version_minor);
+        }
+        p += sprintf(p, "\",\"status\":%u,\"bytes\":%llu,\"duration_us\":%u,\"referer\":\"",
+                     r->status, (unsigned long long)r->bytes, r->duration_us);
+        p = put_json(p, r->referer, r->referer_len);
+        p = put_str(p, "\",\"user_agent\":\"");
+        p = put_json(p, r->agent, r->agent_len);
+        p = put_str(p, "\"}\n");
+        return p;
+    }
+
+    p += sprintf(p, "%s - - [%s] \"", addr, stamp.clf);
+    if (r->method_len == 0) {
+        *p++ = '-';//no request line could be parsed
+    } else {
+        p = put_clf(p, r->method, r->method_len);
+        *p++ = ' ';
+        p = put_clf(p, r->target, r->target_len);
+        p += sprintf(p, " HTTP/1.%u", r->version_minor);
+    }
+    p += sprintf(p, "\" %u ", r->status);
+    p += r->bytes ? sprintf(p, "%llu", (unsigned long long)r->bytes) : sprintf(p, "-");
+    if (log_format == LOG_COMBINED) {
+        p = put_str(p, " \"");
+        p = put_clf(p, r->referer, r->referer_len);
+        p = put_str(p, "\" \"");
+        p = put_clf(p, r->agent, r->agent_len);
+        *p++ = '"';
+    }
+    *p++ = '\n';
+    return p;
+}
+
+// Format and write whatever the rings hold, one iovec per ring per batch.
+// Returns how many records were taken.
+static size_t drain(void) {
+    struct iovec iov[LOG_IOV_MAX];
+    int niov = 0;
+    char *p = out;
+    size_t taken = 0;
+
+    for (int i = 0; i < nrings; i++) {
+        struct access_ring *ring = rings[i];
+        uint32_t tail = ring->tail;//only this thread writes it
+        uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        char *start = p;
+
+        for (; tail != head; tail++) {
+            if (out + sizeof(out) - p < LOG_LINE_MAX || niov == LOG_IOV_MAX) {
+                if (p > start) {
+                    iov[niov++] = (struct iovec){ start, p - start };
+                }
+                write_all(iov, niov);
+                niov = 0;
+                p = start = out;
+            }
+            p = format_record(p, &ring->slots[tail & ring->mask]);
+            taken++;
+        }
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);//slots are free again
+
+        if (p > start) {
+            iov[niov++] = (struct iovec){ start, p - start };
+        }
+    }
+    if (niov > 0) {
+        write_all(iov, niov);
+    }
+    return taken;
+}
+
+static void *log_main(void *arg) {
+    (void)arg;
+    for (;;) {
+        int stopping = __atomic_load_n(&stop_requested, __ATOMIC_ACQUIRE);
+
+        if (__atomic_exchange_n(&reopen_requested, 0, __ATOMIC_RELAXED)) {
+            reopen_log();
+        }
+        if (drain() == 0) {
+            if (stopping) {
+                break;//workers are gone and the rings are empty
+            }
+            struct timespec idle = { 0, LOG_IDLE_NS };
+            nanosleep(&idle, NULL);
+        }
+    }
+    return NULL;
+}
+
+int accesslog_start(const char *path, enum access_log_format format) {
+    sigset_t all, old;
+
+    log_path = path;
+    log_format = format;
+    log_fd = open_log();
+    if (log_fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    sigfillset(&all);
+    pthread_sigmask(SIG_BLOCK, &all, &old);//signals stay with the threads that handle them
+    int err = pthread_create(&log_thread, NULL, log_main, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (err != 0) {
+        fprintf(stderr, "access log thread: %s\n", strerror(err));
+        return -1;
+    }
+    log_running = 1;
+    return 0;
+}
+
+void accesslog_reopen(void) {
+    __atomic_store_n(&reopen_requested, 1, __ATOMIC_RELAXED);
+}
+
+void accesslog_stop(void) {
+    if (!log_running) {
+        return;
+    }
+    __atomic_store_n(&stop_requested, 1, __ATOMIC_RELEASE);
+    pthread_join(log_thread, NULL);
+    log_running = 0;
+    if (log_fd != STDOUT_FILENO) {
+        close(log_fd);
+    }
+    log_fd = -1;
+}
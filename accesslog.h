@@ -0,0 +1,69 @@
+#ifndef ACCESSLOG_H
+#define ACCESSLOG_H
+
+#include <stdint.h>
+#include <time.h>
+
+// Access log. Each worker copies a fixed-size binary record per request into
+// its own single-producer ring; a background thread drains every ring,
+// formats the lines and appends them with writev. The request path never
+// blocks, allocates or takes a lock: when a ring is full the record is
+// dropped and counted instead.
+
+enum access_log_format {
+    LOG_COMMON,     // NCSA Common Log Format
+    LOG_COMBINED,   // Common plus Referer and User-Agent
+    LOG_JSON,       // one JSON object per line
+};
+
+// One request, filled in at dispatch and completed when the response ends.
+// Strings are truncated to their fields.
+struct access_record {
+    struct timespec start;  // CLOCK_REALTIME when the request was dispatched
+    int64_t begin_us;       // CLOCK_MONOTONIC when the request's first byte arrived
+    uint32_t duration_us;   // from begin_us until the response ended
+    uint32_t addr;          // client IPv4 address, network order
+    uint16_t port;          // client port, host order
+    uint16_t status;
+    uint64_t bytes;         // sent on the socket, headers included
+    uint8_t version_minor;
+    uint8_t method_len;
+    uint8_t target_len;
+    uint8_t referer_len;
+    uint8_t agent_len;
+    char method[16];
+    char target[255];
+    char referer[128];
+    char agent[160];
+};
+
+// Single-producer single-consumer ring of records
+struct access_ring {
+    struct access_record *slots;
+    uint32_t mask;                              // slot count - 1
+    uint32_t head __attribute__((aligned(64))); // next slot to fill, written by the worker
+    uint32_t tail __attribute__((aligned(64))); // next slot to drain, written by the log thread
+    unsigned long dropped;                      // records lost to a full ring
+};
+
+// Allocate a ring of at least size records and add it to the set the log
+// thread drains. Call before accesslog_start().
+int access_ring_init(struct access_ring *ring, uint32_t size);
+
+// Queue a finished record; drops it (and counts) if the ring is full
+void access_ring_push(struct access_ring *ring, const struct access_record *rec);
+
+// Open path ("-" for stdout) and start the log thread; -1 (after printing
+// why) on failure. Call once every ring is set up.
+int accesslog_start(const char *path, enum access_log_format format);
+
+// Ask the log thread to reopen its file, e.g. after rotation. Async-signal-safe.
+void accesslog_reopen(void);
+
+// Drain what is queued and stop the log thread
+void accesslog_stop(void);
+
+// Records dropped so far across all rings
+unsigned long accesslog_dropped(void);
+
+#endif // ACCESSLOG_H
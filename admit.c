@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include "admit.h"
+
+// One client address's share of the limits
+struct admit_slot {
+    uint32_t conns;         // open connections
+    uint32_t pad;
+    int64_t tat_us;         // when the request bucket is next full again, roughly
+};
+
+static unsigned long open_conns;//every worker's, admitted and not yet released
+static unsigned long max_conns;
+static uint32_t ip_conns;
+static long long interval_us;   // between tokens, 0 when requests are not limited
+static long long tolerance_us;  // burst intervals
+static struct admit_slot *slots;//NULL without per-address limits
+
+int admit_init(int max_connections, int per_ip_connections, int per_ip_rate, int per_ip_burst) {
+    max_conns = max_connections > 0 ? max_connections : 0;
+    ip_conns = per_ip_connections > 0 ? per_ip_connections : 0;
+    if (per_ip_rate > 0) {
+        interval_us = 1000000LL / per_ip_rate;
+        if (interval_us == 0) {
+            interval_us = 1;
+        }
+        tolerance_us = (per_ip_burst > 0 ? per_ip_burst : per_ip_rate) * interval_us;
+    }
+    if (ip_conns == 0 && interval_us == 0) {
+        return 0;
+    }
+    slots = calloc(ADMIT_SLOTS, sizeof(*slots));
+    return slots == NULL ? -1 : 0;
+}
+
+static struct admit_slot *slot_of(uint32_t addr) {
+    return &slots[(uint32_t)(addr * 2654435769u) >> (32 - __builtin_ctz(ADMIT_SLOTS))];//Fibonacci hashing
+}
+
+enum admit_verdict admit_connection(uint32_t addr) {
+    if (__atomic_add_fetch(&open_conns, 1, __ATOMIC_RELAXED) > max_conns && max_conns > 0) {
+        __atomic_sub_fetch(&open_conns, 1, __ATOMIC_RELAXED);
+        return ADMIT_BUSY;
+    }
+    if (ip_conns > 0) {
+        struct admit_slot *s = slot_of(addr);
+
+        if (__atomic_add_fetch(&s->conns, 1, __ATOMIC_RELAXED) > ip_conns) {
+            __atomic_sub_fetch(&s->conns, 1, __ATOMIC_RELAXED);
+            __atomic_sub_fetch(&open_conns, 1, __ATOMIC_RELAXED);
+            return ADMIT_LIMITED;
+        }
+    }
+    return ADMIT_OK;
+}
+
+void admit_release(uint32_t addr) {
+    __atomic_sub_fetch(&open_conns, 1, __ATOMIC_RELAXED);
+    if (ip_conns > 0) {
+        __atomic_sub_fetch(&slot_of(addr)->conns, 1, __ATOMIC_RELAXED);
+    }
+}
+
+enum admit_verdict admit_request(uint32_t addr, long long now_us, int *retry_after) {
+    if (interval_us == 0) {
+        return ADMIT_OK;
+    }
+
+    struct admit_slot *s = slot_of(addr);
+    int64_t tat = __atomic_load_n(&s->tat_us, __ATOMIC_RELAXED);
+    for (;;) {
+        int64_t t = tat > now_us ? tat : now_us;//an idle bucket starts full, not in credit
+        int64_t wait = t + interval_us - tolerance_us - now_us;
+
+        if (wait > 0) {//all burst tokens taken
+            *retry_after = (int)((wait + 999999) / 1000000);
+            return ADMIT_LIMITED;
+        }
+        if (__atomic_compare_exchange_n(&s->tat_us, &tat, t + interval_us, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            return ADMIT_OK;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef ADMIT_H
+#define ADMIT_H
+
+#include <stdint.h>
+
+// Admission control, shared by all workers. Decisions are a handful of
+// atomic operations on fixed memory, so they take no locks and never wait
+// on another worker however many connections arrive at once:
+//
+//  - a server-wide count of open connections against max_connections;
+//  - a per-client-address table of open connections and a request token
+//    bucket. The table has no keys: an IPv4 address hashes straight to one
+//    of ADMIT_SLOTS slots. Addresses that happen to share a slot share its
+//    limits, which only ever errs towards limiting.
+//
+// The bucket is kept as a single "theoretical arrival time" (GCRA): a
+// request may go ahead when the bucket's time is less than burst intervals
+// in the future, and moves it one interval on. That is a token bucket of
+// burst tokens refilled at rate per second, updated with one CAS.
+
+#define ADMIT_SLOTS 65536   // power of two; 16 bytes each, allocated only for per-address limits
+
+enum admit_verdict {
+    ADMIT_OK,
+    ADMIT_BUSY,             // server-wide limit reached: 503
+    ADMIT_LIMITED,          // this client is over its own limit: 429
+};
+
+// Set the limits, 0 meaning none; burst 0 is one second's worth of rate.
+// Call once before any worker runs. Returns -1 if the table cannot be allocated.
+int admit_init(int max_connections, int per_ip_connections, int per_ip_rate, int per_ip_burst);
+
+// Count a new connection from addr (network byte order) against the limits.
+// On ADMIT_OK the caller owes an admit_release when it closes.
+enum admit_verdict admit_connection(uint32_t addr);
+
+// The connection admitted for addr has closed
+void admit_release(uint32_t addr);
+
+// Take a token from addr's request bucket at monotonic time now_us. When
+// over the rate, returns ADMIT_LIMITED with the seconds until a token is
+// due in *retry_after.
+enum admit_verdict admit_request(uint32_t addr, long long now_us, int *retry_after);
+
+#endif // ADMIT_H
@@ -0,0 +1,695 @@
+// Closed-loop HTTP/1.1 load generator: every connection sends its next
+// request as soon as the previous response is complete.
+//
+//   cc -O2 -pthread -o loadgen loadgen.c
+//   ./loadgen [-c conns] [-t threads] [-d secs] [-w secs] [-C] [-m method]
+//             [-b body_bytes] [-H header] [-p server_pid] [-n label] [-j] http://host:port/path
+//
+// Each thread drives its share of the connections from one epoll set. Only
+// requests started after the warm-up count. Latency is kept in a log-linear
+// histogram (within 1%), so p50/p99/p99.9 need no per-request storage. With
+// -p, the server's CPU time over the measured window is read from /proc and
+// reported per request next to the generator's own, and so is the number of
+// system calls its threads made, if the raw_syscalls:sys_enter tracepoint
+// can be counted (tracefs mounted, perf events allowed). -j prints one JSON
+// object instead of the text summary, for run.sh.
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <netdb.h>
+#include <time.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/perf_event.h>
+
+#define SUB_BITS 7              // 128 steps per power of two of nanoseconds
+#define MAX_BITS 40             // about 18 minutes
+#define NBUCKETS ((MAX_BITS - SUB_BITS + 1) << SUB_BITS)
+#define HEAD_MAX 8192
+#define READ_SIZE (256 << 10)
+#define MAX_TASKS 1024          // server threads whose system calls are counted
+
+enum conn_state { C_CONNECT, C_WRITE, C_READ };
+
+// How the rest of the body is delimited
+enum body_state {
+    B_LENGTH,       // remaining bytes are known
+    B_UNTIL_CLOSE,  // no length, ends with the connection
+    B_CHUNK_SIZE,   // reading a chunk-size line
+    B_CHUNK_DATA,
+    B_CHUNK_END,    // CRLF after chunk data
+    B_TRAILER,      // trailer lines up to the blank one
+};
+
+struct conn {
+    int fd;
+    enum conn_state state;
+    size_t woff;            // bytes of the request sent
+    long long started;      // ns when the request was first written
+
+    char head[HEAD_MAX];    // response head collected so far
+    size_t hlen;
+    int head_done;
+    int status;
+    int keep;               // server keeps the connection open
+    enum body_state body;
+    long long remaining;    // of the body or current chunk
+    char line[32];          // chunk-size line so far
+    size_t line_len;
+};
+
+struct stats {
+    unsigned long hist[NBUCKETS + 1];
+    unsigned long requests;
+    unsigned long errors;   // connect, reset or malformed responses
+    unsigned long classes[6]; // by status / 100
+    unsigned long long bytes;
+    long long max_ns;
+};
+
+struct thread {
+    pthread_t tid;
+    int nconns;
+    struct conn *conns;
+    int epfd;
+    struct stats st;
+};
+
+static struct addrinfo *target;
+static char *request;
+static size_t request_len;
+static int close_each;          // -C: one request per connection
+static int head_method;
+static long long measure_from;  // ns; requests started earlier are not counted
+static int stop;
+
+static long long now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static unsigned bucket(long long ns) {
+    unsigned long long v = ns > 0 ? (unsigned long long)ns : 0;
+
+    if (v < (1u << SUB_BITS)) {
+        return (unsigned)v;
+    }
+
+    unsigned e = 63 - __builtin_clzll(v);
+    unsigned i = ((e - SUB_BITS + 1) << SUB_BITS) + ((v >> (e - SUB_BITS)) & ((1u << SUB_BITS) - 1));
+    return i < NBUCKETS ? i : NBUCKETS;
+}
+
+// Middle of bucket i in nanoseconds
+static double bucket_value(unsigned i) {
+    if (i < (1u << SUB_BITS)) {
+        return i;
+    }
+
+    unsigned shift = (i >> SUB_BITS) - 1;
+    double lo = (double)(((1ull << SUB_BITS) + (i & ((1u << SUB_BITS) - 1))) << shift);
+    return lo + (double)(1ull << shift) / 2;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-c conns] [-t threads] [-d secs] [-w secs] [-C] [-m method]\n"
+                    "       [-b body_bytes] [-H header] [-p server_pid] [-n label] [-j] http://host:port/path\n", prog);
+}
+
+static int conn_open(struct thread *t, struct conn *c) {
+    memset(c, 0, sizeof(*c));
+    c->fd = socket(target->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (c->fd < 0) {
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(c->fd, target->ai_addr, target->ai_addrlen) < 0 && errno != EINPROGRESS) {
+        close(c->fd);
+        return -1;
+    }
+    c->state = C_CONNECT;
+
+    struct epoll_event ev = { .events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, .data.ptr = c };
+    if (epoll_ctl(t->epfd, EPOLL_CTL_ADD, c->fd, &ev) < 0) {
+        close(c->fd);
+        return -1;
+    }
+    return 0;
+}
+
+// Close c and start over on a fresh socket, which reports in through epoll
+static void conn_restart(struct thread *t, struct conn *c, int failed) {
+    if (failed && measure_from > 0) {
+        t->st.errors++;
+    }
+    close(c->fd);
+    while (conn_open(t, c) < 0 && !__atomic_load_n(&stop, __ATOMIC_RELAXED)) {
+        t->st.errors++;
+        usleep(1000);
+    }
+}
+
+// Parse the status line and the framing headers once the head is complete.
+// Returns the head length, 0 if more is needed and -1 if it is malformed.
+static int parse_head(struct conn *c) {
+    char *end = memmem(c->head, c->hlen, "\r\n\r\n", 4);
+
+    if (end == NULL) {
+        return c->hlen == sizeof(c->head) ? -1 : 0;
+    }
+    *end = '\0';
+    if (c->hlen < 12 || strncmp(c->head, "HTTP/1.", 7) != 0) {
+        return -1;
+    }
+    c->status = atoi(c->head + 9);
+    c->keep = c->head[7] == '1' && !close_each;
+    c->body = B_UNTIL_CLOSE;
+    c->remaining = 0;
+
+    for (char *p = strstr(c->head, "\r\n"); p != NULL; p = strstr(p, "\r\n")) {
+        p += 2;
+        if (strncasecmp(p, "content-length:", 15) == 0) {
+            c->body = B_LENGTH;
+            c->remaining = atoll(p + 15);
+        } else if (strncasecmp(p, "transfer-encoding:", 18) == 0 && strcasestr(p, "chunked") != NULL) {
+            c->body = B_CHUNK_SIZE;
+        } else if (strncasecmp(p, "connection:", 11) == 0) {
+            char *v = p + 11;
+
+            while (*v == ' ') {
+                v++;
+            }
+            if (strncasecmp(v, "close", 5) == 0) {
+                c->keep = 0;
+            } else if (strncasecmp(v, "keep-alive", 10) == 0) {
+                c->keep = !close_each;
+            }
+        }
+    }
+    if (head_method || c->status == 204 || c->status == 304 || c->status / 100 == 1) {
+        c->body = B_LENGTH;
+        c->remaining = 0;
+    }
+    if (c->body == B_UNTIL_CLOSE) {
+        c->keep = 0;
+    }
+    c->head_done = 1;
+    return (int)(end + 4 - c->head);
+}
+
+// Feed body bytes. Returns 1 once the response is complete, 0 for more and
+// -1 on a malformed chunk.
+static int consume_body(struct conn *c, const char *p, size_t n) {
+    const char *end = p + n;
+
+    for (;;) {
+        switch (c->body) {
+        case B_LENGTH:
+            if ((long long)(end - p) >= c->remaining) {
+                return 1;//anything after it would be unsolicited
+            }
+            c->remaining -= end - p;
+            return 0;
+        case B_UNTIL_CLOSE:
+            return 0;
+        case B_CHUNK_DATA:
+            if ((long long)(end - p) < c->remaining) {
+                c->remaining -= end - p;
+                return 0;
+            }
+            p += c->remaining;
+            c->body = B_CHUNK_END;
+            c->remaining = 2;
+            break;
+        case B_CHUNK_END:
+            while (p < end && c->remaining > 0) {
+                p++;
+                c->remaining--;
+            }
+            if (c->remaining > 0) {
+                return 0;
+            }
+            c->body = B_CHUNK_SIZE;
+            break;
+        case B_CHUNK_SIZE:
+        case B_TRAILER:
+            while (p < end && *p != '\n') {
+                if (c->line_len == sizeof(c->line) - 1 && c->body == B_CHUNK_SIZE) {
+                    return -1;
+                }
+                if (c->line_len < sizeof(c->line) - 1) {
+                    c->line[c->line_len++] = *p;
+                }
+                p++;
+            }
+            if (p == end) {
+                return 0;
+            }
+            p++;
+            c->line[c->line_len] = '\0';
+            if (c->body == B_TRAILER) {
+                if (c->line_len <= 1) {
+                    return 1;//blank line ends the trailer
+                }
+            } else {
+                c->remaining = strtoll(c->line, NULL, 16);
+                c->body = c->remaining == 0 ? B_TRAILER : B_CHUNK_DATA;
+            }
+            c->line_len = 0;
+            break;
+        }
+    }
+}
+
+static void record(struct thread *t, struct conn *c) {
+    long long now = now_ns();
+
+    if (measure_from == 0 || c->started < measure_from) {
+        return;//warm-up
+    }
+    long long ns = now - c->started;
+
+    t->st.hist[bucket(ns)]++;
+    t->st.requests++;
+    t->st.classes[c->status / 100 < 6 ? c->status / 100 : 0]++;
+    if (ns > t->st.max_ns) {
+        t->st.max_ns = ns;
+    }
+}
+
+// Move c along until its socket would block
+static void drive(struct thread *t, struct conn *c, char *buf) {
+    for (;;) {
+        if (c->state == C_CONNECT) {
+            int err = 0;
+            socklen_t len = sizeof(err);
+
+            getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+            if (err == EINPROGRESS || err == EALREADY) {
+                return;
+            }
+            if (err != 0) {
+                conn_restart(t, c, 1);
+                return;
+            }
+            c->state = C_WRITE;
+            c->woff = 0;
+            c->started = now_ns();
+        }
+
+        if (c->state == C_WRITE) {
+            while (c->woff < request_len) {
+                ssize_t n = send(c->fd, request + c->woff, request_len - c->woff, MSG_NOSIGNAL);
+                if (n < 0) {
+                    if (errno == EAGAIN || errno == ENOTCONN) {
+                        return;//ENOTCONN: connect still in flight
+                    }
+                    conn_restart(t, c, 1);
+                    return;
+                }
+                c->woff += n;
+            }
+            c->state = C_READ;
+            c->hlen = 0;
+            c->head_done = 0;
+            c->line_len = 0;
+        }
+
+        ssize_t n = read(c->fd, buf, READ_SIZE);
+        if (n < 0) {
+            if (errno == EAGAIN) {
+                return;
+            }
+            conn_restart(t, c, 1);
+            return;
+        }
+        if (n == 0) {
+            int complete = c->head_done && c->body == B_UNTIL_CLOSE;
+
+            if (complete) {
+                record(t, c);
+            }
+            conn_restart(t, c, !complete);
+            return;
+        }
+        if (measure_from > 0) {
+            t->st.bytes += n;//throughput counts every byte in the window, even of requests started before it
+        }
+
+        const char *body = buf;
+        size_t body_len = n;
+        if (!c->head_done) {
+            size_t take = sizeof(c->head) - c->hlen < (size_t)n ? sizeof(c->head) - c->hlen : (size_t)n;
+
+            memcpy(c->head + c->hlen, buf, take);
+            c->hlen += take;
+
+            size_t before = c->hlen - take;
+            int head_len = parse_head(c);
+            if (head_len < 0) {
+                conn_restart(t, c, 1);
+                return;
+            }
+            if (head_len == 0) {
+                continue;
+            }
+            body = buf + (head_len - before);
+            body_len = n - (head_len - before);
+        }
+
+        int r = consume_body(c, body, body_len);
+        if (r < 0) {
+            conn_restart(t, c, 1);
+            return;
+        }
+        if (r == 0) {
+            continue;
+        }
+        record(t, c);
+        if (__atomic_load_n(&stop, __ATOMIC_RELAXED)) {
+            return;
+        }
+        if (!c->keep) {
+            conn_restart(t, c, 0);
+            return;
+        }
+        c->state = C_WRITE;
+        c->woff = 0;
+        c->started = now_ns();
+    }
+}
+
+static void *thread_main(void *arg) {
+    struct thread *t = arg;
+    struct epoll_event events[256];
+    char *buf = malloc(READ_SIZE);
+
+    t->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (buf == NULL || t->epfd < 0) {
+        perror("loadgen");
+        exit(1);
+    }
+    for (int i = 0; i < t->nconns; i++) {
+        if (conn_open(t, &t->conns[i]) < 0) {
+            perror("connect");
+            exit(1);
+        }
+    }
+
+    while (!__atomic_load_n(&stop, __ATOMIC_RELAXED)) {
+        int n = epoll_wait(t->epfd, events, 256, 100);
+
+        for (int i = 0; i < n; i++) {
+            drive(t, events[i].data.ptr, buf);
+        }
+    }
+    for (int i = 0; i < t->nconns; i++) {
+        close(t->conns[i].fd);
+    }
+    close(t->epfd);
+    free(buf);
+    return NULL;
+}
+
+// utime + stime of a process in microseconds, -1 if it cannot be read
+static long long process_cpu_us(int pid) {
+    char path[64], stat[1024];
+    unsigned long long utime, stime;
+
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    size_t n = fread(stat, 1, sizeof(stat) - 1, f);
+    fclose(f);
+    stat[n] = '\0';
+
+    char *p = strrchr(stat, ')');//the command name may contain spaces
+    if (p == NULL || sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) != 2) {
+        return -1;
+    }
+    return (long long)(utime + stime) * 1000000 / sysconf(_SC_CLK_TCK);
+}
+
+static int syscall_fds[MAX_TASKS];
+static int nsyscall_fds;
+
+// Start counting the system calls of every thread of pid, and of whatever
+// they fork later. Returns -1 if the tracepoint cannot be used.
+static int syscalls_open(int pid) {
+    static const char *const ids[] = {
+        "/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+        "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+    };
+    struct perf_event_attr attr;
+    char path[64];
+    int id = -1;
+
+    for (size_t i = 0; i < sizeof(ids) / sizeof(ids[0]) && id < 0; i++) {
+        FILE *f = fopen(ids[i], "r");
+        if (f != NULL) {
+            if (fscanf(f, "%d", &id) != 1) {
+                id = -1;
+            }
+            fclose(f);
+        }
+    }
+    snprintf(path, sizeof(path), "/proc/%d/task", pid);
+    DIR *d = id >= 0 ? opendir(path) : NULL;
+    if (d == NULL) {
+        return -1;
+    }
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_TRACEPOINT;
+    attr.size = sizeof(attr);
+    attr.config = id;
+    attr.inherit = 1;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL && nsyscall_fds < MAX_TASKS) {
+        int tid = atoi(e->d_name);
+        if (tid <= 0) {
+            continue;
+        }
+        int fd = (int)syscall(__NR_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+        if (fd >= 0) {
+            syscall_fds[nsyscall_fds++] = fd;
+        }
+    }
+    closedir(d);
+    return nsyscall_fds > 0 ? 0 : -1;
+}
+
+// System calls counted so far, -1 if none are
+static long long syscalls_read(void) {
+    long long total = 0;
+
+    if (nsyscall_fds == 0) {
+        return -1;
+    }
+    for (int i = 0; i < nsyscall_fds; i++) {
+        unsigned long long v;
+
+        if (read(syscall_fds[i], &v, sizeof(v)) == sizeof(v)) {
+            total += v;
+        }
+    }
+    return total;
+}
+
+static long long self_cpu_us(void) {
+    struct rusage ru;
+
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec * 1000000LL + ru.ru_utime.tv_usec + ru.ru_stime.tv_sec * 1000000LL + ru.ru_stime.tv_usec;
+}
+
+static double percentile(const struct stats *st, double q) {
+    unsigned long want = (unsigned long)(q * st->requests), seen = 0;
+
+    for (unsigned i = 0; i <= NBUCKETS; i++) {
+        seen += st->hist[i];
+        if (seen > want) {
+            return i < NBUCKETS ? bucket_value(i) : (double)st->max_ns;
+        }
+    }
+    return st->max_ns;
+}
+
+int main(int argc, char *argv[]) {
+    int nconns = 16, nthreads = 1, server_pid = 0, json = 0;
+    double duration = 10, warmup = 1;
+    long long body_len = -1;
+    const char *method = "GET", *label = "", *extra = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:t:d:w:Cm:b:H:p:n:j")) != -1) {
+        switch (opt) {
+        case 'c': nconns = atoi(optarg); break;
+        case 't': nthreads = atoi(optarg); break;
+        case 'd': duration = atof(optarg); break;
+        case 'w': warmup = atof(optarg); break;
+        case 'C': close_each = 1; break;
+        case 'm': method = optarg; break;
+        case 'b': body_len = atoll(optarg); break;
+        case 'H': extra = optarg; break;
+        case 'p': server_pid = atoi(optarg); break;
+        case 'n': label = optarg; break;
+        case 'j': json = 1; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind != argc - 1 || strncmp(argv[optind], "http://", 7) != 0 || nconns < 1 || nthreads < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (nthreads > nconns) {
+        nthreads = nconns;
+    }
+
+    char host[256], port[16] = "80";
+    const char *hp = argv[optind] + 7;
+    const char *path = strchr(hp, '/');
+    size_t hlen = path ? (size_t)(path - hp) : strlen(hp);
+    if (path == NULL) {
+        path = "/";
+    }
+    if (hlen >= sizeof(host)) {
+        usage(argv[0]);
+        return 1;
+    }
+    memcpy(host, hp, hlen);
+    host[hlen] = '\0';
+    char *colon = strchr(host, ':');
+    if (colon != NULL) {
+        *colon = '\0';
+        snprintf(port, sizeof(port), "%s", colon + 1);
+    }
+
+    struct addrinfo hints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM };
+    int err = getaddrinfo(host, port, &hints, &target);
+    if (err != 0) {
+        fprintf(stderr, "%s: %s\n", host, gai_strerror(err));
+        return 1;
+    }
+
+    head_method = strcmp(method, "HEAD") == 0;
+    size_t cap = 1024 + strlen(path) + (extra ? strlen(extra) : 0) + (body_len > 0 ? body_len : 0);
+    request = malloc(cap);
+    if (request == NULL) {
+        perror("loadgen");
+        return 1;
+    }
+    request_len = snprintf(request, cap, "%s %s HTTP/1.1\r\nHost: %.*s\r\nUser-Agent: loadgen\r\n%s%s%s",
+                           method, path, (int)hlen, hp, close_each ? "Connection: close\r\n" : "",
+                           extra ? extra : "", extra ? "\r\n" : "");
+    if (body_len >= 0) {
+        request_len += snprintf(request + request_len, cap - request_len, "Content-Length: %lld\r\n", body_len);
+    }
+    request_len += snprintf(request + request_len, cap - request_len, "\r\n");
+    if (body_len > 0) {
+        memset(request + request_len, 'x', body_len);
+        request_len += body_len;
+    }
+
+    struct thread *threads = calloc(nthreads, sizeof(*threads));
+    struct conn *conns = calloc(nconns, sizeof(*conns));
+    if (threads == NULL || conns == NULL) {
+        perror("loadgen");
+        return 1;
+    }
+    for (int i = 0, given = 0; i < nthreads; i++) {
+        threads[i].nconns = nconns / nthreads + (i < nconns % nthreads);
+        threads[i].conns = conns + given;
+        given += threads[i].nconns;
+        pthread_create(&threads[i].tid, NULL, thread_main, &threads[i]);
+    }
+
+    struct timespec ts = { (time_t)warmup, (long)((warmup - (time_t)warmup) * 1e9) };
+    nanosleep(&ts, NULL);
+    if (server_pid) {
+        syscalls_open(server_pid);
+    }
+    long long server_before = server_pid ? process_cpu_us(server_pid) : -1;
+    long long calls_before = syscalls_read();
+    long long self_before = self_cpu_us();
+    long long began = now_ns();
+    __atomic_store_n(&measure_from, began, __ATOMIC_RELAXED);
+
+    ts = (struct timespec){ (time_t)duration, (long)((duration - (time_t)duration) * 1e9) };
+    nanosleep(&ts, NULL);
+    __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+    double secs = (now_ns() - began) / 1e9;
+    long long server_after = server_pid ? process_cpu_us(server_pid) : -1;
+    long long calls_after = syscalls_read();
+    long long self_after = self_cpu_us();
+
+    static struct stats all;
+    for (int i = 0; i < nthreads; i++) {
+        const struct stats *st = &threads[i].st;
+
+        pthread_join(threads[i].tid, NULL);
+        for (unsigned b = 0; b <= NBUCKETS; b++) {
+            all.hist[b] += st->hist[b];
+        }
+        all.requests += st->requests;
+        all.errors += st->errors;
+        all.bytes += st->bytes;
+        for (int k = 0; k < 6; k++) {
+            all.classes[k] += st->classes[k];
+        }
+        if (st->max_ns > all.max_ns) {
+            all.max_ns = st->max_ns;
+        }
+    }
+
+    double rps = all.requests / secs;
+    double per_req = all.requests ? 1.0 / all.requests : 0;
+    double server_cpu = server_before >= 0 && server_after >= 0 ? (server_after - server_before) * per_req : -1;
+    double client_cpu = (self_after - self_before) * per_req;
+    double server_calls = calls_before >= 0 ? (calls_after - calls_before) * per_req : -1;
+    unsigned long non2xx = all.requests - all.classes[2];
+
+    if (json) {
+        printf("{\"label\":\"%s\",\"requests\":%lu,\"seconds\":%.3f,\"rps\":%.1f,\"mbps\":%.2f,"
+               "\"p50_us\":%.1f,\"p99_us\":%.1f,\"p999_us\":%.1f,\"max_us\":%.1f,"
+               "\"non2xx\":%lu,\"errors\":%lu,\"server_cpu_us\":%.2f,\"client_cpu_us\":%.2f,"
+               "\"server_syscalls\":%.2f}\n",
+               label, all.requests, secs, rps, all.bytes / secs / 1e6,
+               percentile(&all, 0.5) / 1e3, percentile(&all, 0.99) / 1e3, percentile(&all, 0.999) / 1e3,
+               all.max_ns / 1e3, non2xx, all.errors, server_cpu, client_cpu, server_calls);
+        return 0;
+    }
+    printf("%s%s%lu requests in %.2f s, %.1f req/s, %.2f MB/s\n", label, *label ? ": " : "",
+           all.requests, secs, rps, all.bytes / secs / 1e6);
+    printf("latency  p50 %.1f us  p99 %.1f us  p99.9 %.1f us  max %.1f us\n",
+           percentile(&all, 0.5) / 1e3, percentile(&all, 0.99) / 1e3, percentile(&all, 0.999) / 1e3, all.max_ns / 1e3);
+    printf("status   1xx %lu  2xx %lu  3xx %lu  4xx %lu  5xx %lu  errors %lu\n",
+           all.classes[1], all.classes[2], all.classes[3], all.classes[4], all.classes[5], all.errors);
+    if (server_cpu >= 0) {
+        printf("cpu      server %.2f us/req  loadgen %.2f us/req\n", server_cpu, client_cpu);
+    } else {
+        printf("cpu      loadgen %.2f us/req\n", client_cpu);
+    }
+    if (server_calls >= 0) {
+        printf("syscalls server %.2f per request\n", server_calls);
+    }
+    return 0;
+}
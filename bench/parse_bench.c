@@ -0,0 +1,108 @@
+// Parse throughput for the request parser.
+//
+//   cc -O2 -I.. -o parse_bench parse_bench.c ../parser.c ../scan.c && ./parse_bench [iterations]
+//
+// Each sample is parsed whole and again fed in three pieces, as when a head
+// straddles TCP segments, so the cost of resuming is visible too.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "parser.h"
+#include "scan.h"
+
+static const char *samples[][2] = {
+    { "curl",
+      "GET /index.html HTTP/1.1\r\n"
+      "Host: localhost:8080\r\n"
+      "User-Agent: curl/8.5.0\r\n"
+      "Accept: */*\r\n"
+      "\r\n" },
+    { "browser",
+      "GET /static/app.js HTTP/1.1\r\n"
+      "Host: www.example.com\r\n"
+      "Connection: keep-alive\r\n"
+      "sec-ch-ua: \"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\"\r\n"
+      "sec-ch-ua-mobile: ?0\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36\r\n"
+      "sec-ch-ua-platform: \"Linux\"\r\n"
+      "Accept: */*\r\n"
+      "Sec-Fetch-Site: same-origin\r\n"
+      "Sec-Fetch-Mode: no-cors\r\n"
+      "Sec-Fetch-Dest: script\r\n"
+      "Referer: https://www.example.com/\r\n"
+      "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+      "Accept-Language: en-US,en;q=0.9\r\n"
+      "\r\n" },
+    { "browser+cookies",
+      "GET /account/settings?tab=profile HTTP/1.1\r\n"
+      "Host: www.example.com\r\n"
+      "Connection: keep-alive\r\n"
+      "Cache-Control: max-age=0\r\n"
+      "sec-ch-ua: \"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\"\r\n"
+      "sec-ch-ua-mobile: ?0\r\n"
+      "sec-ch-ua-platform: \"Linux\"\r\n"
+      "Upgrade-Insecure-Requests: 1\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0.0.0 Safari/537.36\r\n"
+      "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7\r\n"
+      "Sec-Fetch-Site: same-origin\r\n"
+      "Sec-Fetch-Mode: navigate\r\n"
+      "Sec-Fetch-User: ?1\r\n"
+      "Sec-Fetch-Dest: document\r\n"
+      "Referer: https://www.example.com/account\r\n"
+      "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+      "Accept-Language: en-US,en;q=0.9,de;q=0.8\r\n"
+      "If-None-Match: \"ce801b-243-18df311d3bb538d3\"\r\n"
+      "If-Modified-Since: Sat, 17 Oct 2026 02:46:18 GMT\r\n"
+      "Cookie: _ga=GA1.1.1234567890.1700000000; session=9f8e7d6c5b4a39281706f5e4d3c2b1a09f8e7d6c5b4a3928; "
+      "prefs=%7B%22theme%22%3A%22dark%22%2C%22lang%22%3A%22en%22%7D; _gid=GA1.2.987654321.1700000000; "
+      "csrftoken=Zx9Yw8Vu7Ts6Rq5Po4Nm3Lk2Ji1Hg0FeDcBa; consent=analytics%2Cads%2Cfunctional\r\n"
+      "\r\n" },
+};
+
+static const struct http_limits limits = { 16383, 8192, MAX_HEADERS };
+
+static double now_sec(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void run(const char *name, const char *req, long iterations, int pieces) {
+    size_t len = strlen(req);
+    struct http_request r;
+    long done = 0;
+    double start = now_sec();
+
+    for (long i = 0; i < iterations; i++) {
+        enum parse_result res = PARSE_INCOMPLETE;
+
+        http_parser_init(&r);
+        for (int p = 1; p <= pieces && res == PARSE_INCOMPLETE; p++) {
+            res = http_parse(&r, req, len * p / pieces, &limits);
+        }
+        done += res == PARSE_DONE;
+    }
+
+    double secs = now_sec() - start;
+    if (done != iterations) {
+        fprintf(stderr, "%s: parse failed\n", name);
+        exit(1);
+    }
+    printf("%-16s %5zu B  %d piece%s  %8.1f MB/s  %6.1f ns/request  %d headers\n",
+           name, len, pieces, pieces == 1 ? " " : "s",
+           len * (double)iterations / secs / 1e6, secs * 1e9 / iterations, r.nheaders);
+}
+
+int main(int argc, char *argv[]) {
+    long iterations = argc > 1 ? atol(argv[1]) : 2000000;
+
+    scan_init();
+    printf("scanners: %s\n", scan_impl());
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        run(samples[i][0], samples[i][1], iterations, 1);
+        run(samples[i][0], samples[i][1], iterations, 3);
+    }
+    return 0;
+}
@@ -0,0 +1,203 @@
+// Fuzz harness for the request parser.
+//
+//   clang -g -O1 -fsanitize=fuzzer,address,undefined -DLIBFUZZER -I.. -o parse_fuzz parse_fuzz.c ../parser.c ../scan.c
+//   ./parse_fuzz corpus/
+//
+// Without -DLIBFUZZER it builds a driver that runs each file named on the
+// command line, or stdin, through the same checks, for AFL (afl-clang-fast,
+// then afl-fuzz ... -- ./parse_fuzz @@) or to replay a crash:
+//
+//   cc -g -O1 -fsanitize=address,undefined -I.. -o parse_fuzz parse_fuzz.c ../parser.c ../scan.c
+//   ./parse_fuzz crash-file
+//
+// Every input is parsed whole, then fed again cut at pseudo-random points
+// (derived from the input, so a run is reproducible) the way a head arrives
+// over several reads. Both must give the same result, every span must lie
+// inside the head, and the limits must hold. That is repeated with the
+// server's default limits and with tight ones the fuzzer can reach, and with
+// each scanner implementation the CPU supports against the scalar one.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "parser.h"
+#include "scan.h"
+
+#define SPLIT_ROUNDS 4
+
+static const struct http_limits limit_sets[] = {
+    { 16383, 8192, MAX_HEADERS },   // config defaults
+    { 256, 32, 4 },                 // small enough for mutations to cross
+};
+
+static const char *scanners[] = { "scalar", "sse4.2", "avx2" };
+
+static void fail(const char *what, const struct http_limits *lim, const char *impl) {
+    fprintf(stderr, "parse_fuzz: %s (limits %zu/%zu/%d, %s scanners)\n",
+            what, lim->max_head, lim->max_uri, lim->max_headers, impl);
+    abort();
+}
+
+static void check_span(const struct http_span *s, size_t head_len, const struct http_limits *lim, const char *impl) {
+    if ((size_t)s->off + s->len > head_len) {
+        fail("span outside the head", lim, impl);
+    }
+}
+
+// A finished parse must stay inside the buffer and the limits
+static void check_result(const struct http_request *r, enum parse_result res, size_t len,
+                         const struct http_limits *lim, const char *impl) {
+    if (res != PARSE_DONE) {
+        return;
+    }
+    if (r->head_len > len || r->head_len > lim->max_head) {
+        fail("head_len past the buffer or max_head", lim, impl);
+    }
+    if (r->nheaders < 0 || r->nheaders > lim->max_headers) {
+        fail("more headers than max_headers", lim, impl);
+    }
+    if (r->target.len > lim->max_uri) {
+        fail("target longer than max_uri", lim, impl);
+    }
+    if (r->version_minor < 0 || r->version_minor > 9) {
+        fail("version out of range", lim, impl);
+    }
+    check_span(&r->method_name, r->head_len, lim, impl);
+    check_span(&r->target, r->head_len, lim, impl);
+    for (int i = 0; i < r->nheaders; i++) {
+        check_span(&r->headers[i].name, r->head_len, lim, impl);
+        check_span(&r->headers[i].value, r->head_len, lim, impl);
+    }
+}
+
+// Parse results, ignoring the resume state that differs by how the bytes came
+static int same_result(const struct http_request *a, const struct http_request *b) {
+    if (a->method != b->method || a->version_minor != b->version_minor || a->nheaders != b->nheaders ||
+        a->head_len != b->head_len || a->content_length != b->content_length || a->chunked != b->chunked ||
+        a->conn_close != b->conn_close || a->conn_keep_alive != b->conn_keep_alive ||
+        memcmp(&a->method_name, &b->method_name, sizeof(a->method_name)) != 0 ||
+        memcmp(&a->target, &b->target, sizeof(a->target)) != 0) {
+        return 0;
+    }
+    return memcmp(a->headers, b->headers, a->nheaders * sizeof(a->headers[0])) == 0;
+}
+
+static uint64_t next_rand(uint64_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+// Feed buf[0..len) in growing prefixes, as a connection does after each read
+static enum parse_result parse_split(struct http_request *r, const char *buf, size_t len,
+                                     const struct http_limits *lim, uint64_t *seed) {
+    enum parse_result res = PARSE_INCOMPLETE;
+    size_t have = 0;
+
+    http_parser_init(r);
+    while (res == PARSE_INCOMPLETE && have < len) {
+        uint64_t x = next_rand(seed);
+        size_t step = x & 1 ? 1 + (x >> 8) % 8 : 1 + (x >> 8) % (len - have);//short reads as well as long ones
+        have = have + step < len ? have + step : len;
+        res = http_parse(r, buf, have, lim);
+    }
+    return res;
+}
+
+static void fuzz_one(const char *buf, size_t len, const struct http_limits *lim, const char *impl,
+                     enum parse_result *scalar_res, struct http_request *scalar) {
+    struct http_request whole, split;
+    uint64_t seed = 0xcbf29ce484222325ULL;
+
+    http_parser_init(&whole);
+    enum parse_result res = http_parse(&whole, buf, len, lim);
+    check_result(&whole, res, len, lim, impl);
+    if (scalar_res != NULL && *scalar_res == (enum parse_result)-1) {
+        *scalar_res = res;
+        *scalar = whole;
+    } else if (scalar_res != NULL && (res != *scalar_res || (res == PARSE_DONE && !same_result(&whole, scalar)))) {
+        fail("scanner implementations disagree", lim, impl);
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        seed = (seed ^ (unsigned char)buf[i]) * 0x100000001b3ULL;
+    }
+    seed |= 1;
+    for (int round = 0; round < SPLIT_ROUNDS && len > 1; round++) {
+        enum parse_result sres = parse_split(&split, buf, len, lim, &seed);
+        check_result(&split, sres, len, lim, impl);
+        if (sres != res || (res == PARSE_DONE && !same_result(&whole, &split))) {
+            fprintf(stderr, "whole %d, split %d\n", res, sres);
+            fail("split feed differs from whole", lim, impl);
+        }
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    char *buf = malloc(size > 0 ? size : 1);//exactly sized, so a sanitizer sees any overread
+
+    if (buf == NULL) {
+        return 0;
+    }
+    memcpy(buf, data, size);
+    for (size_t l = 0; l < sizeof(limit_sets) / sizeof(limit_sets[0]); l++) {
+        enum parse_result scalar_res = (enum parse_result)-1;
+        struct http_request scalar;
+
+        for (size_t s = 0; s < sizeof(scanners) / sizeof(scanners[0]); s++) {
+            if (scan_select(scanners[s]) == 0) {
+                fuzz_one(buf, size, &limit_sets[l], scanners[s], &scalar_res, &scalar);
+            }
+        }
+    }
+    free(buf);
+    return 0;
+}
+
+#ifndef LIBFUZZER
+static int run_file(FILE *f, const char *name) {
+    size_t len = 0, cap = 65536;
+    char *data = malloc(cap);
+    size_t n;
+
+    while (data != NULL && (n = fread(data + len, 1, cap - len, f)) > 0) {
+        len += n;
+        if (len == cap) {
+            char *grown = realloc(data, cap * 2);
+            if (grown == NULL) {
+                break;
+            }
+            data = grown;
+            cap *= 2;
+        }
+    }
+    if (data == NULL || ferror(f)) {
+        fprintf(stderr, "parse_fuzz: reading %s failed\n", name);
+        free(data);
+        return 1;
+    }
+    LLVMFuzzerTestOneInput((const uint8_t *)data, len);
+    free(data);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    int err = 0;
+
+    if (argc < 2) {
+        return run_file(stdin, "stdin");
+    }
+    for (int i = 1; i < argc; i++) {
+        FILE *f = fopen(argv[i], "rb");
+        if (f == NULL) {
+            perror(argv[i]);
+            err = 1;
+            continue;
+        }
+        err |= run_file(f, argv[i]);
+        fclose(f);
+    }
+    return err;
+}
+#endif
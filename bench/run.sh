@@ -0,0 +1,170 @@
+#!/bin/sh
+# Benchmark scenarios for the server, run with loadgen against a fresh build.
+#
+#   bench/run.sh [-r rev] [-d secs] [-c conns] [-w workers] [-o key=value]... [scenario...]
+#   bench/run.sh compare OLD NEW
+#
+# The first form builds the server from a commit (default HEAD; the working
+# tree with -r .), serves a generated docroot on $BENCH_PORT (18080) and runs
+# the named scenarios, or all of them. Each result is one JSON line, printed
+# and appended to bench/results/<rev>.jsonl. Each -o is passed on to the
+# server and named in the result file, e.g. <rev>+mode=uring.jsonl, so two
+# settings of one build can be compared.
+#
+# compare takes two result files or revs already run and lists req/s and p99
+# per scenario. It exits 1 if any scenario lost more than $BENCH_RPS_DROP
+# percent of its throughput (5) or gained more than $BENCH_P99_RISE percent
+# of p99 latency (10), so it can gate a change.
+set -e
+
+here=$(cd "$(dirname "$0")" && pwd)
+root=$(dirname "$here")
+results=$here/results
+port=${BENCH_PORT:-18080}
+
+scenarios="small_keepalive small_close file_1m file_1g not_found head cgi_post"
+
+result_file() {
+    if [ -f "$1" ]; then
+        echo "$1"
+    else
+        echo "$results/$(git -C "$root" rev-parse --short "$1").jsonl"
+    fi
+}
+
+if [ "$1" = compare ]; then
+    [ $# -eq 3 ] || { echo "usage: $0 compare OLD NEW" >&2; exit 1; }
+    old=$(result_file "$2")
+    new=$(result_file "$3")
+    # The last line per scenario wins, so a rerun replaces an earlier one
+    awk -v drop="${BENCH_RPS_DROP:-5}" -v rise="${BENCH_P99_RISE:-10}" '
+        function field(line, key,    m) {
+            if (!match(line, "\"" key "\":[^,}]*")) {
+                return ""
+            }
+            m = substr(line, RSTART + length(key) + 3, RLENGTH - length(key) - 3)
+            gsub(/"/, "", m)
+            return m
+        }
+        FNR == 1 { file++ }
+        {
+            label = field($0, "label")
+            if (file == 1) {
+                old_rps[label] = field($0, "rps"); old_p99[label] = field($0, "p99_us")
+            } else {
+                if (!(label in new_rps)) {
+                    order[n++] = label
+                }
+                new_rps[label] = field($0, "rps"); new_p99[label] = field($0, "p99_us")
+            }
+        }
+        END {
+            printf "%-16s %12s %12s %8s %10s %10s %8s\n", "scenario", "old req/s", "new req/s", "change", "old p99", "new p99", "change"
+            bad = 0
+            for (i = 0; i < n; i++) {
+                l = order[i]
+                if (!(l in old_rps) || old_rps[l] == 0 || old_p99[l] == 0) {
+                    printf "%-16s %12s %12.1f %8s %10s %10.1f\n", l, "-", new_rps[l], "", "-", new_p99[l]
+                    continue
+                }
+                dr = (new_rps[l] - old_rps[l]) * 100 / old_rps[l]
+                dp = (new_p99[l] - old_p99[l]) * 100 / old_p99[l]
+                flag = ""
+                if (dr < -drop || dp > rise) {
+                    flag = "  REGRESSION"
+                    bad = 1
+                }
+                printf "%-16s %12.1f %12.1f %+7.1f%% %10.1f %10.1f %+7.1f%%%s\n", l, old_rps[l], new_rps[l], dr, old_p99[l], new_p99[l], dp, flag
+            }
+            exit bad
+        }' "$old" "$new"
+    exit $?
+fi
+
+rev=HEAD
+secs=10
+conns=64
+workers=0
+extra=
+tag=
+while getopts r:d:c:w:o: opt; do
+    case $opt in
+    r) rev=$OPTARG ;;
+    d) secs=$OPTARG ;;
+    c) conns=$OPTARG ;;
+    w) workers=$OPTARG ;;
+    o) extra="$extra -o $OPTARG"; tag="$tag+$OPTARG" ;;
+    *) exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+[ $# -gt 0 ] && scenarios="$*"
+
+work=$(mktemp -d)
+server=
+cleanup() {
+    [ -n "$server" ] && kill "$server" 2>/dev/null && wait "$server" 2>/dev/null
+    rm -rf "$work"
+}
+trap cleanup EXIT INT TERM
+
+# Sources of the tree under test; standalone programs are left out
+mkdir "$work/src"
+if [ "$rev" = . ]; then
+    name=$(git -C "$root" rev-parse --short HEAD)-dirty
+    cp "$root"/*.c "$root"/*.h "$work/src/"
+else
+    name=$(git -C "$root" rev-parse --short "$rev")
+    git -C "$root" archive "$rev" | tar -x -C "$work/src"
+fi
+name=$name$(echo "$tag" | tr '/ ' '__')
+srcs=$(cd "$work/src" && ls *.c | grep -v -x -e nonane.c -e help.c -e mimegen.c -e mkpack.c)
+(cd "$work/src" && cc -O2 -pthread -o "$work/httpserve" $srcs -lz)
+cc -O2 -pthread -o "$work/loadgen" "$here/loadgen.c"
+
+# Docroot: the server serves www/ below its working directory
+mkdir "$work/www"
+cp "$root/index.html" "$work/www/index.html"
+head -c 1048576 /dev/urandom > "$work/www/1m.bin"
+truncate -s 1G "$work/www/1g.bin"
+cat > "$work/www/post.cgi" <<'EOF'
+#!/bin/sh
+cat > /dev/null
+printf 'Content-Type: text/plain\r\n\r\nok\n'
+EOF
+chmod +x "$work/www/post.cgi"
+
+# Trees before the access log print every request instead
+opts="-o workers=$workers"
+grep -q access_log "$work/src/config.c" 2>/dev/null && opts="$opts -o access_log=off"
+opts="$opts$extra"
+(cd "$work" && exec ./httpserve $opts "$port" > server.log 2>&1) &
+server=$!
+for i in 1 2 3 4 5 6 7 8 9 10; do
+    grep -q "starting server" "$work/server.log" 2>/dev/null && break
+    sleep 0.2
+done
+sleep 0.3
+if ! kill -0 "$server" 2>/dev/null; then
+    cat "$work/server.log" >&2
+    server=
+    exit 1
+fi
+
+mkdir -p "$results"
+url=http://127.0.0.1:$port
+for s in $scenarios; do
+    case $s in
+    small_keepalive) args="-c $conns $url/" ;;
+    small_close)     args="-C -c $conns $url/" ;;
+    file_1m)         args="-c 16 $url/1m.bin" ;;
+    file_1g)         args="-c 2 -w 0 $url/1g.bin" ;;
+    not_found)       args="-c $conns $url/missing.html" ;;
+    head)            args="-c $conns -m HEAD $url/" ;;
+    cgi_post)        args="-c 8 -m POST -b 4096 $url/post.cgi" ;;
+    *) echo "unknown scenario $s" >&2; exit 1 ;;
+    esac
+    threads=$(nproc)
+    [ "$threads" -gt 4 ] && threads=4
+    "$work/loadgen" -j -n "$s" -t "$threads" -d "$secs" -p "$server" $args | tee -a "$results/$name.jsonl"
+done
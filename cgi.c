@@ -0,0 +1,845 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <signal.h>
+#include <time.h>
+#include <ctype.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "httpserve.h"
+#include "cgi.h"
+
+#define CGI_MAX_VARS (MAX_HEADERS + 24)
+#define CGI_MAX_HEAD 8192       // script header block, larger gets 500
+#define CGI_READ_SIZE 16384     // script output moved per read
+
+// Where the request body decoder is
+enum body_state {
+    BODY_DATA,      // body_left bytes of data (whole body, or current chunk)
+    BODY_SIZE,      // chunk-size line
+    BODY_DATA_END,  // CRLF after a chunk
+    BODY_TRAILER,   // trailer lines up to the blank one
+    BODY_DONE,
+};
+
+struct cgi_job {
+    struct connection *client; // NULL once only reaping is left
+    struct worker *owner;
+    pid_t pid;
+    int in_fd;              // script's stdin, -1 once the body is written
+    int out_fd;             // script's stdout, -1 after EOF
+    long last_active;       // monotonic ms of the last script output
+    int timed_out;
+    struct timer timer;     // cgi_timeout after last_active, on the owner's wheel
+    int client_flags;       // blocking mode: socket flags to restore, else -1
+
+    enum body_state body;   // request body decoder
+    int chunked;
+    long long body_left;
+    size_t body_off;        // first byte of c->rbuf the decoder has not used
+    int want_client;        // ran out of buffered body, waiting on the client
+    int want_pipe;          // stdin pipe full
+
+    char *obuf;             // output collected until the header block is complete
+    size_t olen;
+    int head_sent;
+    int chunk_out;          // frame the body as chunked
+    int discard;            // no body goes out (HEAD, 204, 304)
+    char *wbuf;             // response bytes not yet sent
+    size_t wlen, woff, wcap;
+
+    struct cgi_job *next;   // in owner->cgi
+};
+
+static struct cgi_job **cgi_table;  // jobs indexed by pipe fd
+static int cgi_table_size;
+
+static long cgi_now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+void cgi_init(void) {
+    struct rlimit rl;
+
+    cgi_table_size = 1024;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY && rl.rlim_cur > 1024) {
+        cgi_table_size = (int)rl.rlim_cur;
+    }
+    cgi_table = calloc(cgi_table_size, sizeof(*cgi_table));
+    if (cgi_table == NULL) {
+        cgi_table_size = 0;
+    }
+}
+
+size_t cgi_script_len(const char *target, const char *suffix) {
+    size_t end = strcspn(target, "?");
+    size_t slen = strlen(suffix);
+    size_t i = 0;
+
+    while (i < end) {
+        size_t seg = i + 1 + strcspn(target + i + 1, "/?");
+
+        if (seg > end) {
+            seg = end;
+        }
+        if (seg - i > slen + 1 && memcmp(target + seg - slen, suffix, slen) == 0) {
+            return seg;
+        }
+        i = seg;
+    }
+    return 0;
+}
+
+int cgi_script_path(const char *target, size_t script_len, char *path, size_t cap) {
+    size_t root = sizeof(DOCUMENT_ROOT);//with its slash
+
+    if (cap <= root || path_normalize(target, script_len, path + root, cap - root) <= 0) {
+        return -1;
+    }
+    memcpy(path, DOCUMENT_ROOT "/", root);
+    return 0;
+}
+
+int cgi_script(const char *target) {
+    return cgi_script_len(target, ".cgi") > 0;
+}
+
+static int add_str(cgi_var_fn add, void *ctx, const char *name, const char *value) {
+    return add(ctx, name, strlen(name), value, strlen(value));
+}
+
+int cgi_variables(const struct connection *c, const char *script_path, size_t script_len,
+                  cgi_var_fn add, void *ctx) {
+    const struct http_request *r = &c->req;
+    const char *target = c->rbuf + r->target.off;
+    size_t path_end = strcspn(target, "?");
+    const struct http_span *host = http_find_header(r, c->rbuf, "host");
+    char buf[64];
+    int err = 0;
+
+    err |= add_str(add, ctx, "GATEWAY_INTERFACE", "CGI/1.1");
+    err |= add_str(add, ctx, "SERVER_SOFTWARE", "httpserve");
+    snprintf(buf, sizeof(buf), "HTTP/1.%d", r->version_minor);
+    err |= add_str(add, ctx, "SERVER_PROTOCOL", buf);
+    if (host != NULL) {
+        const char *h = c->rbuf + host->off;
+        const char *colon = h[0] == '[' ? NULL : memchr(h, ':', host->len);
+
+        err |= add(ctx, "SERVER_NAME", 11, h, colon ? (size_t)(colon - h) : host->len);
+    } else {
+        err |= add_str(add, ctx, "SERVER_NAME", "localhost");
+    }
+    snprintf(buf, sizeof(buf), "%d", cfg->port);
+    err |= add_str(add, ctx, "SERVER_PORT", buf);
+    err |= add(ctx, "REQUEST_METHOD", 14, c->rbuf + r->method_name.off, r->method_name.len);
+    err |= add(ctx, "REQUEST_URI", 11, target, r->target.len);
+    err |= add(ctx, "SCRIPT_NAME", 11, target, script_len);
+    if (path_end > script_len) {
+        err |= add(ctx, "PATH_INFO", 9, target + script_len, path_end - script_len);
+    }
+    err |= add_str(add, ctx, "SCRIPT_FILENAME", script_path);
+    err |= add_str(add, ctx, "QUERY_STRING", target[path_end] == '?' ? target + path_end + 1 : "");
+    if (r->content_length >= 0 && !r->chunked) {
+        snprintf(buf, sizeof(buf), "%lld", r->content_length);
+        err |= add_str(add, ctx, "CONTENT_LENGTH", buf);
+    }
+
+    if (c->peer.sin_family == AF_INET) {
+        inet_ntop(AF_INET, &c->peer.sin_addr, buf, sizeof(buf));
+        err |= add_str(add, ctx, "REMOTE_ADDR", buf);
+        snprintf(buf, sizeof(buf), "%d", ntohs(c->peer.sin_port));
+        err |= add_str(add, ctx, "REMOTE_PORT", buf);
+    }
+
+    for (int i = 0; i < r->nheaders; i++) {
+        const struct http_header *h = &r->headers[i];
+        const char *name = c->rbuf + h->name.off;
+        char var[128];
+        size_t n;
+
+        if (h->name.len == 12 && strncasecmp(name, "content-type", 12) == 0) {
+            err |= add(ctx, "CONTENT_TYPE", 12, c->rbuf + h->value.off, h->value.len);
+            continue;
+        }
+        if ((h->name.len == 14 && strncasecmp(name, "content-length", 14) == 0) ||
+            (h->name.len == 5 && strncasecmp(name, "proxy", 5) == 0) || h->name.len + 5 >= sizeof(var)) {
+            continue;//already passed, or HTTP_PROXY which would redirect the script's outbound calls
+        }
+        memcpy(var, "HTTP_", 5);
+        for (n = 0; n < h->name.len; n++) {
+            var[5 + n] = name[n] == '-' ? '_' : toupper((unsigned char)name[n]);
+        }
+        err |= add(ctx, var, 5 + n, c->rbuf + h->value.off, h->value.len);
+    }
+    return err ? -1 : 0;
+}
+
+int cgi_spawn(const char *path, char *const envp[], int stdin_fd, int stdout_fd, pid_t *pid) {
+    posix_spawn_file_actions_t fa;
+    posix_spawnattr_t attr;
+    sigset_t none, dfl;
+    char *argv[] = { (char *)path, NULL };
+
+    posix_spawn_file_actions_init(&fa);
+    posix_spawn_file_actions_adddup2(&fa, stdin_fd, STDIN_FILENO);
+    if (stdout_fd >= 0) {
+        posix_spawn_file_actions_adddup2(&fa, stdout_fd, STDOUT_FILENO);
+    }
+    posix_spawn_file_actions_addclosefrom_np(&fa, STDERR_FILENO + 1);
+    posix_spawnattr_init(&attr);
+    sigemptyset(&none);
+    sigemptyset(&dfl);
+    sigaddset(&dfl, SIGPIPE);
+    posix_spawnattr_setsigmask(&attr, &none);//workers run with SIGINT/SIGTERM blocked
+    posix_spawnattr_setsigdefault(&attr, &dfl);
+    posix_spawnattr_setpgroup(&attr, 0);//own group, so a kill takes the script's children too
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETPGROUP);
+
+    int r = posix_spawn(pid, path, &fa, &attr, argv, envp);//vfork-style, no page table copy
+    posix_spawn_file_actions_destroy(&fa);
+    posix_spawnattr_destroy(&attr);
+    return r;
+}
+
+int cgi_parse_head(const char *out, size_t len, struct cgi_head *head) {
+    const char *end = out + len;
+    const char *p = out;
+    int have_status = 0, have_location = 0;
+
+    strcpy(head->status, "200 OK");
+    head->headers_len = 0;
+    for (;;) {//header lines up to the blank line
+        const char *nl = memchr(p, '\n', end - p);
+        size_t n;
+
+        if (nl == NULL) {
+            return 0;
+        }
+        n = nl - p;
+        if (n > 0 && p[n - 1] == '\r') {
+            n--;
+        }
+        if (n == 0) {
+            p = nl + 1;
+            break;
+        }
+
+        const char *colon = memchr(p, ':', n);
+        if (p == out && n > 9 && memcmp(p, "HTTP/1.", 7) == 0) {//status line of a script that speaks HTTP itself
+            snprintf(head->status, sizeof(head->status), "%.*s", (int)(n - 9), p + 9);
+            have_status = 1;
+        } else if (colon == NULL || colon == p) {
+            return -1;
+        } else {
+            size_t nlen = colon - p;
+            const char *v = colon + 1;
+
+            while (v < p + n && (*v == ' ' || *v == '\t')) {
+                v++;
+            }
+            size_t vlen = p + n - v;
+            if (nlen == 6 && strncasecmp(p, "status", 6) == 0) {
+                snprintf(head->status, sizeof(head->status), "%.*s", (int)vlen, v);
+                have_status = 1;
+            } else if ((nlen == 14 && strncasecmp(p, "content-length", 14) == 0) ||
+                       (nlen == 10 && strncasecmp(p, "connection", 10) == 0) ||
+                       (nlen == 17 && strncasecmp(p, "transfer-encoding", 17) == 0)) {
+                //framing is ours to decide
+            } else if (head->headers_len + n + 2 < sizeof(head->headers)) {
+                have_location |= nlen == 8 && strncasecmp(p, "location", 8) == 0;
+                memcpy(head->headers + head->headers_len, p, n);
+                memcpy(head->headers + head->headers_len + n, "\r\n", 2);
+                head->headers_len += n + 2;
+            }
+        }
+        p = nl + 1;
+    }
+    if (have_location && !have_status) {
+        strcpy(head->status, "302 Found");
+    }
+    return p - out;
+}
+
+// Environment for execve: "NAME=value" strings packed in one buffer from
+// the worker's scratch arena
+struct cgi_env {
+    struct arena *arena;
+    char *data;
+    size_t len, cap;
+    size_t offs[CGI_MAX_VARS];
+    int n;
+};
+
+static int env_add(void *ctx, const char *name, size_t name_len, const char *value, size_t value_len) {
+    struct cgi_env *env = ctx;
+    size_t need = name_len + 1 + value_len + 1;
+
+    if (env->n == CGI_MAX_VARS) {
+        return 0;//only ever hit with many long header names; drop the rest
+    }
+    if (env->len + need > env->cap) {
+        size_t cap = env->cap ? env->cap * 2 : 4096;
+        while (cap < env->len + need) {
+            cap *= 2;
+        }
+        char *data = arena_grow(env->arena, env->data, env->len, cap);
+        if (data == NULL) {
+            return -1;
+        }
+        env->data = data;
+        env->cap = cap;
+    }
+    env->offs[env->n++] = env->len;
+    memcpy(env->data + env->len, name, name_len);
+    env->data[env->len + name_len] = '=';
+    memcpy(env->data + env->len + name_len + 1, value, value_len);
+    env->data[env->len + need - 1] = '\0';
+    env->len += need;
+    return 0;
+}
+
+static void watch(struct cgi_job *job, int fd, uint32_t events) {
+    struct epoll_event ev = {0};
+
+    cgi_table[fd] = job;
+    if (job->owner->epfd < 0) {
+        return;//blocking mode polls the pipes itself
+    }
+    ev.events = events | EPOLLET;
+    ev.data.fd = fd;
+    epoll_ctl(job->owner->epfd, EPOLL_CTL_ADD, fd, &ev);
+}
+
+static void close_pipe(int *fd) {
+    if (*fd >= 0) {
+        cgi_table[*fd] = NULL;
+        close(*fd);//also drops it from the epoll set
+        *fd = -1;
+    }
+}
+
+// Reap exited scripts whose connections are already finished
+static void reap(struct worker *w) {
+    struct cgi_job **pp = &w->cgi;
+
+    while (*pp != NULL) {
+        struct cgi_job *job = *pp;
+
+        if (job->client == NULL && waitpid(job->pid, NULL, WNOHANG) != 0) {
+            *pp = job->next;
+            slab_free(&w->cgi_slab, job);
+        } else {
+            pp = &job->next;
+        }
+    }
+}
+
+// Let go of the script and its pipes. The job stays on the owner's list
+// until the process has been reaped.
+static void job_release(struct cgi_job *job) {
+    struct connection *c = job->client;
+
+    close_pipe(&job->in_fd);
+    close_pipe(&job->out_fd);
+    buf_put(&job->owner->bufs, job->obuf, CGI_MAX_HEAD);
+    buf_put(&job->owner->bufs, job->wbuf, job->wcap);
+    job->obuf = job->wbuf = NULL;
+    job->wcap = 0;
+    timer_cancel(&job->owner->timers, &job->timer);
+    if (job->client_flags >= 0) {
+        fcntl(c->fd, F_SETFL, job->client_flags);
+    }
+    c->cgi = NULL;
+    job->client = NULL;//reap() frees it once the process is gone
+}
+
+void cgi_abort(struct connection *c) {
+    struct cgi_job *job = c->cgi;
+
+    kill(-job->pid, SIGKILL);
+    job_release(job);
+}
+
+// The response is out (or an error response is queued instead): hand the
+// connection back with the request body consumed
+static void job_finish(struct cgi_job *job) {
+    struct connection *c = job->client;
+
+    if (job->body != BODY_DONE) {
+        c->keep_alive = 0;//rest of the body was never read, so the stream is out of step
+    }
+    c->req_len = job->body_off;
+    if (c->state == CONN_CGI) {
+        c->state = CONN_DONE;
+    }
+    job_release(job);
+}
+
+// Answer with an error instead of the script's response
+static void job_fail(struct cgi_job *job, const char *status) {
+    struct connection *c = job->client;
+
+    kill(-job->pid, SIGKILL);
+    c->keep_alive = 0;
+    send_response(c->fd, status, NULL, NULL, 0);
+    job_finish(job);
+}
+
+static int wbuf_append(struct cgi_job *job, const char *data, size_t len) {
+    if (job->wlen + len > job->wcap) {
+        size_t want = job->wlen + len > CGI_READ_SIZE + 64 ? job->wlen + len : CGI_READ_SIZE + 64;
+        char *buf = buf_grow(&job->owner->bufs, job->wbuf, job->wlen, &job->wcap, want);
+        if (buf == NULL) {
+            return -1;
+        }
+        job->wbuf = buf;
+    }
+    memcpy(job->wbuf + job->wlen, data, len);
+    job->wlen += len;
+    return 0;
+}
+
+static int append_body(struct cgi_job *job, const char *data, size_t len) {
+    char size[24];
+
+    if (job->discard || len == 0) {
+        return 0;
+    }
+    if (!job->chunk_out) {
+        return wbuf_append(job, data, len);
+    }
+    int n = snprintf(size, sizeof(size), "%zx\r\n", len);
+    if (wbuf_append(job, size, n) < 0 || wbuf_append(job, data, len) < 0) {
+        return -1;
+    }
+    return wbuf_append(job, "\r\n", 2);
+}
+
+// The script's header block is complete: queue the HTTP head and whatever
+// body bytes came with it
+static int start_response(struct cgi_job *job, const struct cgi_head *h, size_t head_len) {
+    struct connection *c = job->client;
+    char line[128];
+    int code = atoi(h->status);
+    int no_body = (code >= 100 && code < 200) || code == 204 || code == 304;
+
+    c->log.status = code;
+
+    job->discard = no_body || c->req.method == HTTP_HEAD;
+    job->chunk_out = !no_body && c->req.version_minor >= 1;
+    if (!no_body && !job->chunk_out) {
+        c->keep_alive = 0;//HTTP/1.0: the body ends when we close
+    }
+
+    int n = snprintf(line, sizeof(line), "HTTP/1.1 %s\r\n", h->status);
+    if (wbuf_append(job, line, n) < 0 || wbuf_append(job, h->headers, h->headers_len) < 0) {
+        return -1;
+    }
+    n = snprintf(line, sizeof(line), "%sConnection: %s\r\n\r\n",
+                 job->chunk_out ? "Transfer-Encoding: chunked\r\n" : "", c->keep_alive ? "keep-alive" : "close");
+    if (wbuf_append(job, line, n) < 0) {
+        return -1;
+    }
+    job->head_sent = 1;
+    if (!job->discard) {//pump_output batches the writes itself, so Nagle only delays the last one
+        int one = 1;
+        setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return append_body(job, job->obuf + head_len, job->olen - head_len);
+}
+
+// Move request body bytes from the client to the script's stdin.
+// Returns -1 if the client went away or sent a malformed chunked body.
+static int pump_body(struct cgi_job *job) {
+    struct connection *c = job->client;
+
+    job->want_client = job->want_pipe = 0;
+    while (job->body != BODY_DONE) {
+        while (job->body_off < c->rlen && job->body != BODY_DONE) {
+            if (job->body == BODY_DATA) {
+                size_t n = c->rlen - job->body_off;
+
+                if ((long long)n > job->body_left) {
+                    n = job->body_left;
+                }
+                if (job->in_fd >= 0) {
+                    ssize_t w = write(job->in_fd, c->rbuf + job->body_off, n);
+                    if (w < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        if (errno == EAGAIN) {
+                            job->want_pipe = 1;
+                            return 0;
+                        }
+                        close_pipe(&job->in_fd);//script stopped reading, drop the rest of the body
+                        c->keep_alive = 0;
+                        job->body = BODY_DONE;
+                        return 0;
+                    }
+                    n = w;
+                    job->last_active = cgi_now();//a long upload is not a hung script
+                }
+                job->body_off += n;
+                job->body_left -= n;
+                if (job->body_left == 0) {
+                    job->body = job->chunked ? BODY_DATA_END : BODY_DONE;
+                }
+                continue;
+            }
+
+            char *line = c->rbuf + job->body_off;
+            char *nl = memchr(line, '\n', c->rlen - job->body_off);
+            if (nl == NULL) {
+                break;
+            }
+            size_t len = nl - line;
+            if (len > 0 && line[len - 1] == '\r') {
+                len--;
+            }
+            if (job->body == BODY_SIZE) {
+                long long size = 0;
+                size_t digits = 0;
+
+                for (; digits < len; digits++) {//hex digits only: no sign, space or 0x that strtoull would take
+                    char ch = line[digits];
+                    int v = ch >= '0' && ch <= '9' ? ch - '0' :
+                            (ch | 0x20) >= 'a' && (ch | 0x20) <= 'f' ? (ch | 0x20) - 'a' + 10 : -1;
+
+                    if (v < 0) {
+                        break;
+                    }
+                    size = size << 4 | v;
+                    if (digits == 15) {
+                        return -1;//over 15 digits
+                    }
+                }
+                if (digits == 0 || (digits < len && !strchr("; \t", line[digits]))) {
+                    return -1;
+                }
+                job->body_left = size;
+                job->body = size > 0 ? BODY_DATA : BODY_TRAILER;
+            } else if (job->body == BODY_DATA_END) {
+                if (len != 0) {
+                    return -1;
+                }
+                job->body = BODY_SIZE;
+            } else if (len == 0) {
+                job->body = BODY_DONE;//end of trailers
+            }
+            job->body_off = nl + 1 - c->rbuf;
+        }
+        if (job->body == BODY_DONE) {
+            break;
+        }
+
+        if (job->body_off > 0) {//make room: the head and used body bytes are no longer needed
+            memmove(c->rbuf, c->rbuf + job->body_off, c->rlen - job->body_off);
+            c->rlen -= job->body_off;
+            c->rbuf[c->rlen] = '\0';
+            job->body_off = 0;
+        }
+        if (c->rlen == BUFFER_SIZE - 1) {
+            return -1;//chunk-size or trailer line longer than the whole buffer
+        }
+
+        ssize_t n = conn_recv(c, c->rbuf + c->rlen, BUFFER_SIZE - 1 - c->rlen);
+        if (n > 0) {
+            c->rlen += n;
+            c->rbuf[c->rlen] = '\0';
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            job->want_client = 1;
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+    close_pipe(&job->in_fd);//EOF tells the script the body is complete
+    return 0;
+}
+
+// Release the cork set while full batches stream, pushing out the partial
+// segment it held
+static void uncork(struct connection *c) {
+    if (c->corked) {
+        int zero = 0;
+        setsockopt(c->fd, IPPROTO_TCP, TCP_CORK, &zero, sizeof(zero));
+        c->corked = 0;
+    }
+}
+
+// Move script output to the client. Output is collected until the pipe runs
+// dry, the script exits or a batch is full, so the head, the first chunk and
+// on a short response the 0-size last chunk leave in a single write. Full
+// batches go out corked, and the cork comes off as soon as the script goes
+// quiet or is done. Reads only once the last batch is out. Returns 1 when
+// the response is complete, 0 to wait and -1 on a client error.
+static int pump_output(struct cgi_job *job) {
+    struct connection *c = job->client;
+    char buf[CGI_READ_SIZE];
+    int collecting = 0;     // batch still has room, read before writing
+    int more = 0;           // batch is full and the script may have more right now
+
+    for (;;) {
+        if (more && !c->corked) {
+            int one = 1;
+            c->corked = setsockopt(c->fd, IPPROTO_TCP, TCP_CORK, &one, sizeof(one)) == 0;
+        }
+        while (!collecting && job->woff < job->wlen) {
+            ssize_t n = conn_send(c, job->wbuf + job->woff, job->wlen - job->woff);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+            }
+            job->woff += n;
+            conn_sent(c, n);
+        }
+        if (!collecting) {
+            job->woff = job->wlen = 0;
+            if (job->out_fd < 0) {
+                uncork(c);
+                return 1;
+            }
+        }
+
+        ssize_t n = read(job->out_fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && errno == EAGAIN) {
+            if (job->wlen > 0) {//script is quiet for now; push out what it wrote
+                collecting = more = 0;
+                continue;
+            }
+            uncork(c);
+            return 0;
+        }
+        if (n <= 0) {//script is done
+            close_pipe(&job->out_fd);
+            if (!job->head_sent) {
+                job_fail(job, "HTTP/1.1 500 Internal Server Error");//exited without a complete header block
+                return 1;
+            }
+            if (job->chunk_out && !job->discard && wbuf_append(job, "0\r\n\r\n", 5) < 0) {
+                return -1;
+            }
+            collecting = more = 0;
+            continue;
+        }
+        job->last_active = cgi_now();
+        collecting = job->wlen + n < CGI_READ_SIZE;
+        more = !collecting;
+
+        if (job->head_sent) {
+            if (append_body(job, buf, n) < 0) {
+                return -1;
+            }
+            continue;
+        }
+
+        struct cgi_head head;
+        size_t take = (size_t)n < CGI_MAX_HEAD - job->olen ? (size_t)n : CGI_MAX_HEAD - job->olen;
+        memcpy(job->obuf + job->olen, buf, take);
+        job->olen += take;
+
+        int r = cgi_parse_head(job->obuf, job->olen, &head);
+        if (r < 0 || (r == 0 && job->olen == CGI_MAX_HEAD)) {
+            job_fail(job, "HTTP/1.1 500 Internal Server Error");
+            return 1;
+        }
+        if (r > 0 && (start_response(job, &head, r) < 0 || append_body(job, buf + take, n - take) < 0)) {
+            return -1;
+        }
+    }
+}
+
+static int job_step(struct cgi_job *job) {
+    if (job->timed_out) {
+        if (job->head_sent) {
+            return -1;//too late for a status, cut the response short
+        }
+        job_fail(job, "HTTP/1.1 504 Gateway Timeout");
+        return 1;
+    }
+    if (pump_body(job) < 0) {
+        if (!job->head_sent) {
+            job_fail(job, "HTTP/1.1 400 Bad Request");
+            return 1;
+        }
+        return -1;
+    }
+
+    int r = pump_output(job);
+    if (r > 0 && job->client != NULL) {
+        job_finish(job);
+    }
+    return r;
+}
+
+int cgi_drive(struct connection *c) {
+    struct cgi_job *job = c->cgi;
+
+    if (cfg->mode != SERVE_BLOCKING) {
+        return job_step(job);
+    }
+
+    for (;;) {//blocking mode: this thread stays with the script until it is done
+        int r = job_step(job);
+        if (r != 0) {
+            return r;
+        }
+
+        struct pollfd pfd[3] = {
+            { c->fd, (job->want_client ? POLLIN : 0) | (job->woff < job->wlen ? POLLOUT : 0), 0 },
+            { job->want_pipe ? job->in_fd : -1, POLLOUT, 0 },
+            { job->woff < job->wlen ? -1 : job->out_fd, POLLIN, 0 },
+        };
+        poll(pfd, 3, 1000);
+        if (cgi_now() - job->last_active > cfg->cgi_timeout * 1000L) {
+            job->timed_out = 1;
+        }
+    }
+}
+
+int cgi_event(struct worker *w, int fd) {
+    struct cgi_job *job = fd >= 0 && fd < cgi_table_size ? cgi_table[fd] : NULL;
+
+    if (job == NULL || job->owner != w) {
+        return -1;
+    }
+    conn_resume(job->client);//cgi_drive does the work
+    return 0;
+}
+
+// The script may have gone quiet for cgi_timeout. Output since the timer was
+// armed only moves the deadline; otherwise kill it and let the connection
+// answer for it.
+static void job_timeout(struct timer *t) {
+    struct cgi_job *job = (struct cgi_job *)((char *)t - offsetof(struct cgi_job, timer));
+    long due = job->last_active + cfg->cgi_timeout * 1000L;
+
+    if (cgi_now() < due) {
+        timer_arm(&job->owner->timers, t, due);
+        return;
+    }
+    fprintf(stderr, "CGI pid %d silent for %d s, killing it\n", (int)job->pid, cfg->cgi_timeout);
+    kill(-job->pid, SIGKILL);
+    job->timed_out = 1;
+    conn_resume(job->client);
+}
+
+void cgi_start(struct connection *c, const char *target) {
+    char path[1024];
+    size_t script_len = cgi_script_len(target, ".cgi");
+    struct cgi_env env = { .arena = &c->owner->scratch };
+    int in[2] = { -1, -1 }, out[2] = { -1, -1 };
+    struct worker *w = c->owner;
+
+    reap(w);
+    if (cgi_script_path(target, script_len, path, sizeof(path)) < 0) {
+        send_response(c->fd, "HTTP/1.1 400 Bad Request", NULL, NULL, 0);
+        return;
+    }
+    if (!path_executable(path + sizeof(DOCUMENT_ROOT))) {
+        send_response(c->fd, "HTTP/1.1 404 Not Found", NULL, NULL, 0);
+        return;
+    }
+
+    if (w->cgi_slab.size == 0) {
+        slab_init(&w->cgi_slab, sizeof(struct cgi_job), 0);
+    }
+    struct cgi_job *job = slab_alloc(&w->cgi_slab);
+    const char *search = getenv("PATH");
+    size_t cap;
+    if (job != NULL) {
+        memset(job, 0, sizeof(*job));
+        job->owner = w;
+    }
+    if (job == NULL || (job->obuf = buf_get(&w->bufs, CGI_MAX_HEAD, &cap)) == NULL ||
+        cgi_variables(c, path, script_len, env_add, &env) < 0 ||
+        env_add(&env, "PATH", 4, search ? search : "/usr/bin:/bin", strlen(search ? search : "/usr/bin:/bin")) < 0 ||
+        pipe2(in, O_CLOEXEC) < 0 || pipe2(out, O_CLOEXEC) < 0 ||
+        in[1] >= cgi_table_size || out[0] >= cgi_table_size) {
+        goto fail;
+    }
+
+    char *envp[CGI_MAX_VARS + 1];
+    for (int i = 0; i < env.n; i++) {
+        envp[i] = env.data + env.offs[i];
+    }
+    envp[env.n] = NULL;
+
+    int r = cgi_spawn(path, envp, in[0], out[1], &job->pid);
+    if (r != 0) {
+        fprintf(stderr, "CGI spawn %s: %s\n", path, strerror(r));
+        goto fail;
+    }
+    close(in[0]);
+    close(out[1]);
+    fcntl(in[1], F_SETFL, O_NONBLOCK);//only our ends; the script keeps blocking pipes
+    fcntl(out[0], F_SETFL, O_NONBLOCK);
+
+    job->client = c;
+    job->in_fd = in[1];
+    job->out_fd = out[0];
+    job->last_active = cgi_now();
+    job->client_flags = -1;
+    job->body_off = c->req.head_len;
+    job->chunked = c->req.chunked;
+    job->body = job->chunked ? BODY_SIZE : c->req.content_length > 0 ? BODY_DATA : BODY_DONE;
+    job->body_left = c->req.content_length;
+    if (cfg->mode == SERVE_BLOCKING) {
+        job->client_flags = fcntl(c->fd, F_GETFL);
+        fcntl(c->fd, F_SETFL, job->client_flags | O_NONBLOCK);
+    } else {
+        job->timer.fire = job_timeout;
+        timer_arm(&w->timers, &job->timer, job->last_active + cfg->cgi_timeout * 1000L);
+    }
+    job->next = c->owner->cgi;
+    c->owner->cgi = job;
+    c->cgi = job;
+    watch(job, job->in_fd, EPOLLOUT);
+    watch(job, job->out_fd, EPOLLIN | EPOLLRDHUP);
+    c->state = CONN_CGI;
+    return;
+
+fail:
+    for (int i = 0; i < 2; i++) {
+        if (in[i] >= 0) {
+            close(in[i]);
+        }
+        if (out[i] >= 0) {
+            close(out[i]);
+        }
+    }
+    if (job != NULL) {
+        buf_put(&w->bufs, job->obuf, CGI_MAX_HEAD);
+        slab_free(&w->cgi_slab, job);
+    }
+    c->keep_alive = 0;//body, if any, was never read
+    send_response(c->fd, "HTTP/1.1 500 Internal Server Error", NULL, NULL, 0);
+}
+
+void cgi_sweep(struct worker *w) {
+    reap(w);//silent scripts are killed by their timers
+}
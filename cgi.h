@@ -0,0 +1,80 @@
+#ifndef CGI_H
+#define CGI_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+// CGI/1.1 scripts (*.cgi), run one process per request. The child's stdin
+// and stdout are non-blocking pipes driven by the worker's event loop: the
+// request body (Content-Length or chunked) is streamed into the script and
+// its output is streamed back as a chunked response, each side only reading
+// as fast as the other side drains. The meta-variable and response header
+// helpers are shared with the FastCGI client.
+
+struct connection;
+struct worker;
+
+// Per-request state, see cgi.c
+struct cgi_job;
+
+// Called with each meta-variable; returns -1 to stop
+typedef int (*cgi_var_fn)(void *ctx, const char *name, size_t name_len, const char *value, size_t value_len);
+
+// Response headers a script sent, ready to be forwarded
+struct cgi_head {
+    char status[64];        // "200 OK", from Status:, an NPH status line or Location
+    char headers[4096];     // remaining header lines, CRLF terminated
+    size_t headers_len;
+};
+
+// Set up the pipe lookup table; call once before any worker runs
+void cgi_init(void);
+
+// Length of the script part of a request target: through the first path
+// segment ending in suffix. Whatever follows up to '?' is PATH_INFO.
+// 0 if no segment ends in suffix.
+size_t cgi_script_len(const char *target, const char *suffix);
+
+// The file a script target runs, DOCUMENT_ROOT/ plus the normalized first
+// script_len bytes of target. -1 if the target cannot be normalized.
+int cgi_script_path(const char *target, size_t script_len, char *path, size_t cap);
+
+// Is the request target a CGI script?
+int cgi_script(const char *target);
+
+// Pass the CGI/1.1 meta-variables of the request on c to add. script_len is
+// the length of the script part of the target, script_path the file run.
+int cgi_variables(const struct connection *c, const char *script_path, size_t script_len,
+                  cgi_var_fn add, void *ctx);
+
+// Start path in a new process group with stdin (and stdout unless stdout_fd
+// is -1) redirected, all other descriptors above stderr closed and signals
+// back to their defaults. Returns 0 or an errno value.
+int cgi_spawn(const char *path, char *const envp[], int stdin_fd, int stdout_fd, pid_t *pid);
+
+// Parse the header block at the start of a script's output. Returns its
+// length through the blank line, 0 if it is not complete yet and -1 if it is
+// malformed. Framing headers (Content-Length, Connection, Transfer-Encoding)
+// are dropped; the server frames the response itself.
+int cgi_parse_head(const char *out, size_t len, struct cgi_head *head);
+
+// Run the script for the request on c. The connection moves to CONN_CGI
+// until the response is fully sent, or has an error response queued.
+void cgi_start(struct connection *c, const char *target);
+
+// Move request body and script output along; for conn_process.
+// Returns 0 while waiting for readiness, 1 once c has left CONN_CGI and -1
+// if the client connection has to be closed.
+int cgi_drive(struct connection *c);
+
+// Readiness on one of the worker's CGI pipes; -1 if fd is not one
+int cgi_event(struct worker *w, int fd);
+
+// Kill the script of a connection that is going away
+void cgi_abort(struct connection *c);
+
+// Reap scripts that have exited; call about once a second. Scripts silent
+// for longer than cgi_timeout are killed by a timer of their own.
+void cgi_sweep(struct worker *w);
+
+#endif // CGI_H
@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#ifdef HAVE_BROTLI
+#include <brotli/encode.h>
+#define BROTLI_ENABLED 1
+#else
+#define BROTLI_ENABLED 0
+#endif
+#include "compress.h"
+
+static const char *names[CODING_COUNT] = { NULL, "br", "gzip" };
+static const char *suffixes[CODING_COUNT] = { "", ".br", ".gz" };
+
+const char *coding_name(enum content_coding coding) {
+    return names[coding];
+}
+
+const char *coding_suffix(enum content_coding coding) {
+    return suffixes[coding];
+}
+
+int coding_available(enum content_coding coding) {
+    return coding != CODING_BR || BROTLI_ENABLED;
+}
+
+int compressible_type(const char *mime_type) {
+    size_t len = strlen(mime_type);
+
+    return strncmp(mime_type, "text/", 5) == 0 ||
+           strcmp(mime_type, "application/javascript") == 0 ||
+           strcmp(mime_type, "application/json") == 0 ||
+           strcmp(mime_type, "application/xml") == 0 ||
+           strcmp(mime_type, "application/wasm") == 0 ||
+           (len > 5 && (strcmp(mime_type + len - 5, "+json") == 0 || strcmp(mime_type + len - 4, "+xml") == 0));//svg+xml, manifest+json
+}
+
+static int gzip_buffer(int level, const char *in, size_t len, char *out, size_t *out_len) {
+    z_stream zs;
+
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, level < 1 ? 1 : level > 9 ? 9 : level, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {//windowBits + 16 asks for a gzip wrapper
+        return -1;
+    }
+    zs.next_in = (unsigned char *)in;
+    zs.avail_in = len;
+    zs.next_out = (unsigned char *)out;
+    zs.avail_out = *out_len;
+
+    int r = deflate(&zs, Z_FINISH);
+    *out_len = zs.total_out;
+    deflateEnd(&zs);
+    return r == Z_STREAM_END ? 0 : -1;//Z_OK means it ran out of room, no gain
+}
+
+int compress_buffer(enum content_coding coding, int level, const char *in, size_t len,
+                    char **out, size_t *out_len) {
+    size_t cap = len > 64 ? len - 1 : 64;//anything bigger than the input is useless
+    char *buf = malloc(cap);
+    int r = -1;
+
+    if (buf == NULL) {
+        return -1;
+    }
+    *out_len = cap;
+    if (coding == CODING_GZIP) {
+        r = gzip_buffer(level, in, len, buf, out_len);
+    }
+#ifdef HAVE_BROTLI
+    else if (coding == CODING_BR) {
+        int quality = level < 0 ? 0 : level > 11 ? 11 : level;
+
+        r = BrotliEncoderCompress(quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT, len,
+                                  (const uint8_t *)in, out_len, (uint8_t *)buf) ? 0 : -1;
+    }
+#endif
+    if (r < 0 || *out_len >= len) {
+        free(buf);
+        return -1;
+    }
+    *out = buf;
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include <stddef.h>
+
+// gzip comes from zlib (-lz). brotli is optional: build with -DHAVE_BROTLI
+// and -lbrotlienc, otherwise only precompressed .br sidecars are sent.
+
+// Content codings the server can send, in order of preference
+enum content_coding {
+    CODING_IDENTITY,
+    CODING_BR,
+    CODING_GZIP,
+    CODING_COUNT,
+};
+
+// Name used in Accept-Encoding and Content-Encoding, NULL for identity
+const char *coding_name(enum content_coding coding);
+
+// File name suffix of a precompressed sidecar (".br", ".gz")
+const char *coding_suffix(enum content_coding coding);
+
+// Can this server encode on the fly in coding? (br needs HAVE_BROTLI)
+int coding_available(enum content_coding coding);
+
+// Is a type worth compressing? Already compressed images are not.
+int compressible_type(const char *mime_type);
+
+// Compress len bytes into a new malloc'd buffer at the given level (gzip 1-9,
+// brotli 0-11, clamped). Returns -1 on failure or when the result would not
+// be smaller than the input.
+int compress_buffer(enum content_coding coding, int level, const char *in, size_t len,
+                    char **out, size_t *out_len);
+
+#endif // COMPRESS_H
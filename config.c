@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <ctype.h>
+#include "httpserve.h"
+
+const struct server_config *cfg;
+
+enum opt_type {
+    OPT_INT,
+    OPT_BOOL,
+    OPT_MODE,
+    OPT_SIZE,
+    OPT_PATH,
+    OPT_FMT,
+};
+
+// Every setting the config file and -o accept
+static const struct {
+    const char *key;
+    enum opt_type type;
+    size_t offset;
+} options[] = {
+    { "port",                   OPT_INT,  offsetof(struct server_config, port) },
+    { "listen_backlog",         OPT_INT,  offsetof(struct server_config, listen_backlog) },
+    { "max_connections",        OPT_INT,  offsetof(struct server_config, max_connections) },
+    { "max_connections_per_ip", OPT_INT,  offsetof(struct server_config, max_connections_per_ip) },
+    { "request_rate_per_ip",    OPT_INT,  offsetof(struct server_config, request_rate_per_ip) },
+    { "request_burst_per_ip",   OPT_INT,  offsetof(struct server_config, request_burst_per_ip) },
+    { "mode",                   OPT_MODE, offsetof(struct server_config, mode) },
+    { "workers",                OPT_INT,  offsetof(struct server_config, workers) },
+    { "pin_workers",            OPT_BOOL, offsetof(struct server_config, pin_workers) },
+    { "uring_sqpoll",           OPT_BOOL, offsetof(struct server_config, uring_sqpoll) },
+    { "keepalive_timeout",      OPT_INT,  offsetof(struct server_config, keepalive_timeout) },
+    { "header_timeout",         OPT_INT,  offsetof(struct server_config, header_timeout) },
+    { "send_timeout",           OPT_INT,  offsetof(struct server_config, send_timeout) },
+    { "drain_timeout",          OPT_INT,  offsetof(struct server_config, drain_timeout) },
+    { "keepalive_requests",     OPT_INT,  offsetof(struct server_config, keepalive_requests) },
+    { "cache_bytes",            OPT_SIZE, offsetof(struct server_config, cache_bytes) },
+    { "cache_max_file",         OPT_SIZE, offsetof(struct server_config, cache_max_file) },
+    { "cache_valid_ms",         OPT_INT,  offsetof(struct server_config, cache_valid_ms) },
+    { "fd_cache_entries",       OPT_INT,  offsetof(struct server_config, fd_cache_entries) },
+    { "max_header_bytes",       OPT_SIZE, offsetof(struct server_config, max_header_bytes) },
+    { "max_uri",                OPT_SIZE, offsetof(struct server_config, max_uri) },
+    { "max_headers",            OPT_INT,  offsetof(struct server_config, max_headers) },
+    { "gzip_level",             OPT_INT,  offsetof(struct server_config, gzip_level) },
+    { "brotli_quality",         OPT_INT,  offsetof(struct server_config, brotli_quality) },
+    { "fcgi_procs",             OPT_INT,  offsetof(struct server_config, fcgi_procs) },
+    { "fcgi_timeout",           OPT_INT,  offsetof(struct server_config, fcgi_timeout) },
+    { "cgi_timeout",            OPT_INT,  offsetof(struct server_config, cgi_timeout) },
+    { "mime_types",             OPT_PATH, offsetof(struct server_config, mime_types) },
+    { "pack",                   OPT_PATH, offsetof(struct server_config, pack) },
+    { "access_log",             OPT_PATH, offsetof(struct server_config, access_log) },
+    { "access_log_format",      OPT_FMT,  offsetof(struct server_config, access_log_format) },
+    { "access_log_ring",        OPT_INT,  offsetof(struct server_config, access_log_ring) },
+};
+
+void config_defaults(struct server_config *c) {
+    memset(c, 0, sizeof(*c));
+    c->port = SERVER_PORT;
+    c->listen_backlog = 511;
+    c->mode = SERVE_EPOLL;
+    c->workers = 1;
+    c->pin_workers = 1;
+    c->keepalive_timeout = 5;
+    c->header_timeout = 10;
+    c->send_timeout = 30;
+    c->keepalive_requests = 100;
+    c->cache_bytes = 64 << 20;
+    c->cache_max_file = 1 << 20;
+    c->cache_valid_ms = 1000;
+    c->fd_cache_entries = 4096;
+    c->max_header_bytes = 8 << 10;
+    c->max_uri = 1024;
+    c->max_headers = MAX_HEADERS;
+    c->gzip_level = 6;
+    c->brotli_quality = 5;
+    c->fcgi_procs = 2;
+    c->fcgi_timeout = 30;
+    c->cgi_timeout = 30;
+    strcpy(c->access_log, "-");
+    c->access_log_format = LOG_COMMON;
+    c->access_log_ring = 4096;
+}
+
+static int parse_int(const char *value, int *out) {
+    char *end;
+    long v = strtol(value, &end, 10);
+
+    if (end == value || *end != '\0' || v < 0 || v > 0x7fffffff) {
+        return -1;
+    }
+    *out = (int)v;
+    return 0;
+}
+
+// Byte counts with an optional k/m/g suffix
+static int parse_size(const char *value, size_t *out) {
+    char *end;
+    unsigned long long v = strtoull(value, &end, 10);
+
+    if (end == value || *value == '-') {
+        return -1;
+    }
+    switch (tolower((unsigned char)*end)) {
+    case 'g':
+        v <<= 10;
+        /* fall through */
+    case 'm':
+        v <<= 10;
+        /* fall through */
+    case 'k':
+        v <<= 10;
+        end++;
+        break;
+    }
+    if (*end != '\0') {
+        return -1;
+    }
+    *out = v;
+    return 0;
+}
+
+static int parse_bool(const char *value, int *out) {
+    if (strcmp(value, "on") == 0 || strcmp(value, "yes") == 0 || strcmp(value, "1") == 0) {
+        *out = 1;
+    } else if (strcmp(value, "off") == 0 || strcmp(value, "no") == 0 || strcmp(value, "0") == 0) {
+        *out = 0;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+int config_set(struct server_config *c, const char *key, const char *value) {
+    for (size_t i = 0; i < sizeof(options) / sizeof(options[0]); i++) {
+        if (strcmp(options[i].key, key) != 0) {
+            continue;
+        }
+
+        void *field = (char *)c + options[i].offset;
+        int ok = -1;
+        switch (options[i].type) {
+        case OPT_INT:
+            ok = parse_int(value, field);
+            break;
+        case OPT_BOOL:
+            ok = parse_bool(value, field);
+            break;
+        case OPT_SIZE:
+            ok = parse_size(value, field);
+            break;
+        case OPT_PATH:
+            if (strlen(value) < CONFIG_PATH_MAX) {
+                strcpy(field, value);
+                ok = 0;
+            }
+            break;
+        case OPT_MODE:
+            if (strcmp(value, "epoll") == 0) {
+                *(enum serve_mode *)field = SERVE_EPOLL;
+                ok = 0;
+            } else if (strcmp(value, "blocking") == 0) {
+                *(enum serve_mode *)field = SERVE_BLOCKING;
+                ok = 0;
+            } else if (strcmp(value, "uring") == 0) {
+                *(enum serve_mode *)field = SERVE_URING;
+                ok = 0;
+            }
+            break;
+        case OPT_FMT:
+            if (strcmp(value, "common") == 0) {
+                *(enum access_log_format *)field = LOG_COMMON;
+                ok = 0;
+            } else if (strcmp(value, "combined") == 0) {
+                *(enum access_log_format *)field = LOG_COMBINED;
+                ok = 0;
+            } else if (strcmp(value, "json") == 0) {
+                *(enum access_log_format *)field = LOG_JSON;
+                ok = 0;
+            }
+            break;
+        }
+        if (ok < 0) {
+            fprintf(stderr, "config: bad value '%s' for %s\n", value, key);
+        }
+        return ok;
+    }
+
+    fprintf(stderr, "config: unknown setting '%s'\n", key);
+    return -1;
+}
+
+int config_load(struct server_config *c, const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[1024];
+    int lineno = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *key = line, *value, *end;
+
+        lineno++;
+        if ((end = strchr(line, '#')) != NULL) {//strip comments
+            *end = '\0';
+        }
+        while (isspace((unsigned char)*key)) {
+            key++;
+        }
+        if (*key == '\0') {
+            continue;
+        }
+
+        value = key;
+        while (*value && !isspace((unsigned char)*value)) {
+            value++;
+        }
+        if (*value) {
+            *value++ = '\0';
+        }
+        while (isspace((unsigned char)*value)) {
+            value++;
+        }
+        end = value + strlen(value);
+        while (end > value && isspace((unsigned char)end[-1])) {
+            *--end = '\0';
+        }
+
+        if (config_set(c, key, value) < 0) {
+            fprintf(stderr, "%s:%d: rejected\n", path, lineno);
+            fclose(f);
+            return -1;
+        }
+    }
+    fclose(f);
+    return 0;
+}
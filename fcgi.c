@@ -0,0 +1,931 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "httpserve.h"
+#include "fcgi.h"
+#include "cgi.h"
+
+extern char **environ;
+
+// Record types and constants from the FastCGI 1.0 specification
+enum {
+    FCGI_BEGIN_REQUEST = 1,
+    FCGI_ABORT_REQUEST,
+    FCGI_END_REQUEST,
+    FCGI_PARAMS,
+    FCGI_STDIN,
+    FCGI_STDOUT,
+    FCGI_STDERR,
+    FCGI_DATA,
+    FCGI_GET_VALUES,
+    FCGI_GET_VALUES_RESULT,
+    FCGI_UNKNOWN_TYPE,
+};
+#define FCGI_VERSION_1 1
+#define FCGI_RESPONDER 1
+#define FCGI_KEEP_CONN 1
+#define FCGI_REQUEST_COMPLETE 0
+#define FCGI_HEADER_LEN 8
+#define FCGI_MAX_CONTENT 65535
+
+#define FCGI_MAX_PROCS 64       // processes per script
+#define FCGI_MAX_MPX 16         // requests in flight on one multiplexed connection
+#define FCGI_MAX_RESPONSE (8 << 20) // larger application output gets 502
+#define FCGI_PROBE_MS 5000      // health check interval per process
+#define FCGI_RESPAWN_MS 1000    // crash-looping scripts restart at most this often
+#define FCGI_RBUF_SIZE (FCGI_HEADER_LEN + FCGI_MAX_CONTENT + 255) // one record with padding
+
+// One process of a pool and the socket it accepts on. The socket belongs to
+// the server, so connections made while the process is down wait in its
+// backlog for the replacement.
+struct fcgi_proc {
+    pid_t pid;              // 0 while down
+    int listen_fd;
+    struct sockaddr_un addr;
+    socklen_t addr_len;
+    long started;           // monotonic ms of the last spawn
+    long probe_due;         // next health check
+    int mpxs;               // it reported FCGI_MPXS_CONNS=1
+    int max_reqs;           // FCGI_MAX_REQS it reported, capped at FCGI_MAX_MPX
+};
+
+// A script and its processes, shared by all workers
+struct fcgi_app {
+    char *path;             // www/... file that is executed
+    int nprocs;
+    struct fcgi_proc procs[FCGI_MAX_PROCS];
+    unsigned long restarts;
+    struct fcgi_app *next;
+};
+
+struct fcgi_request {
+    struct connection *client;
+    struct fcgi_pool *pool;
+    struct fcgi_conn *conn;  // carrying it, NULL while queued
+    size_t script_len;      // of the request target, the rest is PATH_INFO
+    uint16_t id;
+    char *out;              // STDOUT so far: CGI headers, blank line, body
+    size_t out_len, out_cap;
+    int status;             // 0, or the HTTP status to fail with
+    long started;
+    struct fcgi_request *next; // in the pool's queue or done list
+};
+
+// A connection to one process
+struct fcgi_conn {
+    int fd;
+    struct fcgi_pool *pool;
+    int proc;               // index in app->procs
+    int connected;          // connect() has finished
+    int probe;              // carries a health check, not requests
+    int keep;               // multiplexed, stays open between requests
+    long opened;
+    char *wbuf;             // records not yet written
+    size_t wlen, woff, wcap;
+    unsigned char *rbuf;    // partial record
+    size_t rlen;
+    struct fcgi_request *reqs[FCGI_MAX_MPX]; // by request id - 1
+    int nreqs;
+    struct fcgi_conn *next;
+};
+
+// One worker's connections and queue for one app. Only that worker's
+// thread touches it.
+struct fcgi_pool {
+    struct fcgi_app *app;
+    struct worker *owner;
+    struct fcgi_conn *conns;
+    struct fcgi_request *queue, *queue_tail; // waiting for a connection
+    struct fcgi_request *done;  // answered, to be handed back to clients
+    int next_proc;          // round robin start
+    struct slab req_slab;   // struct fcgi_request
+    struct slab conn_slab;  // struct fcgi_conn
+    struct fcgi_pool *next;
+};
+
+static pthread_mutex_t apps_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct fcgi_app *apps;           // guarded by apps_lock
+static struct fcgi_conn **fcgi_table;   // connections indexed by fd
+static int fcgi_table_size;
+
+static long fcgi_now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+void fcgi_init(void) {
+    struct rlimit rl;
+
+    fcgi_table_size = 1024;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY && rl.rlim_cur > 1024) {
+        fcgi_table_size = (int)rl.rlim_cur;
+    }
+    fcgi_table = calloc(fcgi_table_size, sizeof(*fcgi_table));
+    if (fcgi_table == NULL) {
+        fcgi_table_size = 0;
+    }
+}
+
+int fcgi_script(const char *target) {
+    return cgi_script_len(target, ".fcgi") > 0;
+}
+
+// Start (or restart) process i of an app. Caller holds apps_lock.
+static int proc_spawn(struct fcgi_app *app, int i) {
+    struct fcgi_proc *p = &app->procs[i];
+
+    if (p->listen_fd < 0) {
+        p->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (p->listen_fd < 0) {
+            return -1;
+        }
+        memset(&p->addr, 0, sizeof(p->addr));
+        p->addr.sun_family = AF_UNIX;//abstract name, nothing to clean up on disk
+        int n = snprintf(p->addr.sun_path + 1, sizeof(p->addr.sun_path) - 1, "httpserve-fcgi-%d-%p-%d",
+                         (int)getpid(), (void *)app, i);
+        p->addr_len = offsetof(struct sockaddr_un, sun_path) + 1 + n;
+        if (bind(p->listen_fd, (struct sockaddr *)&p->addr, p->addr_len) < 0 || listen(p->listen_fd, 128) < 0) {
+            perror("FastCGI socket");
+            close(p->listen_fd);
+            p->listen_fd = -1;
+            return -1;
+        }
+    }
+
+    int r = cgi_spawn(app->path, environ, p->listen_fd, -1, &p->pid);//fd 0 is FCGI_LISTENSOCK_FILENO
+    p->started = fcgi_now();
+    p->probe_due = p->started + FCGI_PROBE_MS;
+    if (r != 0) {
+        fprintf(stderr, "FastCGI spawn %s: %s\n", app->path, strerror(r));
+        p->pid = 0;
+        return -1;
+    }
+    return 0;
+}
+
+// Reap exited processes and restart them. Caller holds apps_lock.
+static void app_maintain(struct fcgi_app *app, long now) {
+    for (int i = 0; i < app->nprocs; i++) {
+        struct fcgi_proc *p = &app->procs[i];
+        int status;
+
+        if (p->pid > 0 && waitpid(p->pid, &status, WNOHANG) == p->pid) {
+            fprintf(stderr, "FastCGI %s[%d] pid %d exited (status %d)\n", app->path, i, (int)p->pid, status);
+            p->pid = 0;
+            p->mpxs = 0;
+        }
+        if (p->pid == 0 && now - p->started >= FCGI_RESPAWN_MS && proc_spawn(app, i) == 0) {
+            app->restarts++;
+        }
+    }
+}
+
+// Find the app for a script, starting its pool on first use
+static struct fcgi_app *app_get(const char *path) {
+    struct fcgi_app *app;
+
+    pthread_mutex_lock(&apps_lock);
+    for (app = apps; app != NULL; app = app->next) {
+        if (strcmp(app->path, path) == 0) {
+            app_maintain(app, fcgi_now());
+            pthread_mutex_unlock(&apps_lock);
+            return app;
+        }
+    }
+
+    app = calloc(1, sizeof(*app));
+    if (app != NULL && (app->path = strdup(path)) != NULL) {
+        app->nprocs = cfg->fcgi_procs < 1 ? 1 : cfg->fcgi_procs > FCGI_MAX_PROCS ? FCGI_MAX_PROCS : cfg->fcgi_procs;
+        for (int i = 0; i < app->nprocs; i++) {
+            app->procs[i].listen_fd = -1;
+        }
+        if (proc_spawn(app, 0) == 0) {
+            for (int i = 1; i < app->nprocs; i++) {
+                proc_spawn(app, i);
+            }
+            app->next = apps;
+            apps = app;
+            pthread_mutex_unlock(&apps_lock);
+            return app;
+        }
+        if (app->procs[0].listen_fd >= 0) {
+            close(app->procs[0].listen_fd);
+        }
+        free(app->path);
+    }
+    free(app);
+    pthread_mutex_unlock(&apps_lock);
+    return NULL;
+}
+
+static struct fcgi_pool *pool_get(struct worker *w, struct fcgi_app *app) {
+    struct fcgi_pool *pool;
+
+    for (pool = w->fcgi; pool != NULL; pool = pool->next) {
+        if (pool->app == app) {
+            return pool;
+        }
+    }
+    pool = calloc(1, sizeof(*pool));
+    if (pool != NULL) {
+        pool->app = app;
+        pool->owner = w;
+        slab_init(&pool->req_slab, sizeof(struct fcgi_request), 0);
+        slab_init(&pool->conn_slab, sizeof(struct fcgi_conn), 0);
+        pool->next = w->fcgi;
+        w->fcgi = pool;
+    }
+    return pool;
+}
+
+static int wbuf_reserve(struct fcgi_conn *fc, size_t n) {
+    if (fc->woff > 0 && fc->woff == fc->wlen) {
+        fc->woff = fc->wlen = 0;
+    }
+    if (fc->wlen + n > fc->wcap) {
+        char *buf = buf_grow(&fc->pool->owner->bufs, fc->wbuf, fc->wlen, &fc->wcap, fc->wlen + n);
+        if (buf == NULL) {
+            return -1;
+        }
+        fc->wbuf = buf;
+    }
+    return 0;
+}
+
+// Append records of one type carrying data, split at the 64 KB record limit.
+// An empty stream terminator is sent when end is set.
+static int put_stream(struct fcgi_conn *fc, int type, uint16_t id, const char *data, size_t len, int end) {
+    do {
+        size_t n = len > FCGI_MAX_CONTENT ? FCGI_MAX_CONTENT : len;
+        size_t pad = (8 - n % 8) % 8;//keep records 8-byte aligned
+
+        if (n == 0 && !end) {
+            break;
+        }
+        if (wbuf_reserve(fc, FCGI_HEADER_LEN + n + pad) < 0) {
+            return -1;
+        }
+        unsigned char *h = (unsigned char *)fc->wbuf + fc->wlen;
+        h[0] = FCGI_VERSION_1;
+        h[1] = type;
+        h[2] = id >> 8;
+        h[3] = id & 0xff;
+        h[4] = n >> 8;
+        h[5] = n & 0xff;
+        h[6] = pad;
+        h[7] = 0;
+        memcpy(h + FCGI_HEADER_LEN, data, n);
+        memset(h + FCGI_HEADER_LEN + n, 0, pad);
+        fc->wlen += FCGI_HEADER_LEN + n + pad;
+        data += n;
+        len -= n;
+        if (n == 0) {
+            break;//that was the terminator
+        }
+    } while (len > 0 || end);
+    return 0;
+}
+
+// Name-value pairs in FastCGI's length-prefixed encoding, built in the
+// worker's scratch arena
+struct nv_buf {
+    struct arena *arena;
+    char *data;
+    size_t len, cap;
+};
+
+static void nv_put_len(unsigned char *p, size_t *n, size_t len) {
+    if (len < 128) {
+        p[(*n)++] = len;
+    } else {
+        p[(*n)++] = (len >> 24) | 0x80;
+        p[(*n)++] = len >> 16;
+        p[(*n)++] = len >> 8;
+        p[(*n)++] = len;
+    }
+}
+
+static int nv_add(struct nv_buf *b, const char *name, size_t nlen, const char *value, size_t vlen) {
+    if (b->len + 8 + nlen + vlen > b->cap) {
+        size_t cap = b->cap ? b->cap * 2 : 2048;
+        while (cap < b->len + 8 + nlen + vlen) {
+            cap *= 2;
+        }
+        char *data = arena_grow(b->arena, b->data, b->len, cap);
+        if (data == NULL) {
+            return -1;
+        }
+        b->data = data;
+        b->cap = cap;
+    }
+    nv_put_len((unsigned char *)b->data, &b->len, nlen);
+    nv_put_len((unsigned char *)b->data, &b->len, vlen);
+    memcpy(b->data + b->len, name, nlen);
+    memcpy(b->data + b->len + nlen, value, vlen);
+    b->len += nlen + vlen;
+    return 0;
+}
+
+static int params_add(void *ctx, const char *name, size_t name_len, const char *value, size_t value_len) {
+    return nv_add(ctx, name, name_len, value, value_len);
+}
+
+static void conn_watch(struct fcgi_conn *fc) {
+    struct worker *w = fc->pool->owner;
+    struct epoll_event ev = {0};
+
+    if (w->epfd < 0) {
+        return;//blocking mode polls the socket itself
+    }
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    ev.data.fd = fc->fd;
+    epoll_ctl(w->epfd, EPOLL_CTL_ADD, fc->fd, &ev);
+}
+
+static struct fcgi_conn *conn_connect(struct fcgi_pool *pool, int proc) {
+    const struct fcgi_proc *p = &pool->app->procs[proc];
+    struct buf_pool *bufs = &pool->owner->bufs;
+    struct fcgi_conn *fc = NULL;
+    size_t cap;
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fd < fcgi_table_size && (fc = slab_alloc(&pool->conn_slab)) != NULL) {
+        memset(fc, 0, sizeof(*fc));
+        fc->rbuf = buf_get(bufs, FCGI_RBUF_SIZE, &cap);
+    }
+    if (fc == NULL || fc->rbuf == NULL) {
+        slab_free(&pool->conn_slab, fc);
+        close(fd);
+        return NULL;
+    }
+
+    if (connect(fd, (const struct sockaddr *)&p->addr, p->addr_len) == 0) {
+        fc->connected = 1;
+    } else if (errno != EINPROGRESS) {//EAGAIN: backlog full, try again later
+        buf_put(bufs, fc->rbuf, FCGI_RBUF_SIZE);
+        slab_free(&pool->conn_slab, fc);
+        close(fd);
+        return NULL;
+    }
+
+    fc->fd = fd;
+    fc->pool = pool;
+    fc->proc = proc;
+    fc->keep = __atomic_load_n(&p->mpxs, __ATOMIC_RELAXED);
+    fc->opened = fcgi_now();
+    fc->next = pool->conns;
+    pool->conns = fc;
+    fcgi_table[fd] = fc;
+    conn_watch(fc);
+    return fc;
+}
+
+static void conn_free(struct fcgi_conn *fc) {
+    struct fcgi_conn **pp = &fc->pool->conns;
+
+    while (*pp != fc) {
+        pp = &(*pp)->next;
+    }
+    *pp = fc->next;
+    fcgi_table[fc->fd] = NULL;
+    close(fc->fd);//also drops it from the epoll set
+    buf_put(&fc->pool->owner->bufs, fc->wbuf, fc->wcap);
+    buf_put(&fc->pool->owner->bufs, fc->rbuf, FCGI_RBUF_SIZE);
+    slab_free(&fc->pool->conn_slab, fc);
+}
+
+// Park an answered (or failed) request for pool_settle
+static void request_done(struct fcgi_request *req, int status) {
+    struct fcgi_conn *fc = req->conn;
+
+    if (fc != NULL) {
+        fc->reqs[req->id - 1] = NULL;
+        fc->nreqs--;
+        req->conn = NULL;
+    }
+    req->status = status;
+    req->next = req->pool->done;
+    req->pool->done = req;
+}
+
+// Drop a connection, failing whatever was still in flight on it
+static void conn_fail(struct fcgi_conn *fc, int status) {
+    for (int i = 0; i < FCGI_MAX_MPX; i++) {
+        if (fc->reqs[i] != NULL) {
+            request_done(fc->reqs[i], status);
+        }
+    }
+    conn_free(fc);
+}
+
+static void kill_proc(struct fcgi_app *app, int proc) {
+    pthread_mutex_lock(&apps_lock);
+    if (app->procs[proc].pid > 0) {
+        fprintf(stderr, "FastCGI %s[%d] pid %d unresponsive, killing it\n",
+                app->path, proc, (int)app->procs[proc].pid);
+        kill(-app->procs[proc].pid, SIGKILL);//reaped and restarted by app_maintain
+    }
+    pthread_mutex_unlock(&apps_lock);
+}
+
+// Queue a request's records on a connection
+static int conn_assign(struct fcgi_conn *fc, struct fcgi_request *req) {
+    const struct connection *c = req->client;
+    unsigned char begin[8] = { 0, FCGI_RESPONDER, fc->keep ? FCGI_KEEP_CONN : 0 };
+    struct nv_buf params = { .arena = &fc->pool->owner->scratch };
+    int slot = 0;
+
+    while (fc->reqs[slot] != NULL) {
+        slot++;
+    }
+    req->id = slot + 1;
+
+    const char *body = c->rbuf + c->req.head_len;
+    size_t body_len = c->req.content_length > 0 ? (size_t)c->req.content_length : 0;
+    int err = cgi_variables(c, fc->pool->app->path, req->script_len, params_add, &params) < 0 ||
+              put_stream(fc, FCGI_BEGIN_REQUEST, req->id, (const char *)begin, sizeof(begin), 0) < 0 ||
+              put_stream(fc, FCGI_PARAMS, req->id, params.data, params.len, 1) < 0 ||
+              put_stream(fc, FCGI_STDIN, req->id, body, body_len, 1) < 0;
+    if (err) {
+        return -1;
+    }
+
+    fc->reqs[slot] = req;
+    fc->nreqs++;
+    req->conn = fc;
+    return 0;
+}
+
+static int conn_capacity(const struct fcgi_conn *fc, const struct fcgi_app *app) {
+    int max = __atomic_load_n(&app->procs[fc->proc].max_reqs, __ATOMIC_RELAXED);
+
+    if (!fc->keep) {
+        return 1;
+    }
+    return max < 1 ? 1 : max > FCGI_MAX_MPX ? FCGI_MAX_MPX : max;
+}
+
+// A connection that can take another request, opening one if a process
+// has none from this worker yet
+static struct fcgi_conn *pool_pick(struct fcgi_pool *pool) {
+    struct fcgi_app *app = pool->app;
+
+    for (int k = 0; k < app->nprocs; k++) {
+        int proc = (pool->next_proc + k) % app->nprocs;
+        int busy = 0;
+
+        for (struct fcgi_conn *fc = pool->conns; fc != NULL; fc = fc->next) {
+            if (fc->proc != proc || fc->probe) {
+                continue;
+            }
+            if (fc->keep && fc->nreqs < conn_capacity(fc, app)) {
+                pool->next_proc = (proc + 1) % app->nprocs;
+                return fc;
+            }
+            busy = 1;
+        }
+        if (!busy) {//one-at-a-time processes get one connection from us
+            struct fcgi_conn *fc = conn_connect(pool, proc);
+
+            if (fc != NULL) {
+                pool->next_proc = (proc + 1) % app->nprocs;
+                return fc;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void conn_io(struct fcgi_conn *fc);
+
+// Start queued requests while connections are available
+static void pool_dispatch(struct fcgi_pool *pool) {
+    while (pool->queue != NULL) {
+        struct fcgi_conn *fc = pool_pick(pool);
+        struct fcgi_request *req = pool->queue;
+
+        if (fc == NULL) {
+            break;
+        }
+        pool->queue = req->next;
+        if (pool->queue == NULL) {
+            pool->queue_tail = NULL;
+        }
+        if (conn_assign(fc, req) < 0) {
+            request_done(req, 500);
+            if (fc->nreqs == 0) {
+                conn_free(fc);
+            }
+            continue;
+        }
+        conn_io(fc);//may fail fc, which parks req on the done list
+    }
+}
+
+// Turn the application's CGI response into an HTTP one and queue it on c
+static void respond(struct connection *c, const struct fcgi_request *req) {
+    struct cgi_head head;
+    int head_len = cgi_parse_head(req->out ? req->out : "", req->out_len, &head);
+
+    if (head_len <= 0) {
+        send_response(c->fd, "HTTP/1.1 502 Bad Gateway", NULL, NULL, 0);
+        return;
+    }
+
+    size_t body_len = req->out_len - head_len;
+    size_t cap = 128 + sizeof(head.status) + head.headers_len + body_len;
+    char *buf = buf_get(&c->owner->bufs, cap, &c->body_cap);
+    if (buf == NULL) {
+        send_response(c->fd, "HTTP/1.1 500 Internal Server Error", NULL, NULL, 0);
+        return;
+    }
+    int n = snprintf(buf, cap, "HTTP/1.1 %s\r\n%.*sContent-Length: %zu\r\nConnection: %s\r\n\r\n",
+                     head.status, (int)head.headers_len, head.headers, body_len,
+                     c->keep_alive ? "keep-alive" : "close");
+    if (c->req.method != HTTP_HEAD) {
+        memcpy(buf + n, req->out + head_len, body_len);
+        n += body_len;
+    }
+
+    c->log.status = atoi(head.status);
+    c->body = buf;//whole response goes out as the body, head stays empty
+    c->body_len = n;
+    c->body_off = 0;
+    c->head_len = c->head_off = 0;
+    c->state = CONN_WRITING_HEADER;
+}
+
+static void answer(struct connection *c, const struct fcgi_request *req) {
+    c->state = CONN_WRITING_HEADER;
+    switch (req->status) {
+    case 0:
+        respond(c, req);
+        break;
+    case 503:
+        send_response(c->fd, "HTTP/1.1 503 Service Unavailable", NULL, NULL, 0);
+        break;
+    case 504:
+        send_response(c->fd, "HTTP/1.1 504 Gateway Timeout", NULL, NULL, 0);
+        break;
+    case 500:
+        send_response(c->fd, "HTTP/1.1 500 Internal Server Error", NULL, NULL, 0);
+        break;
+    default:
+        send_response(c->fd, "HTTP/1.1 502 Bad Gateway", NULL, NULL, 0);
+        break;
+    }
+}
+
+// Hand finished requests back to their clients, then start queued ones
+static void pool_settle(struct fcgi_pool *pool) {
+    while (pool->done != NULL || pool->queue != NULL) {
+        struct fcgi_request *req = pool->done;
+
+        if (req == NULL) {
+            pool_dispatch(pool);
+            if (pool->done == NULL) {
+                break;
+            }
+            continue;
+        }
+        pool->done = req->next;
+
+        struct connection *c = req->client;
+        answer(c, req);
+        buf_put(&pool->owner->bufs, req->out, req->out_cap);
+        slab_free(&pool->req_slab, req);
+        if (cfg->mode != SERVE_BLOCKING) {
+            conn_resume(c);//may start the client's next request, possibly on this pool
+        }
+    }
+}
+
+static void handle_values(struct fcgi_conn *fc, const unsigned char *p, size_t len) {
+    struct fcgi_proc *proc = &fc->pool->app->procs[fc->proc];
+    size_t i = 0;
+
+    while (i < len) {
+        size_t nlen, vlen;
+
+        for (int k = 0; k < 2; k++) {
+            size_t *l = k == 0 ? &nlen : &vlen;
+
+            if (i < len && p[i] < 128) {
+                *l = p[i++];
+            } else if (i + 4 <= len) {
+                *l = ((size_t)(p[i] & 0x7f) << 24) | (p[i + 1] << 16) | (p[i + 2] << 8) | p[i + 3];
+                i += 4;
+            } else {
+                return;
+            }
+        }
+        if (i + nlen + vlen > len) {
+            return;
+        }
+        const char *name = (const char *)p + i;
+        int value = 0;
+        char num[16];
+
+        if (vlen < sizeof(num)) {
+            memcpy(num, p + i + nlen, vlen);
+            num[vlen] = '\0';
+            value = atoi(num);
+        }
+        if (nlen == 15 && memcmp(name, "FCGI_MPXS_CONNS", 15) == 0) {
+            __atomic_store_n(&proc->mpxs, value == 1, __ATOMIC_RELAXED);
+        } else if (nlen == 13 && memcmp(name, "FCGI_MAX_REQS", 13) == 0) {
+            __atomic_store_n(&proc->max_reqs, value, __ATOMIC_RELAXED);
+        }
+        i += nlen + vlen;
+    }
+}
+
+// Act on one complete record. Returns -1 if the connection has to go.
+static int handle_record(struct fcgi_conn *fc, int type, uint16_t id, const unsigned char *p, size_t len) {
+    struct fcgi_request *req = id >= 1 && id <= FCGI_MAX_MPX ? fc->reqs[id - 1] : NULL;
+
+    switch (type) {
+    case FCGI_STDOUT:
+        if (req == NULL) {
+            break;
+        }
+        if (req->out_len + len > FCGI_MAX_RESPONSE) {
+            req->status = 502;//keep reading to END_REQUEST but stop storing
+            break;
+        }
+        if (req->out_len + len > req->out_cap) {
+            char *out = buf_grow(&fc->pool->owner->bufs, req->out, req->out_len, &req->out_cap, req->out_len + len);
+            if (out == NULL) {
+                req->status = 500;
+                break;
+            }
+            req->out = out;
+        }
+        memcpy(req->out + req->out_len, p, len);
+        req->out_len += len;
+        break;
+    case FCGI_STDERR:
+        if (len > 0) {
+            fprintf(stderr, "FastCGI %s: %.*s\n", fc->pool->app->path, (int)len, (const char *)p);
+        }
+        break;
+    case FCGI_END_REQUEST:
+        if (req != NULL) {
+            int ok = len >= 5 && p[4] == FCGI_REQUEST_COMPLETE;
+
+            request_done(req, req->status ? req->status : ok ? 0 : 503);//overloaded or can't multiplex
+            if (!fc->keep && fc->nreqs == 0) {
+                return -1;//the application closes it anyway
+            }
+        }
+        break;
+    case FCGI_GET_VALUES_RESULT:
+        handle_values(fc, p, len);
+        /* fall through */
+    case FCGI_UNKNOWN_TYPE:
+        if (fc->probe) {
+            return -1;//it answered, so it's alive
+        }
+        break;
+    }
+    return 0;
+}
+
+// Write what is queued and read what has arrived
+static void conn_io(struct fcgi_conn *fc) {
+    if (!fc->connected) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+
+        if (getsockopt(fc->fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0) {
+            conn_fail(fc, 503);
+            return;
+        }
+        fc->connected = 1;
+    }
+
+    while (fc->woff < fc->wlen) {
+        ssize_t n = send(fc->fd, fc->wbuf + fc->woff, fc->wlen - fc->woff, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            conn_fail(fc, 502);
+            return;
+        }
+        fc->woff += n;
+    }
+
+    for (;;) {
+        ssize_t n = recv(fc->fd, fc->rbuf + fc->rlen, FCGI_RBUF_SIZE - fc->rlen, 0);
+        if (n == 0 || (n < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            conn_fail(fc, 502);//process died or closed mid-request
+            return;
+        }
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        fc->rlen += n;
+
+        size_t off = 0;
+        while (fc->rlen - off >= FCGI_HEADER_LEN) {
+            const unsigned char *h = fc->rbuf + off;
+            size_t clen = (h[4] << 8) | h[5];
+            size_t total = FCGI_HEADER_LEN + clen + h[6];
+
+            if (fc->rlen - off < total) {
+                break;
+            }
+            if (handle_record(fc, h[1], (h[2] << 8) | h[3], h + FCGI_HEADER_LEN, clen) < 0) {
+                conn_fail(fc, 502);//only requests still in flight see the 502
+                return;
+            }
+            off += total;
+        }
+        memmove(fc->rbuf, fc->rbuf + off, fc->rlen - off);
+        fc->rlen -= off;
+    }
+}
+
+int fcgi_event(struct worker *w, int fd) {
+    struct fcgi_conn *fc = fd >= 0 && fd < fcgi_table_size ? fcgi_table[fd] : NULL;
+
+    if (fc == NULL || fc->pool->owner != w) {
+        return -1;
+    }
+    struct fcgi_pool *pool = fc->pool;
+
+    conn_io(fc);
+    pool_settle(pool);
+    return 0;
+}
+
+static void probe_send(struct fcgi_pool *pool, int proc) {
+    static const unsigned char query[] = {
+        15, 0, 'F', 'C', 'G', 'I', '_', 'M', 'P', 'X', 'S', '_', 'C', 'O', 'N', 'N', 'S',
+        13, 0, 'F', 'C', 'G', 'I', '_', 'M', 'A', 'X', '_', 'R', 'E', 'Q', 'S',
+    };
+    struct fcgi_conn *fc = conn_connect(pool, proc);
+
+    if (fc == NULL) {
+        return;
+    }
+    fc->probe = 1;
+    if (put_stream(fc, FCGI_GET_VALUES, 0, (const char *)query, sizeof(query), 0) < 0) {
+        conn_free(fc);
+        return;
+    }
+    conn_io(fc);
+}
+
+// Deadline checks for this worker's requests and health checks
+static void pool_sweep(struct fcgi_pool *pool, long now) {
+    long timeout = cfg->fcgi_timeout * 1000L;
+    struct fcgi_conn *fc, *next;
+
+    for (fc = pool->conns; fc != NULL; fc = next) {
+        int late = fc->probe && now - fc->opened > timeout;
+
+        next = fc->next;
+        for (int i = 0; i < FCGI_MAX_MPX && !late; i++) {
+            late = fc->reqs[i] != NULL && now - fc->reqs[i]->started > timeout;
+        }
+        if (late) {
+            kill_proc(pool->app, fc->proc);
+            conn_fail(fc, 504);
+        }
+    }
+
+    while (pool->queue != NULL && now - pool->queue->started > timeout) {
+        struct fcgi_request *req = pool->queue;
+
+        pool->queue = req->next;
+        if (pool->queue == NULL) {
+            pool->queue_tail = NULL;
+        }
+        request_done(req, 503);
+    }
+    pool_settle(pool);
+}
+
+void fcgi_sweep(struct worker *w) {
+    long now = fcgi_now();
+
+    pthread_mutex_lock(&apps_lock);
+    for (struct fcgi_app *app = apps; app != NULL; app = app->next) {
+        app_maintain(app, now);
+    }
+    pthread_mutex_unlock(&apps_lock);
+
+    for (struct fcgi_pool *pool = w->fcgi; pool != NULL; pool = pool->next) {
+        struct fcgi_app *app = pool->app;
+
+        if (w->id == 0) {//one worker checks health for everyone
+            for (int i = 0; i < app->nprocs; i++) {
+                if (now >= app->procs[i].probe_due) {
+                    app->procs[i].probe_due = now + FCGI_PROBE_MS;
+                    probe_send(pool, i);
+                }
+            }
+        }
+        pool_sweep(pool, now);
+    }
+}
+
+void fcgi_submit(struct connection *c, const char *target) {
+    char path[1024];
+    size_t script_len = cgi_script_len(target, ".fcgi");
+
+    if (cgi_script_path(target, script_len, path, sizeof(path)) < 0) {
+        send_response(c->fd, "HTTP/1.1 400 Bad Request", NULL, NULL, 0);
+        return;
+    }
+    if (!path_executable(path + sizeof(DOCUMENT_ROOT))) {
+        send_response(c->fd, "HTTP/1.1 404 Not Found", NULL, NULL, 0);
+        return;
+    }
+    if (c->framing_lost && (c->req.content_length > 0 || c->req.chunked)) {
+        send_response(c->fd, "HTTP/1.1 413 Content Too Large", NULL, NULL, 0);//body is not all buffered
+        return;
+    }
+
+    struct fcgi_app *app = app_get(path);
+    struct fcgi_pool *pool = app ? pool_get(c->owner, app) : NULL;
+    struct fcgi_request *req = pool ? slab_alloc(&pool->req_slab) : NULL;
+    if (req == NULL) {
+        send_response(c->fd, "HTTP/1.1 502 Bad Gateway", NULL, NULL, 0);
+        return;
+    }
+    memset(req, 0, sizeof(*req));
+    req->client = c;
+    req->pool = pool;
+    req->script_len = script_len;
+    req->started = fcgi_now();
+    if (pool->queue_tail != NULL) {
+        pool->queue_tail->next = req;
+    } else {
+        pool->queue = req;
+    }
+    pool->queue_tail = req;
+    c->state = CONN_WAITING;
+
+    if (cfg->mode != SERVE_BLOCKING) {
+        pool_settle(pool);//the answer arrives through fcgi_event
+        return;
+    }
+
+    while (c->state == CONN_WAITING) {//blocking mode: sit on the socket until it answers
+        pool_settle(pool);
+        if (c->state != CONN_WAITING) {
+            break;
+        }
+
+        struct pollfd pfd = { -1, POLLIN, 0 };
+        if (req->conn != NULL) {
+            pfd.fd = req->conn->fd;
+            pfd.events = POLLIN | (req->conn->woff < req->conn->wlen || !req->conn->connected ? POLLOUT : 0);
+        }
+        poll(&pfd, 1, req->conn != NULL ? 1000 : 10);
+        if (req->conn != NULL) {
+            conn_io(req->conn);
+        }
+        pool_sweep(pool, fcgi_now());
+    }
+}
+
+void fcgi_shutdown(void) {
+    pthread_mutex_lock(&apps_lock);
+    for (struct fcgi_app *app = apps; app != NULL; app = app->next) {
+        for (int i = 0; i < app->nprocs; i++) {
+            if (app->procs[i].pid > 0) {
+                kill(app->procs[i].pid, SIGTERM);
+                waitpid(app->procs[i].pid, NULL, 0);
+                app->procs[i].pid = 0;
+            }
+        }
+    }
+    pthread_mutex_unlock(&apps_lock);
+}
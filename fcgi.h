@@ -0,0 +1,38 @@
+#ifndef FCGI_H
+#define FCGI_H
+
+// FastCGI client. Scripts named *.fcgi run as a pool of long-lived processes
+// (fcgi_procs per script), each accepting on its own local socket handed to
+// it as fd 0, the way FastCGI applications expect. Requests are multiplexed
+// over one connection per process when the application says it can
+// (FCGI_MPXS_CONNS), otherwise each request gets its own connection.
+// Processes that crash are restarted; ones that stop answering health checks
+// or overrun fcgi_timeout are killed and restarted.
+
+struct connection;
+struct worker;
+
+// Per-worker state, see fcgi.c
+struct fcgi_pool;
+
+// Set up the socket lookup table; call once before any worker runs
+void fcgi_init(void);
+
+// Is the request target served by a FastCGI pool?
+int fcgi_script(const char *target);
+
+// Hand the request on c to its script's pool. The response is queued on c
+// once the application answers, then c is resumed; in blocking mode this
+// waits for it.
+void fcgi_submit(struct connection *c, const char *target);
+
+// Readiness on one of the worker's FastCGI sockets; -1 if fd is not one
+int fcgi_event(struct worker *w, int fd);
+
+// Timeouts, health checks and restarts; call about once a second
+void fcgi_sweep(struct worker *w);
+
+// Stop every pool's processes
+void fcgi_shutdown(void);
+
+#endif // FCGI_H
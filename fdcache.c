@@ -0,0 +1,205 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include "fdcache.h"
+#include "path.h"
+#include "metrics.h"
+
+static unsigned hash_path(const char *path) {
+    unsigned h = 2166136261u;//FNV-1a
+
+    while (*path) {
+        h ^= (unsigned char)*path++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+int fd_cache_init(struct fd_cache *fc, size_t max_entries, long valid_ms) {
+    memset(fc, 0, sizeof(*fc));
+    fc->max_entries = max_entries;
+    fc->valid_ms = valid_ms;
+    if (max_entries == 0) {
+        return 0;
+    }
+
+    size_t n = 64;
+    while (n < max_entries) {//at most one entry per bucket on average
+        n *= 2;
+    }
+    fc->buckets = calloc(n, sizeof(*fc->buckets));
+    fc->ring = calloc(max_entries, sizeof(*fc->ring));
+    if (fc->buckets == NULL || fc->ring == NULL) {
+        free(fc->buckets);
+        free(fc->ring);
+        memset(fc, 0, sizeof(*fc));
+        return -1;
+    }
+    fc->nbuckets = n;
+    return 0;
+}
+
+static void entry_free(struct fd_entry *e) {
+    if (e->fd >= 0) {
+        close(e->fd);
+    }
+    free(e);
+}
+
+// Open path for a new entry, recording the failure instead if there is one
+static struct fd_entry *entry_open(const char *path, unsigned hash, long now) {
+    size_t len = strlen(path);
+    struct fd_entry *e = malloc(sizeof(*e) + len + 1);
+
+    if (e == NULL) {
+        return NULL;
+    }
+    memset(e, 0, sizeof(*e));
+    memcpy(e->path, path, len + 1);
+    e->hash = hash;
+    e->checked_at = now;
+
+    // path_open adds O_CLOEXEC, which keeps these long-lived descriptors out
+    // of CGI children; O_NONBLOCK stops a FIFO under www/ from hanging the worker
+    e->fd = path_open(path, O_RDONLY | O_NONBLOCK);
+    if (e->fd < 0) {
+        e->err = errno;
+    } else if (fstat(e->fd, &e->st) < 0) {
+        e->err = errno;
+        close(e->fd);
+        e->fd = -1;
+    }
+    return e;
+}
+
+// Unlink an entry from the index and the ring; it is closed once unreferenced
+static void fd_cache_remove(struct fd_cache *fc, struct fd_entry *e) {
+    struct fd_entry **pp = &fc->buckets[e->hash & (fc->nbuckets - 1)];
+
+    while (*pp != e) {
+        pp = &(*pp)->hnext;
+    }
+    *pp = e->hnext;
+
+    fc->ring[e->slot] = fc->ring[--fc->nentries];//fill the hole with the last entry
+    fc->ring[e->slot]->slot = e->slot;
+    if (fc->hand >= fc->nentries) {
+        fc->hand = 0;
+    }
+
+    if (e->refs > 0) {
+        e->dead = 1;
+    } else {
+        entry_free(e);
+    }
+}
+
+// Whether the file at e's path is still the one e has open
+static int still_current(const struct fd_entry *e) {
+    struct stat st;
+
+    return path_stat(e->path, &st) == 0 && st.st_ino == e->st.st_ino && st.st_dev == e->st.st_dev &&
+           st.st_size == e->st.st_size && st.st_mtim.tv_sec == e->st.st_mtim.tv_sec &&
+           st.st_mtim.tv_nsec == e->st.st_mtim.tv_nsec;
+}
+
+static struct fd_entry *find(const struct fd_cache *fc, const char *path, unsigned h) {
+    struct fd_entry *e = NULL;
+
+    if (fc->nentries > 0) {
+        e = fc->buckets[h & (fc->nbuckets - 1)];
+        while (e != NULL && (e->hash != h || strcmp(e->path, path) != 0)) {
+            e = e->hnext;
+        }
+    }
+    return e;
+}
+
+int fd_error_lasting(int err) {
+    return err == ENOENT || err == ENOTDIR || err == EACCES || err == ELOOP || err == EXDEV;
+}
+
+int fd_cache_stat(struct fd_cache *fc, const char *path, long now, struct stat *st) {
+    struct fd_entry *e = find(fc, path, hash_path(path));
+
+    if (e == NULL || now - e->checked_at >= fc->valid_ms) {
+        return path_stat(path, st);//fd_cache_open checks a stale entry again itself
+    }
+    e->referenced = 1;
+    COUNTER_ADD(fc->hits, 1);
+    if (e->fd < 0) {
+        errno = e->err;
+        return -1;
+    }
+    *st = e->st;
+    return 0;
+}
+
+struct fd_entry *fd_cache_open(struct fd_cache *fc, const char *path, long now) {
+    unsigned h = hash_path(path);
+    struct fd_entry *e = find(fc, path, h);
+
+    if (e != NULL && now - e->checked_at >= fc->valid_ms) {//revalidate against the filesystem
+        if (e->fd >= 0 && still_current(e)) {
+            e->checked_at = now;
+        } else {
+            fd_cache_remove(fc, e);//replaced, deleted or created since: open it again
+            e = NULL;
+        }
+    }
+    if (e != NULL) {
+        e->referenced = 1;
+        e->refs++;
+        COUNTER_ADD(fc->hits, 1);
+        return e;
+    }
+
+    COUNTER_ADD(fc->misses, 1);
+    e = entry_open(path, h, now);
+    if (e == NULL) {
+        return NULL;
+    }
+    e->refs = 1;
+    if (fc->max_entries == 0 || (e->fd < 0 && !fd_error_lasting(e->err))) {
+        e->dead = 1;//not cached, closed on release; EMFILE and the like pass
+        return e;
+    }
+
+    while (fc->nentries >= fc->max_entries) {//evict with CLOCK
+        struct fd_entry *victim = fc->ring[fc->hand];
+
+        if (victim->referenced) {
+            victim->referenced = 0;
+            fc->hand = (fc->hand + 1) % fc->nentries;
+        } else {
+            fd_cache_remove(fc, victim);
+        }
+    }
+    e->hnext = fc->buckets[h & (fc->nbuckets - 1)];
+    fc->buckets[h & (fc->nbuckets - 1)] = e;
+    e->slot = fc->nentries;
+    fc->ring[fc->nentries++] = e;
+    return e;
+}
+
+void fd_cache_release(struct fd_entry *e) {
+    if (--e->refs == 0 && e->dead) {
+        entry_free(e);
+    }
+}
+
+void fd_cache_sweep(struct fd_cache *fc, long now) {
+    size_t i = 0;
+
+    while (i < fc->nentries) {
+        struct fd_entry *e = fc->ring[i];
+
+        if (now - e->checked_at >= fc->valid_ms) {
+            fd_cache_remove(fc, e);//the last entry moved into slot i, look at it next
+        } else {
+            i++;
+        }
+    }
+}
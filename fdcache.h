@@ -0,0 +1,69 @@
+#ifndef FDCACHE_H
+#define FDCACHE_H
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// An open file together with what fstat() said about it, or the errno
+// open() failed with, so that the next request for the same path skips
+// the path walk
+struct fd_entry {
+    unsigned hash;
+    struct fd_entry *hnext; // next entry in the same hash bucket
+    size_t slot;            // index in the CLOCK ring
+
+    int fd;                 // read-only descriptor, -1 for a negative entry
+    int err;                // why the open failed when fd is -1
+    struct stat st;         // identity and size when fd is open
+    long checked_at;        // monotonic ms of the open or the last identity check
+
+    int refs;               // responses still sending from fd
+    int referenced;         // CLOCK second-chance bit
+    int dead;               // evicted while referenced, closed on last release
+    char path[];            // normalized path under the root, the lookup key
+};
+
+// Per-worker cache bounded by an entry count and evicted with CLOCK.
+// Entries are trusted for valid_ms, then checked against stat() of the
+// path; negative entries are simply dropped and the open retried. Only
+// the owning worker touches it, so there is no locking.
+struct fd_cache {
+    struct fd_entry **buckets;
+    size_t nbuckets;        // power of two
+    struct fd_entry **ring; // entries in CLOCK order
+    size_t nentries;
+    size_t hand;
+
+    size_t max_entries;     // upper bound for nentries, 0 disables the cache
+    long valid_ms;          // how long an open or an identity check is trusted
+
+    unsigned long hits;
+    unsigned long misses;
+};
+
+// Prepare an empty cache; returns -1 if its tables cannot be allocated
+int fd_cache_init(struct fd_cache *fc, size_t max_entries, long valid_ms);
+
+// open() and fstat() path read-only through the cache and take a reference
+// on the entry. A failed open comes back as an entry with fd -1 and err set,
+// remembered only if fd_error_lasting(err). NULL only when out of memory.
+struct fd_entry *fd_cache_open(struct fd_cache *fc, const char *path, long now);
+
+// What fd_cache_open would find at path, without opening it: the identity of
+// a fresh entry, else stat(). 0, or -1 with errno set.
+int fd_cache_stat(struct fd_cache *fc, const char *path, long now, struct stat *st);
+
+// Whether an open failed because of the path itself (missing, not a
+// directory on the way, no permission, out of the root), which lasts until
+// the tree changes, rather than for want of descriptors or memory
+int fd_error_lasting(int err);
+
+// Drop a reference taken by fd_cache_open
+void fd_cache_release(struct fd_entry *e);
+
+// Close entries not checked for valid_ms, so that files deleted or replaced
+// since are not held open while nobody asks for them
+void fd_cache_sweep(struct fd_cache *fc, long now);
+
+#endif // FDCACHE_H
@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include "filecache.h"
+#include "path.h"
+#include "metrics.h"
+
+// The key is the path and the coding its bytes are in: app.js.gz sent as
+// a sidecar for app.js and asked for directly are two representations
+static unsigned hash_key(const char *path, enum content_coding coding) {
+    unsigned h = 2166136261u;//FNV-1a
+
+    while (*path) {
+        h ^= (unsigned char)*path++;
+        h *= 16777619u;
+    }
+    h ^= coding;
+    return h * 16777619u;
+}
+
+void cache_init(struct file_cache *fc, size_t budget, size_t max_entry, long valid_ms) {
+    memset(fc, 0, sizeof(*fc));
+    fc->budget = budget;
+    fc->max_entry = max_entry < budget ? max_entry : budget;
+    fc->valid_ms = valid_ms;
+}
+
+void file_rep_init(struct file_rep *rep, const struct stat *st, const char *mime_type,
+                   enum content_coding coding, int vary) {
+    rep->mime_type = mime_type;
+    rep->coding = coding;
+    rep->vary = vary;
+    rep->ino = st->st_ino;
+    rep->size = st->st_size;
+    rep->mtime = st->st_mtim;
+}
+
+int format_etag(char *buf, size_t len, const struct file_rep *rep) {
+    const char *coding = coding_name(rep->coding);
+
+    return snprintf(buf, len, "\"%llx-%llx-%llx%s%s\"",
+                    (unsigned long long)rep->ino, (unsigned long long)rep->size,
+                    (unsigned long long)rep->mtime.tv_sec * 1000000000ULL + rep->mtime.tv_nsec,
+                    coding ? "-" : "", coding ? coding : "");
+}
+
+int format_validators(char *buf, size_t len, const struct file_rep *rep) {
+    const char *coding = coding_name(rep->coding);
+    char etag[80];
+    char date[64];
+    struct tm tm;
+
+    format_etag(etag, sizeof(etag), rep);
+    gmtime_r(&rep->mtime.tv_sec, &tm);
+    strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+
+    return snprintf(buf, len, "%s%s%s%sETag: %s\r\nLast-Modified: %s\r\n",
+                    coding ? "Content-Encoding: " : "", coding ? coding : "", coding ? "\r\n" : "",
+                    rep->vary ? "Vary: Accept-Encoding\r\n" : "", etag, date);
+}
+
+int format_file_head(char *buf, size_t len, const struct file_rep *rep, long long content_length) {
+    int n = snprintf(buf, len,
+                     "HTTP/1.1 200 OK\r\n"
+                     "Content-Type: %s\r\n"
+                     "Content-Length: %lld\r\n"
+                     "Accept-Ranges: bytes\r\n",
+                     rep->mime_type, content_length);
+
+    if (n < 0 || (size_t)n >= len) {
+        return n;
+    }
+    return n + format_validators(buf + n, len - n, rep);
+}
+
+static void entry_free(struct cache_entry *e) {
+    for (int i = 0; i < CODING_COUNT; i++) {
+        free(e->coded[i].data);
+    }
+    free(e->path);
+    free(e->data);
+    free(e);
+}
+
+static size_t entry_bytes(const struct cache_entry *e) {
+    size_t bytes = e->size;
+
+    for (int i = 0; i < CODING_COUNT; i++) {
+        bytes += e->coded[i].size;
+    }
+    return bytes;
+}
+
+// Unlink an entry from the index and the ring; its memory goes once unreferenced
+static void cache_remove(struct file_cache *fc, struct cache_entry *e) {
+    struct cache_entry **pp = &fc->buckets[e->hash & (fc->nbuckets - 1)];
+
+    while (*pp != e) {
+        pp = &(*pp)->hnext;
+    }
+    *pp = e->hnext;
+
+    fc->ring[e->slot] = fc->ring[--fc->nentries];//fill the hole with the last entry
+    fc->ring[e->slot]->slot = e->slot;
+    if (fc->hand >= fc->nentries) {
+        fc->hand = 0;
+    }
+    fc->bytes -= entry_bytes(e);
+
+    if (e->refs > 0) {
+        e->dead = 1;
+    } else {
+        entry_free(e);
+    }
+}
+
+// Evict with CLOCK until need more bytes fit in the budget
+static void cache_make_room(struct file_cache *fc, size_t need) {
+    while (fc->nentries > 0 && fc->bytes + need > fc->budget) {
+        struct cache_entry *e = fc->ring[fc->hand];
+
+        if (e->referenced) {
+            e->referenced = 0;
+            fc->hand = (fc->hand + 1) % fc->nentries;
+        } else {
+            cache_remove(fc, e);
+        }
+    }
+}
+
+static int cache_grow(struct file_cache *fc) {
+    if (fc->nentries == fc->ring_cap) {
+        size_t cap = fc->ring_cap ? fc->ring_cap * 2 : 64;
+        struct cache_entry **ring = realloc(fc->ring, cap * sizeof(*ring));
+
+        if (ring == NULL) {
+            return -1;
+        }
+        fc->ring = ring;
+        fc->ring_cap = cap;
+    }
+
+    if (fc->nentries >= fc->nbuckets) {//keep chains short
+        size_t n = fc->nbuckets ? fc->nbuckets * 2 : 64;
+        struct cache_entry **buckets = calloc(n, sizeof(*buckets));
+
+        if (buckets == NULL) {
+            return -1;
+        }
+        for (size_t i = 0; i < fc->nentries; i++) {
+            struct cache_entry *e = fc->ring[i];
+
+            e->hnext = buckets[e->hash & (n - 1)];
+            buckets[e->hash & (n - 1)] = e;
+        }
+        free(fc->buckets);
+        fc->buckets = buckets;
+        fc->nbuckets = n;
+    }
+    return 0;
+}
+
+struct cache_entry *cache_lookup(struct file_cache *fc, const char *path, enum content_coding coding,
+                                 const char *mime_type, long now) {
+    if (fc->nentries == 0) {
+        COUNTER_ADD(fc->misses, 1);
+        return NULL;
+    }
+
+    unsigned h = hash_key(path, coding);
+    struct cache_entry *e = fc->buckets[h & (fc->nbuckets - 1)];
+
+    while (e != NULL && (e->hash != h || e->rep.coding != coding || strcmp(e->path, path) != 0 ||
+                         strcmp(e->rep.mime_type, mime_type) != 0)) {
+        e = e->hnext;
+    }
+    if (e == NULL) {
+        COUNTER_ADD(fc->misses, 1);
+        return NULL;
+    }
+
+    if (now - e->checked_at >= fc->valid_ms) {//revalidate against the filesystem
+        struct stat st;
+
+        if (path_stat(path, &st) < 0 || st.st_ino != e->ino || st.st_dev != e->dev ||
+            (size_t)st.st_size != e->size || st.st_mtim.tv_sec != e->mtime.tv_sec ||
+            st.st_mtim.tv_nsec != e->mtime.tv_nsec) {
+            cache_remove(fc, e);
+            COUNTER_ADD(fc->misses, 1);
+            return NULL;
+        }
+        e->checked_at = now;
+    }
+
+    e->referenced = 1;
+    e->refs++;
+    COUNTER_ADD(fc->hits, 1);
+    return e;
+}
+
+struct cache_entry *cache_insert(struct file_cache *fc, const char *path, int fd,
+                                 const struct stat *st, const struct file_rep *rep, long now) {
+    size_t size = st->st_size;
+
+    if (!S_ISREG(st->st_mode) || size > fc->max_entry || cache_grow(fc) < 0) {
+        return NULL;
+    }
+
+    struct cache_entry *e = calloc(1, sizeof(*e));
+    if (e == NULL) {
+        return NULL;
+    }
+    e->path = strdup(path);
+    e->data = malloc(size ? size : 1);
+    if (e->path == NULL || e->data == NULL) {
+        entry_free(e);
+        return NULL;
+    }
+
+    size_t got = 0;
+    while (got < size) {//pread so the caller's offset is untouched
+        ssize_t n = pread(fd, e->data + got, size - got, got);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            entry_free(e);//shrank or unreadable, let the caller stream it
+            return NULL;
+        }
+        got += n;
+    }
+
+    int len = format_file_head(e->head, sizeof(e->head), rep, size);
+    if (len < 0 || (size_t)len >= sizeof(e->head)) {
+        entry_free(e);
+        return NULL;
+    }
+    e->head_len = len;
+    e->rep = *rep;
+    e->size = size;
+    e->hash = hash_key(path, rep->coding);
+    e->dev = st->st_dev;
+    e->ino = st->st_ino;
+    e->mtime = st->st_mtim;
+    e->checked_at = now;
+
+    cache_make_room(fc, size);
+    e->hnext = fc->buckets[e->hash & (fc->nbuckets - 1)];
+    fc->buckets[e->hash & (fc->nbuckets - 1)] = e;
+    e->slot = fc->nentries;
+    fc->ring[fc->nentries++] = e;
+    fc->bytes += size;
+
+    e->refs = 1;
+    return e;
+}
+
+const struct cache_variant *cache_encode(struct file_cache *fc, struct cache_entry *e,
+                                         enum content_coding coding, int level) {
+    struct cache_variant *v = &e->coded[coding];
+
+    if (v->tried) {
+        return v->data != NULL ? v : NULL;
+    }
+    v->tried = 1;
+
+    char *data;
+    size_t size;
+    if (compress_buffer(coding, level, e->data, e->size, &data, &size) < 0) {
+        return NULL;
+    }
+
+    struct file_rep rep = e->rep;
+    rep.coding = coding;
+    rep.vary = 1;
+    int len = format_file_head(v->head, sizeof(v->head), &rep, size);
+    if (len < 0 || (size_t)len >= sizeof(v->head)) {
+        free(data);
+        return NULL;
+    }
+
+    cache_make_room(fc, size);//may evict e itself, which only marks it dead while we hold it
+    v->data = data;
+    v->size = size;
+    v->head_len = len;
+    if (!e->dead) {
+        fc->bytes += size;//a dead entry was already uncounted
+    }
+    return v;
+}
+
+void cache_release(struct cache_entry *e) {
+    if (--e->refs == 0 && e->dead) {
+        entry_free(e);
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef FILECACHE_H
+#define FILECACHE_H
+
+#include <stddef.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "compress.h"
+
+// The representation of a file a response carries; validators and the
+// content-negotiation headers are derived from it
+struct file_rep {
+    const char *mime_type;
+    enum content_coding coding;
+    int vary;               // chosen by Accept-Encoding, so say so
+    ino_t ino;              // file version (of the uncompressed file for
+    off_t size;             // on-the-fly codings) the ETag is built from
+    struct timespec mtime;
+};
+
+// A compressed copy of a cached file, made the first time a client asks
+struct cache_variant {
+    char *data;             // NULL if not made yet or it did not shrink the file
+    size_t size;
+    char head[512];
+    size_t head_len;
+    int tried;              // compression attempted, don't repeat a failure
+};
+
+// A small file held in memory together with its ready-made 200 head
+struct cache_entry {
+    char *path;             // normalized path under the root; with rep.coding and
+                            // rep.mime_type the lookup key
+    unsigned hash;
+    struct cache_entry *hnext; // next entry in the same hash bucket
+    size_t slot;            // index in the CLOCK ring
+
+    char *data;             // file contents
+    size_t size;
+    char head[512];         // status line, Content-Type, Content-Length, Accept-Ranges, ETag
+    size_t head_len;        // and Last-Modified; the connection adds Connection and CRLF
+    struct file_rep rep;    // what head describes
+    struct cache_variant coded[CODING_COUNT]; // by content coding, identity unused
+
+    dev_t dev;              // stat identity the bytes were read under
+    ino_t ino;
+    struct timespec mtime;
+    long checked_at;        // monotonic ms of the last identity check
+
+    int refs;               // responses still sending from data
+    int referenced;         // CLOCK second-chance bit
+    int dead;               // evicted while referenced, freed on last release
+};
+
+// Per-worker cache bounded by a byte budget and evicted with CLOCK.
+// Only the owning worker touches it, so there is no locking.
+struct file_cache {
+    struct cache_entry **buckets;
+    size_t nbuckets;        // power of two
+    struct cache_entry **ring; // entries in CLOCK order
+    size_t nentries;
+    size_t ring_cap;
+    size_t hand;
+
+    size_t bytes;           // file and compressed bytes currently held
+    size_t budget;          // upper bound for bytes, 0 disables the cache
+    size_t max_entry;       // larger files are never cached
+    long valid_ms;          // how long an identity check is trusted
+
+    unsigned long hits;
+    unsigned long misses;
+};
+
+// Prepare an empty cache
+void cache_init(struct file_cache *fc, size_t budget, size_t max_entry, long valid_ms);
+
+// Find a fresh entry for path sent as coding and mime_type (a sidecar and
+// the same file asked for directly are different entries) and take a
+// reference on it; NULL on a miss. Entries whose file changed since they
+// were read are dropped here.
+struct cache_entry *cache_lookup(struct file_cache *fc, const char *path, enum content_coding coding,
+                                 const char *mime_type, long now);
+
+// Read an open file into the cache, keyed by path and rep, and take a
+// reference on the new entry. Returns NULL if the file does not fit or
+// changed while being read.
+struct cache_entry *cache_insert(struct file_cache *fc, const char *path, int fd,
+                                 const struct stat *st, const struct file_rep *rep, long now);
+
+// The entry compressed with coding, made now if needed; NULL if compressing
+// does not pay off for this file
+const struct cache_variant *cache_encode(struct file_cache *fc, struct cache_entry *e,
+                                         enum content_coding coding, int level);
+
+// Drop a reference taken by cache_lookup or cache_insert
+void cache_release(struct cache_entry *e);
+
+// Fill in a representation of the file st describes
+void file_rep_init(struct file_rep *rep, const struct stat *st, const char *mime_type,
+                   enum content_coding coding, int vary);
+
+// Write the 200 status line and file headers (no Connection, no blank line)
+int format_file_head(char *buf, size_t len, const struct file_rep *rep, long long content_length);
+
+// Strong entity tag, quotes included: "ino-size-mtimens" in hex, plus the
+// coding for compressed representations
+int format_etag(char *buf, size_t len, const struct file_rep *rep);
+
+// Content-Encoding and Vary when they apply, then ETag and Last-Modified
+int format_validators(char *buf, size_t len, const struct file_rep *rep);
+
+#endif // FILECACHE_H
@@ -0,0 +1,270 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "handoff.h"
+
+#define FDS_PER_MSG 64          // well under the kernel's SCM_MAX_FD
+
+extern char **environ;
+
+// What comes first down the socket
+struct handoff_hello {
+    char magic[8];
+    uint32_t nfds;
+    uint32_t pad;
+    uint64_t state_len;
+};
+
+static const char hello_magic[8] = "HSHAND1";
+
+pid_t handoff_spawn(const char *path, int search, char *const argv[], int *sock) {
+    int sv[2];
+    char var[32];
+    size_t n = 0;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+        perror("handoff socketpair");
+        return -1;
+    }
+    fcntl(sv[0], F_SETFD, FD_CLOEXEC);//ours; sv[1] must survive the exec
+
+    while (environ[n] != NULL) {
+        n++;
+    }
+    char **envp = malloc((n + 2) * sizeof(*envp));
+    if (envp == NULL) {
+        perror("handoff environment");
+        close(sv[0]);
+        close(sv[1]);
+        return -1;
+    }
+    n = 0;
+    for (char **e = environ; *e != NULL; e++) {
+        if (strncmp(*e, HANDOFF_ENV "=", sizeof(HANDOFF_ENV)) != 0) {
+            envp[n++] = *e;
+        }
+    }
+    snprintf(var, sizeof(var), "%s=%d", HANDOFF_ENV, HANDOFF_FD);
+    envp[n++] = var;
+    envp[n] = NULL;
+
+    posix_spawn_file_actions_t fa;
+    posix_spawnattr_t attr;
+    sigset_t none;
+    pid_t pid;
+
+    posix_spawn_file_actions_init(&fa);
+    if (sv[1] != HANDOFF_FD) {
+        posix_spawn_file_actions_adddup2(&fa, sv[1], HANDOFF_FD);
+    }
+    posix_spawn_file_actions_addclosefrom_np(&fa, HANDOFF_FD + 1);//listeners go over the socket, not by inheritance
+    posix_spawnattr_init(&attr);
+    sigemptyset(&none);
+    posix_spawnattr_setsigmask(&attr, &none);//we wait for signals with them blocked
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK);
+
+    int r = search ? posix_spawnp(&pid, path, &fa, &attr, argv, envp)
+                   : posix_spawn(&pid, path, &fa, &attr, argv, envp);
+    posix_spawn_file_actions_destroy(&fa);
+    posix_spawnattr_destroy(&attr);
+    free(envp);
+    close(sv[1]);
+    if (r != 0) {
+        fprintf(stderr, "starting %s: %s\n", path, strerror(r));
+        close(sv[0]);
+        return -1;
+    }
+    *sock = sv[0];
+    return pid;
+}
+
+static int send_all(int sock, const void *buf, size_t len) {
+    const char *p = buf;
+
+    while (len > 0) {
+        ssize_t n = send(sock, p, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        len -= n;
+    }
+    return 0;
+}
+
+int handoff_send(int sock, const int *fds, int nfds, const char *state, size_t len) {
+    struct handoff_hello hello = {0};
+
+    memcpy(hello.magic, hello_magic, sizeof(hello.magic));
+    hello.nfds = nfds;
+    hello.state_len = len;
+    if (send_all(sock, &hello, sizeof(hello)) < 0) {
+        return -1;
+    }
+
+    for (int i = 0; i < nfds; i += FDS_PER_MSG) {
+        int n = nfds - i < FDS_PER_MSG ? nfds - i : FDS_PER_MSG;
+        union {
+            char buf[CMSG_SPACE(FDS_PER_MSG * sizeof(int))];
+            struct cmsghdr align;
+        } u;
+        char byte = 'F';//a stream socket needs a data byte to carry the descriptors
+        struct iovec iov = { &byte, 1 };
+        struct msghdr msg = {0};
+
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = u.buf;
+        msg.msg_controllen = CMSG_SPACE(n * sizeof(int));
+
+        struct cmsghdr *cm = CMSG_FIRSTHDR(&msg);
+        cm->cmsg_level = SOL_SOCKET;
+        cm->cmsg_type = SCM_RIGHTS;
+        cm->cmsg_len = CMSG_LEN(n * sizeof(int));
+        memcpy(CMSG_DATA(cm), fds + i, n * sizeof(int));
+        while (sendmsg(sock, &msg, MSG_NOSIGNAL) < 0) {
+            if (errno != EINTR) {
+                return -1;
+            }
+        }
+    }
+
+    if (send_all(sock, state, len) < 0) {
+        return -1;
+    }
+    shutdown(sock, SHUT_WR);//all sent; only the ready byte comes back
+    return 0;
+}
+
+int handoff_poll(int sock, int timeout_ms) {
+    struct pollfd pfd = { sock, POLLIN, 0 };
+    char byte = 0;
+
+    if (poll(&pfd, 1, timeout_ms) <= 0) {//EINTR too: the caller sees to the signal and asks again
+        return 0;
+    }
+    while (read(sock, &byte, 1) < 0 && errno == EINTR) {
+        ;
+    }
+    return byte == 'R' ? 1 : -1;
+}
+
+void handoff_abandon(int sock, pid_t pid) {
+    close(sock);
+    kill(pid, SIGKILL);//harmless if it already gave up and exited
+    waitpid(pid, NULL, 0);
+}
+
+int handoff_inherited(void) {
+    const char *v = getenv(HANDOFF_ENV);
+    int fd = v != NULL ? atoi(v) : -1;
+
+    unsetenv(HANDOFF_ENV);
+    if (fd < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) < 0) {
+        return -1;
+    }
+    return fd;
+}
+
+static int recv_all(int sock, void *buf, size_t len) {
+    char *p = buf;
+
+    while (len > 0) {
+        ssize_t n = recv(sock, p, len, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        p += n;
+        len -= n;
+    }
+    return 0;
+}
+
+int handoff_receive(int sock, int *fds, int max, char **state, size_t *len) {
+    struct handoff_hello hello;
+    int nfds = 0, bad = 0;
+
+    if (recv_all(sock, &hello, sizeof(hello)) < 0 || memcmp(hello.magic, hello_magic, sizeof(hello.magic)) != 0) {
+        fprintf(stderr, "handoff: no listeners from the previous process\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < hello.nfds; i += FDS_PER_MSG) {
+        union {
+            char buf[CMSG_SPACE(FDS_PER_MSG * sizeof(int))];
+            struct cmsghdr align;
+        } u;
+        char byte;
+        struct iovec iov = { &byte, 1 };
+        struct msghdr msg = {0};
+        ssize_t n;
+
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = u.buf;
+        msg.msg_controllen = sizeof(u.buf);
+        while ((n = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) {
+            ;
+        }
+        if (n != 1 || (msg.msg_flags & MSG_CTRUNC)) {
+            bad = 1;
+        }
+        for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); n == 1 && cm != NULL; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (cm->cmsg_level != SOL_SOCKET || cm->cmsg_type != SCM_RIGHTS) {
+                continue;
+            }
+
+            int *got = (int *)CMSG_DATA(cm);
+            size_t count = (cm->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            for (size_t k = 0; k < count; k++) {
+                if (nfds < max) {
+                    fds[nfds++] = got[k];
+                } else {
+                    close(got[k]);
+                }
+            }
+        }
+        if (bad) {
+            break;
+        }
+    }
+
+    *state = malloc(hello.state_len + 1);
+    if (bad || *state == NULL || recv_all(sock, *state, hello.state_len) < 0) {
+        fprintf(stderr, "handoff: short transfer from the previous process\n");
+        free(*state);
+        *state = NULL;
+        while (nfds > 0) {
+            close(fds[--nfds]);
+        }
+        return -1;
+    }
+    (*state)[hello.state_len] = '\0';
+    *len = hello.state_len;
+    return nfds;
+}
+
+void handoff_ready(int sock) {
+    char byte = 'R';
+
+    while (write(sock, &byte, 1) < 0 && errno == EINTR) {
+        ;
+    }
+    close(sock);
+}
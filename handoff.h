@@ -0,0 +1,48 @@
+#ifndef HANDOFF_H
+#define HANDOFF_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+// Passing the listening sockets to the next generation of the server, so a
+// reload or an upgrade never closes them. The running server starts the new
+// binary with one end of a Unix socket pair as fd HANDOFF_FD (named in the
+// environment), sends it every listener with SCM_RIGHTS followed by an
+// opaque state blob (the hot paths to warm its caches with), and waits for
+// a ready byte. Both processes accept from the very same sockets meanwhile,
+// so nothing queued on them is lost; only once the new one is ready does
+// the old one stop accepting and drain.
+
+#define HANDOFF_ENV "HTTPSERVE_HANDOFF"
+#define HANDOFF_FD 3
+#define HANDOFF_MAX_FDS 1024
+#define HANDOFF_TIMEOUT_MS 60000 // for the new process to start and warm up
+
+// Start path (searched in PATH if search is set, like execvp) with argv and
+// the socket pair; the caller's end comes back in *sock. Returns the pid, or
+// -1 after printing why.
+pid_t handoff_spawn(const char *path, int search, char *const argv[], int *sock);
+
+// Send nfds descriptors and len bytes of state down sock
+int handoff_send(int sock, const int *fds, int nfds, const char *state, size_t len);
+
+// Whether the new process has said it is ready, waiting up to timeout_ms:
+// 1 if it has, -1 if it closed sock without, 0 if not yet or a signal came
+// first. Leaves sock open.
+int handoff_poll(int sock, int timeout_ms);
+
+// Give up on the new process: close sock, kill it if still running, reap it
+void handoff_abandon(int sock, pid_t pid);
+
+// In the new process: the socket from the previous generation, or -1 when
+// started afresh. Clears the environment variable so scripts never see it.
+int handoff_inherited(void);
+
+// Take the descriptors (at most max, close-on-exec) and the state, which is
+// malloc'd for the caller to free. Returns the descriptor count or -1.
+int handoff_receive(int sock, int *fds, int max, char **state, size_t *len);
+
+// Tell the previous generation to stand down, and close sock
+void handoff_ready(int sock);
+
+#endif // HANDOFF_H
@@ -1,298 +1,2443 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <unistd.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/stat.h>
-#include <fcntl.h> 
-#include <sys/wait.h>
-#include <errno.h> 
+#include <sys/epoll.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <errno.h>
+#include <poll.h>
 #include "httpserve.h"
-#define BACKLOG 32 
 
 
 void logMsg(const char *msg); //log function
 char httpHead[2048];//buffer for http header
 
+static struct connection **conn_table;//connections indexed by client fd
+static int conn_table_size;
+
+static struct worker *workers;//one per event loop thread
+static int nworkers;
+static int stop_requested;//set by the main thread, polled by workers
+static int drain_requested;//the next generation took over; also polled by workers
+static unsigned snapshot_gen;//bumped by the main thread to ask workers for their hot paths
+static volatile sig_atomic_t handoff_signal;//blocking mode: SIGUSR2 not yet acted on
+static char **server_argv;//as started, for the next generation
+static int handoff_sock = -1;//to the previous generation until we are warm
+static int inherited[HANDOFF_MAX_FDS];//its listeners, taken by workers in order
+static int ninherited, next_inherited;
+static char *warm_state;//its hot paths, see hot_list
+static size_t warm_len;
+static pthread_barrier_t warmed;//workers and main thread, once every cache is warm
+static struct pack site_pack;//mapped snapshot of www/, base NULL when serving from disk
+static __thread struct worker *self;//worker running on this thread
+
+static long now_ms(void);
+static int coding_level(enum content_coding coding);
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-b] [-w workers] [-c config] [-o key=value] [port]\n"
+                    "signals:\n"
+                    "  SIGHUP           reopen the access log (for log rotation)\n"
+                    "  SIGUSR1          print per-worker statistics\n"
+                    "  SIGUSR2          reload: start %s again with these arguments on the same\n"
+                    "                   listeners, so it rereads the config and picks up a new\n"
+                    "                   binary, then drain this process once it is ready\n"
+                    "  SIGINT, SIGTERM  stop\n", prog, prog);
+}
+
 int main(int argc, char *argv[]) {
-    int port = SERVER_PORT;//getting port num
-    if (argc > 1) {
-        port = atoi(argv[1]); //changing port num
-        if (port <= 0) {
+    static struct server_config startup;
+    int opt;
+
+    config_defaults(&startup);
+    while ((opt = getopt(argc, argv, "bhw:c:o:")) != -1) {
+        char *eq;
+
+        switch (opt) {
+        case 'b':
+            startup.mode = SERVE_BLOCKING;//old one-at-a-time accept loop
+            break;
+        case 'w':
+            if (config_set(&startup, "workers", optarg) < 0) {
+                return 1;
+            }
+            break;
+        case 'c':
+            if (config_load(&startup, optarg) < 0) {
+                return 1;
+            }
+            break;
+        case 'o':
+            eq = strchr(optarg, '=');
+            if (eq == NULL) {
+                usage(argv[0]);
+                return 1;
+            }
+            *eq = '\0';
+            if (config_set(&startup, optarg, eq + 1) < 0) {
+                return 1;
+            }
+            *eq = '=';//argv is passed on as is to the next generation
+            break;
+        case 'h':
+            usage(argv[0]);
+            return 0;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind < argc) {
+        startup.port = atoi(argv[optind]); //changing port num
+        if (startup.port <= 0) {
             fprintf(stderr, "invalid port. Defaulting to set port %d\n", SERVER_PORT);
-            port = SERVER_PORT;  
+            startup.port = SERVER_PORT;
+        }
+    }
+    server_argv = argv;
+    cfg = &startup;
+    signal(SIGPIPE, SIG_IGN);//peers hanging up mid-write must not kill us
+    scan_init();//pick the parser's SIMD scanners for this CPU
+    if (cfg->mime_types[0] != '\0' && mime_load(cfg->mime_types) < 0) {
+        return 1;
+    }
+     logMsg("starting server...");//start log msg
+    start_server(cfg->port);
+    logMsg("server stopped.");//end log msg
+    return 0;
+}
+void logMsg(const char *msg) {//log function
+    printf("%s\n", msg);
+    fflush(stdout);//the access log thread writes to the same fd
+}
+
+static void conn_table_init(void) {
+    struct rlimit rl;
+
+    conn_table_size = 1024;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY) {
+        conn_table_size = (int)rl.rlim_cur;//one slot per possible fd
+    }
+    conn_table = calloc(conn_table_size, sizeof(*conn_table));
+    if (conn_table == NULL) {
+        perror("Error allocating connection table");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static int logging_enabled(void) {
+    return strcmp(cfg->access_log, "off") != 0;
+}
+
+// Per-worker breakdown so an uneven kernel spread is easy to spot
+static void print_worker_stats(void) {
+    unsigned long total_accepted = 0, total_served = 0;
+    char line[256];
+
+    for (int i = 0; i < nworkers; i++) {
+        total_accepted += COUNTER_READ(workers[i].accepted);
+        total_served += COUNTER_READ(workers[i].served);
+    }
+    for (int i = 0; i < nworkers; i++) {
+        unsigned long accepted = COUNTER_READ(workers[i].accepted);
+
+        snprintf(line, sizeof(line), "worker %d (cpu %d): accepted %lu (%.1f%%) served %lu",
+                 workers[i].id, workers[i].cpu, accepted,
+                 total_accepted ? 100.0 * accepted / total_accepted : 0.0,
+                 COUNTER_READ(workers[i].served));
+        logMsg(line);
+    }
+    snprintf(line, sizeof(line), "total: accepted %lu served %lu log dropped %lu",
+             total_accepted, total_served, accesslog_dropped());
+    logMsg(line);
+}
+
+// Empty memory pools for a worker; cgi.c sizes cgi_slab on first use
+static void worker_pools_init(struct worker *w) {
+    slab_init(&w->conn_slab, sizeof(struct connection), 0);
+    buf_pool_init(&w->bufs);
+    arena_init(&w->scratch, &w->bufs);
+}
+
+// The paths this worker's caches hold, one per line, for the next
+// generation to warm its own with: "f coding vary coded path" for a cached
+// file (coded: bit mask of the compressed copies made) and "d path" for an
+// open descriptor. A blank line ends the list. NULL if out of memory.
+static char *hot_list(const struct worker *w, size_t *len) {
+    const struct file_cache *fc = &w->cache;
+    const struct fd_cache *fds = &w->fds;
+    size_t cap = 1, n = 0;
+
+    for (size_t i = 0; i < fc->nentries; i++) {
+        cap += strlen(fc->ring[i]->path) + 32;
+    }
+    for (size_t i = 0; i < fds->nentries; i++) {
+        cap += strlen(fds->ring[i]->path) + 3;
+    }
+
+    char *list = malloc(cap);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < fds->nentries; i++) {
+        const struct fd_entry *e = fds->ring[i];
+
+        if (e->fd >= 0 && strchr(e->path, '\n') == NULL) {//a failed open is as quick to repeat
+            n += sprintf(list + n, "d %s\n", e->path);
+        }
+    }
+    for (size_t i = 0; i < fc->nentries; i++) {
+        const struct cache_entry *e = fc->ring[i];
+        unsigned coded = 0;
+
+        for (int k = 0; k < CODING_COUNT; k++) {
+            if (e->coded[k].data != NULL) {
+                coded |= 1u << k;
+            }
+        }
+        if (strchr(e->path, '\n') == NULL) {
+            n += sprintf(list + n, "f %d %d %u %s\n", e->rep.coding, e->rep.vary, coded, e->path);
+        }
+    }
+    list[n++] = '\n';
+    *len = n;
+    return list;
+}
+
+// Load a file the previous generation had cached the way serve_file would
+// have: a sidecar under its own path, with the type of the file it encodes
+static void warm_file(struct worker *w, const char *path, enum content_coding coding, int vary,
+                      unsigned coded, long now) {
+    char base[1100];
+    size_t len = strlen(path), suffix = coding != CODING_IDENTITY ? strlen(coding_suffix(coding)) : 0;
+
+    if (len >= sizeof(base) || suffix >= len) {
+        return;
+    }
+    memcpy(base, path, len - suffix);
+    base[len - suffix] = '\0';
+
+    const char *mime_type = get_mime_type(base);
+    struct fd_entry *file = mime_type != NULL ? fd_cache_open(&w->fds, path, now) : NULL;
+    if (file == NULL) {
+        return;
+    }
+    if (file->fd >= 0 && S_ISREG(file->st.st_mode)) {
+        struct file_rep rep;
+        struct cache_entry *e;
+
+        file_rep_init(&rep, &file->st, mime_type, coding, vary);
+        e = cache_insert(&w->cache, path, file->fd, &file->st, &rep, now);
+        if (e != NULL) {
+            for (int k = 0; k < CODING_COUNT; k++) {
+                if ((coded & (1u << k)) && k != CODING_IDENTITY) {
+                    cache_encode(&w->cache, e, k, coding_level(k));//compress now, not on the first hit
+                }
+            }
+            cache_release(e);
+        }
+    }
+    fd_cache_release(file);
+}
+
+// Fill a new worker's caches from the hot list of the worker whose
+// listener it took over, which saw the same share of the traffic
+static void worker_warm(struct worker *w) {
+    const char *p = warm_state, *end = warm_state + warm_len;
+    int nlists = 0;
+
+    if (site_pack.base != NULL) {
+        return;//served from the mapping, nothing to warm
+    }
+    for (const char *q = p; q < end; q++) {
+        nlists += *q == '\n' && (q == p || q[-1] == '\n');
+    }
+    for (int skip = nlists > 0 ? w->id % nlists : 0; skip > 0 && p < end; p++) {
+        skip -= *p == '\n' && (p == warm_state || p[-1] == '\n');
+    }
+
+    long now = now_ms();
+    while (nlists > 0 && p < end && *p != '\n') {
+        const char *eol = memchr(p, '\n', end - p);
+        char line[1200];
+        int coding, vary, off = 0;
+        unsigned coded;
+
+        if (eol == NULL || (size_t)(eol - p) >= sizeof(line)) {
+            break;
+        }
+        memcpy(line, p, eol - p);
+        line[eol - p] = '\0';
+        p = eol + 1;
+        if (line[0] == 'd' && line[1] == ' ') {
+            struct fd_entry *e = fd_cache_open(&w->fds, line + 2, now);
+
+            if (e != NULL) {
+                fd_cache_release(e);
+            }
+        } else if (sscanf(line, "f %d %d %u %n", &coding, &vary, &coded, &off) == 3 && off > 0 &&
+                   coding >= 0 && coding < CODING_COUNT) {
+            warm_file(w, line + off, coding, vary, coded, now);
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    self = arg;
+    if (handoff_sock >= 0) {//taking over: warm up before the previous generation stands down
+        worker_warm(self);
+        pthread_barrier_wait(&warmed);
+    }
+    run_event_loop(self);
+    __atomic_store_n(&self->stopped, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+// Pick up the listeners and hot paths a previous generation handed over, if
+// it started us. Listeners on another port than ours are let go; the old
+// process closes its copies as it drains.
+static void inherit_listeners(int port) {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+
+    handoff_sock = handoff_inherited();
+    if (handoff_sock < 0) {
+        return;
+    }
+    ninherited = handoff_receive(handoff_sock, inherited, HANDOFF_MAX_FDS, &warm_state, &warm_len);
+    if (ninherited < 0) {
+        exit(EXIT_FAILURE);//the running server carries on
+    }
+    if (ninherited > 0 && (getsockname(inherited[0], (struct sockaddr *)&addr, &len) < 0 ||
+                           ntohs(addr.sin_port) != port)) {
+        while (ninherited > 0) {
+            close(inherited[--ninherited]);
+        }
+    }
+}
+
+// A listener for the next worker: one handed over while they last, then new
+// ones joining the same SO_REUSEPORT group
+static int take_listener(int port) {
+    if (next_inherited < ninherited) {
+        int fd = inherited[next_inherited++];
+
+        listen(fd, cfg->listen_backlog);//a reload may have changed it
+        return fd;
+    }
+    return create_socket(port);
+}
+
+// Ask every worker for its hot paths and string them together in worker
+// order. Each answers on its next pass through its loop, within a second.
+static char *collect_hot_lists(size_t *len) {
+    unsigned gen = __atomic_add_fetch(&snapshot_gen, 1, __ATOMIC_RELEASE);
+    size_t total = 0;
+
+    if (cfg->mode == SERVE_BLOCKING) {
+        return hot_list(self, len);//the loop thread itself, between connections
+    }
+    for (int i = 0; i < nworkers; i++) {
+        while (__atomic_load_n(&workers[i].hot_gen, __ATOMIC_ACQUIRE) != gen &&
+               !__atomic_load_n(&workers[i].stopped, __ATOMIC_ACQUIRE)) {
+            struct timespec nap = { 0, 10 * 1000000 };
+
+            nanosleep(&nap, NULL);
+        }
+        total += workers[i].hot != NULL ? workers[i].hot_len : 1;
+    }
+
+    char *all = malloc(total);
+    *len = 0;
+    for (int i = 0; i < nworkers; i++) {
+        if (all != NULL && workers[i].hot != NULL) {
+            memcpy(all + *len, workers[i].hot, workers[i].hot_len);
+            *len += workers[i].hot_len;
+        } else if (all != NULL) {
+            all[(*len)++] = '\n';//nothing to warm this one with
+        }
+        free(workers[i].hot);//the worker touches it again only for the next gen
+        workers[i].hot = NULL;
+    }
+    return all;
+}
+
+// Start the next generation on our listeners (SIGUSR2): the binary we were
+// started as, whatever is there now, with our arguments, so it rereads the
+// config file. Returns its pid, with *sock to hear from it on, or -1 if it
+// could not be started and we carry on.
+static pid_t hand_over_start(int *sock) {
+    int fds[HANDOFF_MAX_FDS], nfds = 0;
+    size_t len = 0;
+    char line[128];
+
+    for (int i = 0; i < nworkers && nfds < HANDOFF_MAX_FDS; i++) {
+        if (workers[i].listen_fd >= 0) {
+            fds[nfds++] = workers[i].listen_fd;
+        }
+    }
+
+    char *state = collect_hot_lists(&len);
+    pid_t pid = handoff_spawn(server_argv[0], 1, server_argv, sock);
+    if (pid < 0) {
+        free(state);
+        return -1;
+    }
+    if (handoff_send(*sock, fds, nfds, state != NULL ? state : "", state != NULL ? len : 0) < 0) {
+        perror("handoff send");//it gets a short transfer and gives up
+    }
+    free(state);
+    snprintf(line, sizeof(line), "reload: started pid %d on %d listeners", (int)pid, nfds);
+    logMsg(line);
+    return pid;
+}
+
+// Settle a handover from hand_over_start, given handoff_poll's last answer
+// (0 if we stopped waiting). Returns 0 if the new process took over, -1 if
+// it was stopped and we carry on.
+static int hand_over_end(int sock, pid_t pid, int ready) {
+    if (ready > 0) {
+        close(sock);
+        logMsg("new process ready, draining");
+        return 0;
+    }
+    handoff_abandon(sock, pid);
+    logMsg(ready < 0 ? "new process failed, still serving" : "new process not ready, stopped it");
+    return -1;
+}
+
+// The whole handover, for blocking mode: its signal handlers run meanwhile,
+// and SIGTERM or SIGINT cuts the wait short
+static int hand_over(void) {
+    int sock, ready = 0;
+    pid_t pid = hand_over_start(&sock);
+    long start = now_ms();
+
+    if (pid < 0) {
+        return -1;
+    }
+    while (ready == 0 && !__atomic_load_n(&stop_requested, __ATOMIC_RELAXED) &&
+           now_ms() - start < HANDOFF_TIMEOUT_MS) {
+        ready = handoff_poll(sock, 1000);
+    }
+    return hand_over_end(sock, pid, ready);
+}
+
+static int workers_stopped(void) {
+    for (int i = 0; i < nworkers; i++) {
+        if (!__atomic_load_n(&workers[i].stopped, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Give every worker its own listener and thread, then park the main thread on
+// signals: SIGUSR1 prints the per-worker breakdown, SIGHUP reopens the access
+// log, SIGUSR2 hands over to a new process, SIGINT/SIGTERM stop the loops.
+// After a reload or upgrade the workers drain and we return once they are done.
+static void start_workers(int port) {
+    cpu_set_t allowed;
+    int cpus[CPU_SETSIZE], ncpus = 0;
+    sigset_t sigs;
+    int sig, draining = 0;
+    long drain_start = 0;
+
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int i = 0; i < CPU_SETSIZE; i++) {
+            if (CPU_ISSET(i, &allowed)) {
+                cpus[ncpus++] = i;
+            }
+        }
+    }
+
+    nworkers = cfg->workers > 0 ? cfg->workers : (ncpus > 0 ? ncpus : 1);
+    if (nworkers < ninherited) {//a listener nobody accepts on would reset what queues there
+        fprintf(stderr, "keeping %d workers, one per listener handed over; restart to run fewer\n", ninherited);
+        nworkers = ninherited;
+    }
+    workers = calloc(nworkers, sizeof(*workers));
+    if (workers == NULL) {
+        perror("Error allocating workers");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nworkers; i++) {
+        workers[i].id = i;
+        workers[i].cpu = (cfg->pin_workers && ncpus > 0) ? cpus[i % ncpus] : -1;
+        workers[i].listen_fd = take_listener(port);//SO_REUSEPORT lets each bind the same port
+        workers[i].epfd = -1;
+        cache_init(&workers[i].cache, cfg->cache_bytes / nworkers, cfg->cache_max_file, cfg->cache_valid_ms);
+        if (fd_cache_init(&workers[i].fds, cfg->fd_cache_entries / nworkers, cfg->cache_valid_ms) < 0) {
+            perror("Error allocating descriptor cache");
+            exit(EXIT_FAILURE);
+        }
+        worker_pools_init(&workers[i]);
+        if (logging_enabled() && access_ring_init(&workers[i].log, cfg->access_log_ring) < 0) {
+            perror("Error allocating access log ring");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    sigemptyset(&sigs);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGTERM);
+    sigaddset(&sigs, SIGUSR1);
+    sigaddset(&sigs, SIGHUP);
+    sigaddset(&sigs, SIGUSR2);
+    pthread_sigmask(SIG_BLOCK, &sigs, NULL);//workers inherit the mask
+    if (logging_enabled() && accesslog_start(cfg->access_log, cfg->access_log_format) < 0) {
+        exit(EXIT_FAILURE);
+    }
+    if (handoff_sock >= 0) {
+        pthread_barrier_init(&warmed, NULL, nworkers + 1);
+    }
+
+    for (int i = 0; i < nworkers; i++) {
+        pthread_attr_t attr;
+
+        pthread_attr_init(&attr);
+        if (workers[i].cpu >= 0) {
+            cpu_set_t one;
+
+            CPU_ZERO(&one);
+            CPU_SET(workers[i].cpu, &one);
+            pthread_attr_setaffinity_np(&attr, sizeof(one), &one);
+        }
+        if (pthread_create(&workers[i].thread, &attr, worker_main, &workers[i]) != 0) {
+            perror("Error starting worker");
+            exit(EXIT_FAILURE);
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    if (handoff_sock >= 0) {
+        pthread_barrier_wait(&warmed);//every worker's caches are filled
+        handoff_ready(handoff_sock);
+        handoff_sock = -1;
+        free(warm_state);
+        warm_state = NULL;
+    }
+
+    pid_t next_pid = -1;//the next generation, while it starts up
+    int next_sock = -1;
+    long next_start = 0;
+
+    for (;;) {
+        struct timespec tick = { 1, 0 };//to notice the drain finishing
+
+        if (next_pid >= 0) {
+            tick.tv_sec = 0;//and listen for the new process between signals
+            tick.tv_nsec = 50 * 1000000L;
+        }
+        sig = sigtimedwait(&sigs, NULL, &tick);
+        if (sig == SIGINT || sig == SIGTERM) {
+            break;
+        }
+        if (sig == SIGUSR1) {
+            print_worker_stats();
+        } else if (sig == SIGHUP) {
+            accesslog_reopen();//logrotate's HUP, never a reload
+        } else if (sig == SIGUSR2) {
+            if (!draining && next_pid < 0) {
+                next_pid = hand_over_start(&next_sock);
+                next_start = now_ms();
+            }
+        }
+        if (next_pid >= 0) {
+            int ready = handoff_poll(next_sock, 0);
+
+            if (ready != 0 || now_ms() - next_start >= HANDOFF_TIMEOUT_MS) {
+                if (hand_over_end(next_sock, next_pid, ready) == 0) {
+                    draining = 1;
+                    drain_start = now_ms();
+                    __atomic_store_n(&drain_requested, 1, __ATOMIC_RELAXED);
+                }
+                next_pid = -1;
+            }
+        }
+        if (draining && (workers_stopped() ||
+                         (cfg->drain_timeout > 0 && now_ms() - drain_start >= cfg->drain_timeout * 1000L))) {
+            break;
+        }
+    }
+    if (next_pid >= 0) {
+        hand_over_end(next_sock, next_pid, 0);//stopping before it was ready: it goes too
+    }
+
+    __atomic_store_n(&stop_requested, 1, __ATOMIC_RELAXED);
+    for (int i = 0; i < nworkers; i++) {
+        pthread_join(workers[i].thread, NULL);
+        if (workers[i].listen_fd >= 0) {
+            close(workers[i].listen_fd);
+        }
+    }
+    accesslog_stop();//after the workers, so their last records are written
+    print_worker_stats();
+}
+
+// Blocking mode has no signal thread; interrupt accept() so the pools get stopped
+static void stop_blocking(int sig) {
+    (void)sig;
+    __atomic_store_n(&stop_requested, 1, __ATOMIC_RELAXED);
+}
+
+static void reopen_blocking(int sig) {
+    (void)sig;
+    accesslog_reopen();
+}
+
+// SIGUSR2 interrupts accept() so handle_connections hands over between connections
+static void reload_blocking(int sig) {
+    handoff_signal = sig;
+}
+
+void start_server(int port) {//beginnninng of server
+    conn_table_init();
+    fcgi_init();
+    cgi_init();
+    if (path_init(DOCUMENT_ROOT) < 0) {
+        perror("Error opening " DOCUMENT_ROOT);
+        exit(EXIT_FAILURE);
+    }
+    if (cfg->pack[0] != '\0' && pack_open(&site_pack, cfg->pack) < 0) {
+        exit(EXIT_FAILURE);
+    }
+    if (admit_init(cfg->max_connections, cfg->max_connections_per_ip, cfg->request_rate_per_ip,
+                   cfg->request_burst_per_ip) < 0) {
+        perror("Error allocating the admission table");
+        exit(EXIT_FAILURE);
+    }
+    inherit_listeners(port);
+    if (cfg->mode == SERVE_BLOCKING) {
+        static struct worker only;
+
+        if (ninherited > 1) {
+            fprintf(stderr, "blocking mode accepts on one listener, not the %d handed over; restart instead\n",
+                    ninherited);
+            exit(EXIT_FAILURE);//the running server carries on
+        }
+        int server_sock = take_listener(port);//call to each function
+
+        only.listen_fd = server_sock;
+        only.cpu = -1;
+        only.epfd = -1;
+        cache_init(&only.cache, cfg->cache_bytes, cfg->cache_max_file, cfg->cache_valid_ms);
+        if (fd_cache_init(&only.fds, cfg->fd_cache_entries, cfg->cache_valid_ms) < 0) {
+            perror("Error allocating descriptor cache");
+            exit(EXIT_FAILURE);
+        }
+        worker_pools_init(&only);
+        self = &only;
+        workers = &only;//so /__metrics finds it
+        nworkers = 1;
+        if (handoff_sock >= 0) {
+            worker_warm(&only);
+            handoff_ready(handoff_sock);
+            handoff_sock = -1;
+            free(warm_state);
+        }
+        if (logging_enabled() && (access_ring_init(&only.log, cfg->access_log_ring) < 0 ||
+                                  accesslog_start(cfg->access_log, cfg->access_log_format) < 0)) {
+            exit(EXIT_FAILURE);
+        }
+
+        struct sigaction sa = {0};
+        sa.sa_handler = stop_blocking;//no SA_RESTART, so accept() returns EINTR
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+        sa.sa_handler = reload_blocking;//no SA_RESTART either
+        sigaction(SIGUSR2, &sa, NULL);
+        sa.sa_handler = reopen_blocking;
+        sa.sa_flags = SA_RESTART;
+        sigaction(SIGHUP, &sa, NULL);
+        handle_connections(server_sock);
+        close(server_sock);
+        accesslog_stop();
+        fcgi_shutdown();
+        return;
+    }
+    start_workers(port);
+    fcgi_shutdown();
+}
+
+int create_socket(int port) {
+    int sockfd = socket(AF_INET, SOCK_STREAM, 0);//intialize socket
+    if (sockfd < 0) {
+        perror("Error creating socket");//error msg check
+        exit(EXIT_FAILURE);
+    }
+
+    int one = 1;
+
+    setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));//rebind straight after a restart
+    if (setsockopt(sockfd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {//one listener per worker
+        perror("SO_REUSEPORT");
+    }
+
+    struct sockaddr_in server_adrs = {0};
+    server_adrs.sin_family = AF_INET;//setting up server address
+
+    server_adrs.sin_addr.s_addr = INADDR_ANY;//
+
+    server_adrs.sin_port = htons(port);
+
+    if (bind(sockfd, (struct sockaddr *)&server_adrs, sizeof(server_adrs)) < 0) {//binding socket
+        perror("Bind failed");
+        close(sockfd);
+        exit(EXIT_FAILURE);
+    }
+
+    if (listen(sockfd, cfg->listen_backlog) < 0) {//listening on socket; the kernel caps it at somaxconn
+        perror("Error listening on socket");//error msg check
+        close(sockfd);
+        exit(EXIT_FAILURE);
+    }
+
+    return sockfd;
+}
+
+struct connection *conn_get(int fd) {
+    if (fd < 0 || fd >= conn_table_size) {
+        return NULL;
+    }
+    return conn_table[fd];
+}
+
+static long now_ms(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+static long long now_us(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+// Turn an accepted socket away before reading any of it: a canned answer
+// costs no memory and no parsing, which is the point when overloaded. The
+// caller closes it.
+static void refuse_connection(int fd, enum admit_verdict v) {
+    static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\nRetry-After: 1\r\n"
+                               "Content-Length: 0\r\nConnection: close\r\n\r\n";
+    static const char limited[] = "HTTP/1.1 429 Too Many Requests\r\nRetry-After: 1\r\n"
+                                  "Content-Length: 0\r\nConnection: close\r\n\r\n";
+    char drain[512];
+
+    if (v == ADMIT_BUSY) {
+        send(fd, busy, sizeof(busy) - 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+        COUNTER_ADD(self->metrics.refused_busy, 1);
+    } else {
+        send(fd, limited, sizeof(limited) - 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+        COUNTER_ADD(self->metrics.refused_client, 1);
+    }
+    shutdown(fd, SHUT_WR);
+    while (recv(fd, drain, sizeof(drain), MSG_DONTWAIT) > 0) {
+        ;//unread request bytes would make close() reset the answer away
+    }
+}
+
+static void conn_timeout(struct timer *t);
+
+// (Re)arm the connection's one timer for seconds from now. Blocking mode runs
+// no wheel; its sockets carry SO_RCVTIMEO and SO_SNDTIMEO instead.
+static void conn_deadline(struct connection *c, int seconds) {
+    if (cfg->mode != SERVE_BLOCKING) {
+        timer_arm(&c->owner->timers, &c->timer, now_ms() + seconds * 1000L);
+    }
+}
+
+// Set up a connection for an accepted socket; peer is NULL if accept() did
+// not say who it is. NULL if it cannot be tracked, or admission control
+// turned it away (already answered); either way the caller closes fd.
+static struct connection *conn_open(int fd, const struct sockaddr_in *peer) {
+    struct sockaddr_in addr = {0};
+
+    if (fd >= conn_table_size) {//fd limit raised after startup
+        return NULL;
+    }
+    if (peer != NULL) {
+        addr = *peer;
+    } else {
+        socklen_t len = sizeof(addr);
+
+        if (getpeername(fd, (struct sockaddr *)&addr, &len) < 0 || addr.sin_family != AF_INET) {
+            memset(&addr, 0, sizeof(addr));
+        }
+    }
+
+    enum admit_verdict v = admit_connection(addr.sin_addr.s_addr);
+    if (v != ADMIT_OK) {
+        refuse_connection(fd, v);
+        return NULL;
+    }
+
+    struct connection *c = slab_alloc(&self->conn_slab);
+    if (c == NULL) {
+        admit_release(addr.sin_addr.s_addr);
+        return NULL;
+    }
+    memset(c, 0, sizeof(*c));
+    c->fd = fd;
+    c->log.begin_us = now_us();//the first request is timed from accept
+    c->peer = addr;
+    c->state = CONN_READING;
+    c->owner = self;
+    c->file_fd = -1;
+    c->splice_pipe[0] = c->splice_pipe[1] = -1;
+    http_parser_init(&c->req);
+    c->timer.fire = conn_timeout;
+    conn_deadline(c, cfg->header_timeout);//counted from accept, so trickling bytes does not extend it
+    COUNTER_ADD(self->nconns, 1);
+
+    conn_table[fd] = c;
+    return c;
+}
+
+// Copy src into a fixed-size access log field, truncating; returns the length kept
+static uint8_t log_copy(char *dst, size_t cap, const char *src, size_t len) {
+    if (len > cap) {
+        len = cap;
+    }
+    memcpy(dst, src, len);
+    return (uint8_t)len;
+}
+
+// Start the access log entry for the request at rbuf[0]. Everything it needs
+// is copied now, before a script's body or the next request reuses rbuf.
+// begin_us was set when the request's first byte arrived.
+static void request_begin(struct connection *c) {
+    const struct http_request *r = &c->req;
+    struct access_record *rec = &c->log;
+
+    clock_gettime(CLOCK_REALTIME, &rec->start);
+    rec->addr = c->peer.sin_addr.s_addr;
+    rec->port = ntohs(c->peer.sin_port);
+    rec->status = 0;
+    rec->bytes = 0;
+    rec->version_minor = r->version_minor;
+    rec->method_len = rec->target_len = rec->referer_len = rec->agent_len = 0;
+    if (!r->in_headers) {
+        return;//request line never parsed
+    }
+    rec->method_len = log_copy(rec->method, sizeof(rec->method), c->rbuf + r->method_name.off, r->method_name.len);
+    rec->target_len = log_copy(rec->target, sizeof(rec->target), c->rbuf + r->target.off, r->target.len);
+
+    const struct http_span *v = http_find_header(r, c->rbuf, "referer");
+    if (v != NULL) {
+        rec->referer_len = log_copy(rec->referer, sizeof(rec->referer), c->rbuf + v->off, v->len);
+    }
+    if ((v = http_find_header(r, c->rbuf, "user-agent")) != NULL) {
+        rec->agent_len = log_copy(rec->agent, sizeof(rec->agent), c->rbuf + v->off, v->len);
+    }
+}
+
+// Count the request that just ended and hand its access log entry to the
+// log thread; nothing to do if no request is pending
+static void request_finish(struct connection *c) {
+    struct access_record *rec = &c->log;
+
+    if (rec->start.tv_sec == 0) {
+        return;
+    }
+    long long total_us = now_us() - rec->begin_us;
+
+    rec->duration_us = total_us < UINT32_MAX ? (uint32_t)total_us : UINT32_MAX;
+    metrics_request(&c->owner->metrics, c->req.method, rec->status, rec->bytes, total_us);
+    access_ring_push(&c->owner->log, rec);
+    rec->start.tv_sec = 0;
+}
+
+void conn_sent(struct connection *c, size_t n) {
+    if (c->log.bytes == 0) {
+        histogram_record(&c->owner->metrics.first_byte, now_us() - c->log.begin_us);
+    }
+    c->log.bytes += n;
+}
+
+// Tags in the low bits of a ring operation's user_data; connections are
+// at least 8-byte aligned, so a tagged pointer never equals a bare tag
+#define IO_RX 1                 // connection pointer | IO_RX: c->rx
+#define IO_TX 2                 // connection pointer | IO_TX: c->tx
+#define IO_TAG 3
+#define UD_IGNORE 0             // cancellations, nothing to do on completion
+#define UD_ACCEPT(i) ((uint64_t)(i) << 3 | IO_RX) // the listener's accept i; nothing lives at those addresses
+#define UD_EPOLL IO_TX          // the worker's epoll set became readable
+
+// Take a parked completion, as the system call would have returned it
+static ssize_t io_result(struct conn_io *io) {
+    io->done = 0;
+    if (io->res < 0) {
+        errno = -io->res;
+        return -1;
+    }
+    return io->res;
+}
+
+// Submission slot for a connection's rx or tx, marked pending; NULL if the
+// ring is full, and the caller falls back to the plain system call
+static struct io_uring_sqe *conn_io_sqe(struct connection *c, int tag) {
+    struct io_uring_sqe *sqe = uring_get_sqe(c->owner->uring);
+
+    if (sqe != NULL) {
+        struct conn_io *io = tag == IO_RX ? &c->rx : &c->tx;
+
+        io->pending = 1;
+        io->poll = 0;
+        sqe->user_data = (uintptr_t)c | tag;
+    }
+    return sqe;
+}
+
+ssize_t conn_recv(struct connection *c, void *buf, size_t len) {
+    struct io_uring_sqe *sqe;
+
+    if (c->owner->uring == NULL) {
+        return read(c->fd, buf, len);
+    }
+    if (c->rx.done) {
+        return io_result(&c->rx);
+    }
+    if (!c->rx.pending) {
+        if ((sqe = conn_io_sqe(c, IO_RX)) == NULL) {
+            return read(c->fd, buf, len);
+        }
+        uring_prep_recv(sqe, c->fd, buf, len, sqe->user_data);
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+// Gather up to two buffers into one sendmsg(), with conn_send's semantics.
+// flags can add MSG_MORE when further response bytes follow right away.
+static ssize_t conn_writev(struct connection *c, const struct iovec *iov, int n, int flags) {
+    struct msghdr msg = { .msg_iov = (struct iovec *)iov, .msg_iovlen = n };
+    struct io_uring_sqe *sqe;
+
+    if (c->owner->uring == NULL) {
+        return sendmsg(c->fd, &msg, MSG_NOSIGNAL | flags);
+    }
+    if (c->tx.done) {
+        return io_result(&c->tx);
+    }
+    if (!c->tx.pending) {
+        if ((sqe = conn_io_sqe(c, IO_TX)) == NULL) {
+            return sendmsg(c->fd, &msg, MSG_NOSIGNAL | flags);
+        }
+        memcpy(c->tx_iov, iov, n * sizeof(*iov));
+        memset(&c->tx_msg, 0, sizeof(c->tx_msg));
+        c->tx_msg.msg_iov = c->tx_iov;
+        c->tx_msg.msg_iovlen = n;
+        uring_prep_sendmsg(sqe, c->fd, &c->tx_msg, MSG_NOSIGNAL | flags, sqe->user_data);
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+ssize_t conn_send(struct connection *c, const void *buf, size_t len) {
+    struct io_uring_sqe *sqe;
+
+    if (c->owner->uring == NULL) {
+        return send(c->fd, buf, len, MSG_NOSIGNAL);
+    }
+    if (c->tx.done) {
+        return io_result(&c->tx);
+    }
+    if (!c->tx.pending) {
+        if ((sqe = conn_io_sqe(c, IO_TX)) == NULL) {
+            return send(c->fd, buf, len, MSG_NOSIGNAL);
+        }
+        uring_prep_send(sqe, c->fd, buf, len, MSG_NOSIGNAL, sqe->user_data);
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+// Have the ring wake a connection whose socket calls went around it
+// (sendfile, splice) once the socket is ready again
+static void conn_poll(struct connection *c) {
+    struct conn_io *io;
+    unsigned events;
+    int tag;
+
+    if (c->state == CONN_READING) {
+        io = &c->rx, events = POLLIN | POLLRDHUP, tag = IO_RX;
+    } else if (c->state == CONN_WRITING_HEADER || c->state == CONN_WRITING_BODY) {
+        io = &c->tx, events = POLLOUT, tag = IO_TX;
+    } else {
+        return;//scripts and FastCGI answers resume the connection themselves
+    }
+    if (io->pending || io->done) {
+        return;
+    }
+
+    struct io_uring_sqe *sqe = conn_io_sqe(c, tag);
+    if (sqe != NULL) {
+        uring_prep_poll(sqe, c->fd, events, 0, sqe->user_data);
+        io->poll = 1;
+    }
+}
+
+// Withdraw a closed connection's ring operations
+static void conn_cancel(struct connection *c) {
+    for (int tag = IO_RX; tag <= IO_TX; tag++) {
+        struct io_uring_sqe *sqe;
+
+        if ((tag == IO_RX ? c->rx.pending : c->tx.pending) &&
+            (sqe = uring_get_sqe(c->owner->uring)) != NULL) {
+            uring_prep_cancel(sqe, (uintptr_t)c | tag, UD_IGNORE);
+        }
+    }
+}
+
+// Let go of whatever the last response was sending from
+static void conn_clear_response(struct connection *c) {
+    if (c->entry != NULL) {
+        cache_release(c->entry);//body pointed into the cache
+        c->entry = NULL;
+    } else if (c->body_cap > 0) {
+        buf_put(&c->owner->bufs, c->body, c->body_cap);
+    }
+    c->body = NULL;//or it pointed into the pack, which stays mapped
+    c->body_cap = c->body_len = c->body_off = 0;
+    c->head_len = c->head_off = 0;
+    c->nranges = c->range_next = 0;
+    if (c->file_entry != NULL) {
+        fd_cache_release(c->file_entry);//shared with later requests for the same file
+        c->file_entry = NULL;
+        c->file_fd = -1;
+    } else if (c->file_fd >= 0) {
+        if (site_pack.base == NULL || c->file_fd != site_pack.fd) {//the pack stays open for everyone
+            close(c->file_fd);
+        }
+        c->file_fd = -1;
+    }
+    c->file_base = 0;
+}
+
+// Release what a closed connection still holds
+static void conn_free(struct connection *c) {
+    conn_clear_response(c);
+    if (c->splice_pipe[0] >= 0) {
+        close(c->splice_pipe[0]);
+        close(c->splice_pipe[1]);
+    }
+    buf_put(&c->owner->bufs, c->rbuf, BUFFER_SIZE);
+    slab_free(&c->owner->conn_slab, c);
+}
+
+static void conn_close(struct connection *c) {
+    struct worker *w = c->owner;
+
+    timer_cancel(&w->timers, &c->timer);
+    COUNTER_ADD(w->nconns, -1);
+
+    request_finish(c);//response cut short, still worth a line
+    if (c->cgi != NULL) {
+        cgi_abort(c);
+    }
+    conn_table[c->fd] = NULL;
+    close(c->fd);//closing also drops it from the epoll set
+    admit_release(c->peer.sin_addr.s_addr);
+    if (c->rx.pending || c->tx.pending) {//the ring may still write into c or send from its response
+        conn_cancel(c);
+        c->closing = 1;
+        return;
+    }
+    conn_free(c);
+}
+
+// The connection's deadline passed. A request head that is still incomplete
+// or an idle keep-alive connection is closed; a response is closed only if
+// not a byte of it went out since the deadline was armed.
+static void conn_timeout(struct timer *t) {
+    struct connection *c = (struct connection *)((char *)t - offsetof(struct connection, timer));
+
+    if (c->state == CONN_WRITING_HEADER || c->state == CONN_WRITING_BODY) {
+        if (c->log.bytes != c->sent_mark) {//slow but moving
+            c->sent_mark = c->log.bytes;
+            conn_deadline(c, cfg->send_timeout);
+            return;
+        }
+    } else if (c->state == CONN_CGI || c->state == CONN_WAITING) {
+        conn_deadline(c, cfg->send_timeout);//cgi_timeout and fcgi_timeout govern the script
+        return;
+    }
+    conn_close(c);
+}
+
+// Drop the request just answered and clear the response so the next
+// (possibly already buffered) request can be parsed
+static void conn_reset(struct connection *c) {
+    memmove(c->rbuf, c->rbuf + c->req_len, c->rlen - c->req_len);
+    c->rlen -= c->req_len;
+    c->rbuf[c->rlen] = '\0';
+    http_parser_init(&c->req);
+    c->req_len = 0;
+    c->log.begin_us = c->rlen > 0 ? now_us() : 0;//pipelined requests are already here
+
+    conn_clear_response(c);
+
+    c->state = CONN_READING;
+    conn_deadline(c, c->rlen > 0 ? cfg->header_timeout : cfg->keepalive_timeout);
+}
+
+// Feed newly read bytes to the parser. Once the head is complete, note how
+// long the whole request is, body included. A malformed or oversized head also
+// counts as complete so dispatch_request can answer it.
+static int request_complete(struct connection *c) {
+    if (c->req.head_len == 0) {
+        struct http_limits lim = {
+            cfg->max_header_bytes < BUFFER_SIZE - 1 ? cfg->max_header_bytes : BUFFER_SIZE - 1,
+            cfg->max_uri,
+            cfg->max_headers,
+        };
+
+        c->parse_status = http_parse(&c->req, c->rbuf, c->rlen, &lim);
+        if (c->parse_status == PARSE_INCOMPLETE) {
+            return 0;
+        }
+        if (c->parse_status != PARSE_DONE) {
+            c->framing_lost = 1;
+            c->req_len = c->rlen;
+            return 1;
+        }
+
+        long long body = c->req.content_length > 0 ? c->req.content_length : 0;
+        if (body > (long long)BUFFER_SIZE || c->req.head_len + body > BUFFER_SIZE - 1 || c->req.chunked) {
+            c->req_len = c->rlen;//body cannot be framed here, so no further
+            c->framing_lost = 1;//requests can be trusted on this connection
+        } else {
+            c->req_len = c->req.head_len + body;
+        }
+    }
+    return c->rlen >= c->req_len;
+}
+
+// Read until a full request is buffered.
+// Returns 1 when complete, 0 when the socket ran dry first and -1 when the
+// peer went away or the head does not fit in the buffer.
+static int conn_read(struct connection *c) {
+    size_t cap;
+
+    if (c->rbuf == NULL) {
+        if ((c->rbuf = buf_get(&c->owner->bufs, BUFFER_SIZE, &cap)) == NULL) {
+            return -1;
+        }
+        c->rbuf[0] = '\0';
+    }
+    while (!request_complete(c)) {
+        if (c->rlen == BUFFER_SIZE - 1) {
+            return -1;
+        }
+
+        ssize_t n = conn_recv(c, c->rbuf + c->rlen, BUFFER_SIZE - 1 - c->rlen);
+        if (n > 0) {
+            c->rlen += n;
+            c->rbuf[c->rlen] = '\0';//null terminate for string tokenization
+            if (c->log.begin_us == 0) {
+                c->log.begin_us = now_us();//first byte of the next request
+                conn_deadline(c, cfg->header_timeout);//idle time is over, the head must now arrive
+            } else if (cfg->mode == SERVE_BLOCKING &&
+                       now_us() - c->log.begin_us > cfg->header_timeout * 1000000LL) {
+                return -1;//no wheel here: SO_RCVTIMEO only bounds each read, this bounds the head
+            }
+        } else if (n == 0) {
+            return -1;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            if (c->rlen == 0 && c->owner->uring == NULL) {//idle: hand the buffer back until data arrives
+                buf_put(&c->owner->bufs, c->rbuf, BUFFER_SIZE);//(a pending ring recv still needs it)
+                c->rbuf = NULL;
+            }
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+    return 1;
+}
+
+// Whether a multipart body still has part heads or its closing boundary to queue
+static int more_parts(const struct connection *c) {
+    return c->nranges >= 2 && c->range_next <= c->nranges;
+}
+
+// MSG_MORE while bytes that are not in the current gather list are about to
+// follow (a file or further parts), so that a small head goes out in the same
+// segment as the start of the file instead of a packet of its own. The last
+// write of every response goes without it, which pushes out what is queued.
+static int more_flag(const struct connection *c) {
+    return (c->file_fd >= 0 && c->file_off < c->file_end) || more_parts(c) ? MSG_MORE : 0;
+}
+
+// Move file bytes to the socket through a pipe with splice(), for files whose
+// filesystem has no sendfile support. Same return convention as conn_flush.
+static int conn_splice_file(struct connection *c) {
+    if (c->splice_pipe[0] < 0 && pipe2(c->splice_pipe, O_NONBLOCK | O_CLOEXEC) < 0) {
+        return -1;
+    }
+
+    while (c->file_off < c->file_end || c->pipe_pending > 0) {
+        if (c->pipe_pending == 0) {
+            ssize_t in = splice(c->file_fd, &c->file_off, c->splice_pipe[1], NULL,
+                                c->file_end - c->file_off, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            if (in <= 0) {
+                if (in < 0 && errno == EINTR) {
+                    continue;
+                }
+                return -1;//file shrank or cannot be spliced either
+            }
+            c->pipe_pending = in;
+        }
+
+        unsigned more = c->file_off < c->file_end || more_parts(c) ? SPLICE_F_MORE : 0;
+        ssize_t out = splice(c->splice_pipe[0], NULL, c->fd, NULL, c->pipe_pending,
+                             SPLICE_F_MOVE | SPLICE_F_NONBLOCK | more);
+        if (out < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        c->pipe_pending -= out;
+        conn_sent(c, out);
+    }
+    return 1;
+}
+
+// Send the file part of the body straight from the page cache.
+// Same return convention as conn_flush.
+static int conn_send_file(struct connection *c) {
+    while (c->file_off < c->file_end) {
+        if (c->splice_pipe[0] >= 0) {
+            return conn_splice_file(c);
+        }
+
+        ssize_t n = sendfile(c->fd, c->file_fd, &c->file_off, c->file_end - c->file_off);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return 0;
+            }
+            if (errno == EINVAL || errno == ENOSYS) {
+                return conn_splice_file(c);
+            }
+            return -1;
+        }
+        if (n == 0) {
+            return -1;//file shrank under us, Content-Length can no longer be met
+        }
+        conn_sent(c, n);
+    }
+    return c->pipe_pending > 0 ? conn_splice_file(c) : 1;
+}
+
+// Separator and headers in front of part i of a multipart/byteranges body
+static int format_part_head(const struct connection *c, char *buf, size_t len, int i) {
+    return snprintf(buf, len, "%s--%016lx\r\nContent-Type: %s\r\nContent-Range: bytes %lld-%lld/%lld\r\n\r\n",
+                    i > 0 ? "\r\n" : "", c->boundary, c->range_type,
+                    c->ranges[i].first, c->ranges[i].last, c->range_size);
+}
+
+static int format_closing_boundary(const struct connection *c, char *buf, size_t len) {
+    return snprintf(buf, len, "\r\n--%016lx--\r\n", c->boundary);
+}
+
+// Point the body at range i, in the cached copy or in the open file
+static void set_range_window(struct connection *c, int i) {
+    if (c->file_fd >= 0) {
+        c->file_off = c->file_base + c->ranges[i].first;
+        c->file_end = c->file_base + c->ranges[i].last + 1;
+    } else {
+        c->body_off = c->ranges[i].first;
+        c->body_len = c->ranges[i].last + 1;
+    }
+}
+
+// Once a part of a multipart body is out, queue the next one (or the closing
+// boundary) through the head buffer. Returns 0 when nothing is left.
+static int queue_next_part(struct connection *c) {
+    if (c->nranges < 2 || c->range_next > c->nranges) {
+        return 0;
+    }
+    if (c->range_next == c->nranges) {
+        c->head_len = format_closing_boundary(c, c->head, sizeof(c->head));
+        c->body_off = c->body_len;
+        c->file_off = c->file_end;
+    } else {
+        c->head_len = format_part_head(c, c->head, sizeof(c->head), c->range_next);
+        set_range_window(c, c->range_next);
+    }
+    c->range_next++;
+    c->head_off = 0;
+    c->state = CONN_WRITING_HEADER;
+    return 1;
+}
+
+// Push queued head and body bytes, picking up where the last short write stopped.
+// Returns 1 once the response is out, 0 when the socket is full and -1 on error.
+static int conn_flush(struct connection *c) {
+    if (c->file_fd >= 0 && more_parts(c) && !c->corked) {//sendfile pushes each part; hold them until the closing boundary
+        int one = 1;
+        c->corked = setsockopt(c->fd, IPPROTO_TCP, TCP_CORK, &one, sizeof(one)) == 0;
+    }
+    do {
+        while (c->state == CONN_WRITING_HEADER) {
+            if (c->head_off == c->head_len) {
+                c->state = CONN_WRITING_BODY;
+                break;
+            }
+
+            struct iovec iov[2] = {//head and an in-memory body leave in one writev
+                { c->head + c->head_off, c->head_len - c->head_off },
+                { c->body + c->body_off, c->body_len - c->body_off },
+            };
+            ssize_t n = conn_writev(c, iov, c->body_len > c->body_off ? 2 : 1, more_flag(c));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+            }
+            conn_sent(c, n);
+            if ((size_t)n > iov[0].iov_len) {
+                c->body_off += n - iov[0].iov_len;
+                n = iov[0].iov_len;
+            }
+            c->head_off += n;
         }
+
+        while (c->state == CONN_WRITING_BODY) {
+            if (c->body_off == c->body_len) {
+                if (c->file_fd >= 0) {
+                    int r = conn_send_file(c);
+                    if (r <= 0) {
+                        return r;
+                    }
+                }
+                c->state = CONN_DONE;
+                break;
+            }
+
+            struct iovec iov = { c->body + c->body_off, c->body_len - c->body_off };
+            ssize_t n = conn_writev(c, &iov, 1, more_flag(c));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+            }
+            c->body_off += n;
+            conn_sent(c, n);
+        }
+    } while (queue_next_part(c));
+    if (c->corked) {
+        int zero = 0;
+        setsockopt(c->fd, IPPROTO_TCP, TCP_CORK, &zero, sizeof(zero));
+        c->corked = 0;
+    }
+    return 1;
+}
+
+// Serialize the status line and standard headers into the connection's head buffer
+static void queue_head(struct connection *c, const char *status, const char *content_type, long long content_length) {
+    const char *connection = c->keep_alive ? "keep-alive" : "close";
+    int headLength;
+    if (content_type != NULL) {
+        headLength = snprintf(c->head, sizeof(c->head),//printing out header
+                              "%s\r\n"
+                              "Content-Type: %s\r\n"
+                              "Content-Length: %lld\r\n"
+                              "Connection: %s\r\n"
+                              "\r\n",
+                              status, content_type, content_length, connection);
+    } else {
+        headLength = snprintf(c->head, sizeof(c->head),
+                              "%s\r\n"
+                              "Content-Length: %lld\r\n"
+                              "Connection: %s\r\n"
+                              "\r\n",
+                              status, content_length, connection);
+    }
+    c->head_len = headLength < (int)sizeof(c->head) ? (size_t)headLength : sizeof(c->head) - 1;
+    c->head_off = 0;
+    c->log.status = atoi(status + 9);//past "HTTP/1.1 "
+    c->state = CONN_WRITING_HEADER;
+}
+
+// Queue a 200 head for a file: the precomputed file headers plus this
+// connection's Connection header
+static void queue_file_head(struct connection *c, const char *file_head, size_t len) {
+    int n = snprintf(c->head + len, sizeof(c->head) - len, "Connection: %s\r\n\r\n",
+                     c->keep_alive ? "keep-alive" : "close");
+
+    if (file_head != c->head) {
+        memcpy(c->head, file_head, len);
+    }
+    c->head_len = len + n;
+    c->head_off = 0;
+    c->log.status = atoi(c->head + 9);
+    c->state = CONN_WRITING_HEADER;
+}
+
+// Does an If-None-Match list name this entity tag? The comparison is the weak
+// one RFC 9110 asks for here, so a W/ prefix on the client's copy is ignored.
+static int etag_listed(const char *list, size_t len, const char *etag) {
+    size_t etag_len = strlen(etag);
+    const char *p = list;
+    const char *end = list + len;
+
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) {
+            p++;
+        }
+        if (p < end && *p == '*') {
+            return 1;//any current version
+        }
+        if (end - p >= 2 && p[0] == 'W' && p[1] == '/') {
+            p += 2;
+        }
+        if (p < end && *p == '"') {
+            const char *close = memchr(p + 1, '"', end - p - 1);
+
+            if (close == NULL) {
+                return 0;
+            }
+            if ((size_t)(close + 1 - p) == etag_len && memcmp(p, etag, etag_len) == 0) {
+                return 1;
+            }
+            p = close + 1;
+        }
+        while (p < end && *p != ',') {
+            p++;
+        }
+    }
+    return 0;
+}
+
+// Parse an IMF-fixdate header value; anything else is rejected
+static int parse_http_date(const char *buf, const struct http_span *v, time_t *t) {
+    char date[64];
+    struct tm tm;
+
+    if (v->len >= sizeof(date)) {
+        return -1;
+    }
+    memcpy(date, buf + v->off, v->len);
+    date[v->len] = '\0';
+    memset(&tm, 0, sizeof(tm));
+
+    const char *rest = strptime(date, "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    if (rest == NULL || *rest != '\0') {
+        return -1;
     }
-     logMsg("starting server...");//start log msg
-    start_server(port);
-    logMsg("server stopped.");//end log msg
+    *t = timegm(&tm);
     return 0;
 }
-void logMsg(const char *msg) {//log function
-    printf("%s\n", msg);
+
+// Would a 304 do for this version of the file? If-None-Match takes precedence
+// and If-Modified-Since is only consulted without it (RFC 9110 section 13.2.2).
+static int not_modified(const struct connection *c, const struct file_rep *rep) {
+    const struct http_span *v = http_find_header(&c->req, c->rbuf, "if-none-match");
+
+    if (v != NULL) {
+        char etag[80];
+
+        format_etag(etag, sizeof(etag), rep);
+        return etag_listed(c->rbuf + v->off, v->len, etag);
+    }
+
+    time_t since;
+
+    v = http_find_header(&c->req, c->rbuf, "if-modified-since");
+    if (v != NULL && parse_http_date(c->rbuf, v, &since) == 0) {
+        return rep->mtime.tv_sec <= since;
+    }
+    return 0;
 }
-void start_server(int port) {//beginnninng of server
-    int server_sock = create_socket(port);//call to each function
-    handle_connections(server_sock);
-    close(server_sock);
+
+// Is the representation an If-Range names still the current one? Entity tags
+// must match strongly; a date must be exactly the Last-Modified we send.
+static int if_range_matches(const struct connection *c, const struct http_span *v, const struct file_rep *rep) {
+    char etag[80];
+    time_t date;
+
+    if (v->len > 0 && c->rbuf[v->off] == '"') {
+        int n = format_etag(etag, sizeof(etag), rep);
+        return v->len == (uint32_t)n && memcmp(c->rbuf + v->off, etag, n) == 0;
+    }
+    return parse_http_date(c->rbuf, v, &date) == 0 && date == rep->mtime.tv_sec;//W/ tags land here and fail
 }
 
-int create_socket(int port) {
-    int sockfd = socket(AF_INET, SOCK_STREAM, 0);//intialize socket
-    if (sockfd < 0) {
-        perror("Error creating socket");//error msg check
-        exit(EXIT_FAILURE);
+// Decide which of the length bytes of a representation a GET asked for. Stores
+// them in c->ranges and returns how many, 0 if none can be satisfied, or -1 to
+// send all of it.
+static int wanted_ranges(struct connection *c, const struct file_rep *rep, long long length) {
+    const struct http_span *range = http_find_header(&c->req, c->rbuf, "range");
+
+    if (range == NULL || c->req.method != HTTP_GET) {
+        return -1;
     }
+    const struct http_span *if_range = http_find_header(&c->req, c->rbuf, "if-range");
+    if (if_range != NULL && !if_range_matches(c, if_range, rep)) {
+        return -1;//changed since the client's partial copy, start over
+    }
+    return http_parse_range(c->rbuf, range, length, c->ranges, MAX_RANGES);
+}
 
-    struct sockaddr_in server_adrs = {0};
-    server_adrs.sin_family = AF_INET;//setting up server address
+// Queue the 200, 206 or 416 for the length bytes of rep already attached to the
+// connection (c->body or c->file_fd). head is the ready-made 200 head.
+static void queue_file_response(struct connection *c, const char *head, size_t head_len,
+                                const struct file_rep *rep, long long length) {
+    int n = wanted_ranges(c, rep, length);
 
-    server_adrs.sin_addr.s_addr = INADDR_ANY;//
+    if (n < 0) {
+        queue_file_head(c, head, head_len);
+        return;
+    }
+    if (n == 0) {
+        conn_clear_response(c);
+        int len = snprintf(c->head, sizeof(c->head),
+                           "HTTP/1.1 416 Range Not Satisfiable\r\n"
+                           "Content-Range: bytes */%lld\r\n"
+                           "Content-Length: 0\r\n", length);
+        queue_file_head(c, c->head, len);
+        return;
+    }
 
-    server_adrs.sin_port = htons(port);
+    c->nranges = n;
+    c->range_next = 1;
+    c->range_type = rep->mime_type;
+    c->range_size = length;
+
+    int len;
+    if (n == 1) {
+        len = snprintf(c->head, sizeof(c->head),
+                       "HTTP/1.1 206 Partial Content\r\n"
+                       "Content-Type: %s\r\n"
+                       "Content-Length: %lld\r\n"
+                       "Content-Range: bytes %lld-%lld/%lld\r\n",
+                       rep->mime_type, c->ranges[0].last - c->ranges[0].first + 1,
+                       c->ranges[0].first, c->ranges[0].last, length);
+    } else {
+        c->boundary = ((unsigned long)now_ms() << 20 ^ (unsigned long)c->fd) * 0x9e3779b97f4a7c15UL;
 
-    if (bind(sockfd, (struct sockaddr *)&server_adrs, sizeof(server_adrs)) < 0) {//binding socket
-        perror("Bind failed");
-        close(sockfd);
-        exit(EXIT_FAILURE);
+        long long body = format_closing_boundary(c, NULL, 0);
+        for (int i = 0; i < n; i++) {
+            body += format_part_head(c, NULL, 0, i) + c->ranges[i].last - c->ranges[i].first + 1;
+        }
+        len = snprintf(c->head, sizeof(c->head),
+                       "HTTP/1.1 206 Partial Content\r\n"
+                       "Content-Type: multipart/byteranges; boundary=%016lx\r\n"
+                       "Content-Length: %lld\r\n",
+                       c->boundary, body);
     }
+    len += format_validators(c->head + len, sizeof(c->head) - len, rep);
+    queue_file_head(c, c->head, len);
+    if (n > 1) {//first part's separator rides along with the head
+        c->head_len += format_part_head(c, c->head + c->head_len, sizeof(c->head) - c->head_len, 0);
+    }
+    set_range_window(c, 0);
+}
 
-    if (listen(sockfd, BACKLOG) < 0) {//listening on socket
-        perror("Error listening on socket");//error msg check
-        close(sockfd);
-        exit(EXIT_FAILURE);
+// Cheap test so requests without validators skip the extra stat
+static int is_conditional(const struct connection *c) {
+    return http_find_header(&c->req, c->rbuf, "if-none-match") != NULL ||
+           http_find_header(&c->req, c->rbuf, "if-modified-since") != NULL;
+}
+
+// Queue a header-only 304 carrying the validators of the current version
+static void queue_not_modified(struct connection *c, const struct file_rep *rep) {
+    int n = snprintf(c->head, sizeof(c->head), "HTTP/1.1 304 Not Modified\r\n");
+
+    n += format_validators(c->head + n, sizeof(c->head) - n, rep);
+    queue_file_head(c, c->head, n);
+}
+
+// Decide whether the connection outlives this request: HTTP/1.1 defaults to
+// keep-alive, HTTP/1.0 to close, and the Connection header overrides both.
+// Limits on requests per connection and on open sockets always win.
+static int want_keep_alive(const struct connection *c) {
+    int keep = c->req.version_minor >= 1;
+
+    if (c->req.conn_close) {
+        keep = 0;
+    } else if (c->req.conn_keep_alive) {
+        keep = 1;
     }
 
-    return sockfd;
+    if (cfg->mode == SERVE_BLOCKING || cfg->keepalive_timeout == 0 || c->framing_lost) {
+        return 0;//an idle client would stall the one-at-a-time loop
+    }
+    if (c->req.chunked && c->req.content_length >= 0) {
+        return 0;//both framings given: whoever read it by Content-Length is out of step (RFC 9112 6.1)
+    }
+    if (c->requests + 1 >= (unsigned)cfg->keepalive_requests) {
+        return 0;
+    }
+    if (c->owner->nconns > conn_table_size / 4 * 3 / nworkers) {
+        return 0;//running low on fds, shed idle sockets first
+    }
+    if (c->owner->draining) {
+        return 0;//the next generation takes the client's next connection
+    }
+    return keep;
 }
 
-void handle_connections(int server_sock) {
+// Answer a scrape of METRICS_PATH with every worker's counters summed
+static void serve_metrics(struct connection *c) {
+    const struct metrics *each[nworkers];
+    struct metrics_gauges g = {0};
+    char *text = NULL;
+    size_t len = 0;
+    FILE *f = open_memstream(&text, &len);
 
-    struct sockaddr_in client_addr;//structure for client
+    if (f == NULL) {
+        send_response(c->fd, "HTTP/1.1 500 Internal Server Error", NULL, NULL, 0);
+        return;
+    }
+    for (int i = 0; i < nworkers; i++) {
+        each[i] = &workers[i].metrics;
+        g.connections += COUNTER_READ(workers[i].nconns);
+        g.accepted += COUNTER_READ(workers[i].accepted);
+        g.cache_hits += COUNTER_READ(workers[i].cache.hits);
+        g.cache_misses += COUNTER_READ(workers[i].cache.misses);
+        g.fd_cache_hits += COUNTER_READ(workers[i].fds.hits);
+        g.fd_cache_misses += COUNTER_READ(workers[i].fds.misses);
+        g.pool_bytes += slab_bytes(&workers[i].conn_slab) + slab_bytes(&workers[i].cgi_slab) +
+                        buf_pool_bytes(&workers[i].bufs);
+    }
+    g.log_dropped = accesslog_dropped();
+    metrics_render(f, each, nworkers, &g);
+    fclose(f);
+
+    queue_head(c, "HTTP/1.1 200 OK", "text/plain; version=0.0.4; charset=utf-8", len);
+    if (c->req.method != HTTP_HEAD && (c->body = buf_get(&c->owner->bufs, len, &c->body_cap)) != NULL) {
+        memcpy(c->body, text, len);
+        c->body_len = len;
+    }
+    free(text);//scrapes are rare enough for stdio to allocate
+}
 
-    socklen_t client_addrlen = sizeof(client_addr);//settingn size
+// Queue an empty error response telling the client when to come back
+static void queue_retry_after(struct connection *c, const char *status, int seconds) {
+    int n = snprintf(c->head, sizeof(c->head), "%s\r\nRetry-After: %d\r\nContent-Length: 0\r\n",
+                     status, seconds);
 
-    int client_sock;
+    queue_file_head(c, c->head, n);
+}
+
+// Parse the buffered request line and hand it to the matching handler,
+// which queues its response on the connection
+static void dispatch_request(struct connection *c) {
+    const struct http_request *r = &c->req;
+    int retry_after;
+
+    c->state = CONN_WRITING_HEADER;
+    c->sent_mark = c->log.bytes;
+    conn_deadline(c, cfg->send_timeout);
+    request_begin(c);
+    if (c->parse_status != PARSE_DONE) {//malformed or over a limit, answer and hang up
+        c->keep_alive = 0;
+        if (c->parse_status == PARSE_URI_TOO_LONG) {
+            send_response(c->fd, "HTTP/1.1 414 URI Too Long", NULL, NULL, 0);
+        } else if (c->parse_status == PARSE_HEAD_TOO_BIG) {
+            send_response(c->fd, "HTTP/1.1 431 Request Header Fields Too Large", NULL, NULL, 0);
+        } else if (c->parse_status == PARSE_NOT_IMPLEMENTED) {
+            send_response(c->fd, "HTTP/1.1 501 Not Implemented", NULL, NULL, 0);
+        } else {
+            send_response(c->fd, "HTTP/1.1 400 Bad Request", NULL, NULL, 0);
+        }
+        return;
+    }
 
-    while ((client_sock = accept(server_sock, (struct sockaddr *)&client_addr, &client_addrlen)) >= 0) {//accepting connection
+    char *path = c->rbuf + r->target.off;
+    path[r->target.len] = '\0';//the space after the target, so path is a C string in place
 
-          logMsg("New connection accepted");//logging
-        process_request(client_sock);
+    int cgi = cgi_script(path);
+    if (cgi) {
+        c->framing_lost = 0;//the script is fed the body however long or chunked, so framing holds
+    }
+    c->keep_alive = want_keep_alive(c);
+    c->requests++;
+    COUNTER_ADD(c->owner->served, 1);
+    if (admit_request(c->peer.sin_addr.s_addr, c->log.begin_us, &retry_after) != ADMIT_OK) {
+        c->keep_alive = 0;//a client this far over its rate gets no pipeline to hammer
+        queue_retry_after(c, "HTTP/1.1 429 Too Many Requests", retry_after);
+        return;
+    }
+    if (strcmp(path, METRICS_PATH) == 0 && (r->method == HTTP_GET || r->method == HTTP_HEAD)) {
+        serve_metrics(c);
+        return;
+    }
+    if (fcgi_script(path)) {//any method, the application decides
+        fcgi_submit(c, path);
+        return;
+    }
+    if (cgi) {
+        cgi_start(c, path);
+        return;
+    }
+    switch (r->method) {//checking for method and calling its function
+    case HTTP_GET:
+        handle_get_request(c->fd, path);
+        break;
+    case HTTP_HEAD:
+        handle_head_request(c->fd, path);
+        break;
+    case HTTP_POST:
+        handle_post_request(c->fd, path);
+        break;
+    default:
+        send_response(c->fd, "HTTP/1.1 501 Not a method", NULL, NULL, 0);//just incase of wrong methof
+        break;
     }
+}
+
+// Advance a connection as far as its socket allows, answering pipelined
+// requests one after another so responses leave in request order.
+// Returns 0 while it waits for more readiness and -1 once it has been closed.
+static int conn_process(struct connection *c) {
+    for (;;) {
+        if (c->state == CONN_READING) {
+            int r = conn_read(c);
+            if (r == 0) {
+                return 0;
+            }
+            if (r < 0) {
+                conn_close(c);
+                return -1;
+            }
+            dispatch_request(c);
+        }
 
-    if (client_sock < 0) {
+        if (c->state == CONN_CGI) {
+            int r = cgi_drive(c);
+            if (r == 0) {
+                return 0;//waiting on the client or the script
+            }
+            if (r < 0) {
+                conn_close(c);
+                return -1;
+            }
+        }
 
-        perror("error accepting");
+        if (c->state == CONN_WAITING) {
+            return 0;//fcgi_submit resumes us once the application answers
+        }
+
+        if (c->state == CONN_WRITING_HEADER || c->state == CONN_WRITING_BODY) {
+            if (conn_flush(c) == 0) {
+                return 0;//wait for EPOLLOUT
+            }
+        }
+
+        if (c->state == CONN_DONE) {
+            request_finish(c);
+        }
+        if (c->state != CONN_DONE || !c->keep_alive) {
+            conn_close(c);
+            return -1;
+        }
+        conn_reset(c);
+    }
+}
+
+// Advance a connection from outside its own socket's events; in uring mode
+// also make sure the ring will wake it for whatever it now waits on
+static void conn_drive(struct connection *c) {
+    if (conn_process(c) == 0 && c->owner->uring != NULL) {
+        conn_poll(c);
     }
 }
 
+void conn_resume(struct connection *c) {
+    conn_drive(c);
+}
+
+// Once a second: FastCGI deadlines and health checks, reaping CGI scripts
+// and closing cached descriptors nobody asked for lately
+static void housekeeping(struct timer *t) {
+    struct worker *w = (struct worker *)((char *)t - offsetof(struct worker, housekeeping));
 
-void process_request(int client_sock) {
-    char buff[4096]; //buffer for request
+    fcgi_sweep(w);
+    cgi_sweep(w);
+    fd_cache_sweep(&w->fds, now_ms());
+    timer_arm(&w->timers, t, now_ms() + 1000);
+}
 
-    int bytes_read = read(client_sock, buff, sizeof(buff) - 1); // Read the request from the client socket
+// Start the worker's wheel with the housekeeping timer on it
+static void worker_timers_init(struct worker *w) {
+    timer_wheel_init(&w->timers, now_ms());
+    w->housekeeping.fire = housekeeping;
+    timer_arm(&w->timers, &w->housekeeping, now_ms() + 1000);
+}
 
-    if (bytes_read <= 0) {//error check forreaing 
-        close(client_sock);
-        return;
+// The next generation is serving: stop accepting and let the connections we
+// have finish. The listener lives on in the new process; closing our copy
+// loses nothing queued on it.
+static void worker_drain(struct worker *w) {
+    w->draining = 1;
+    if (w->uring != NULL) {
+        for (int i = 0; i < URING_ACCEPTS; i++) {
+            struct io_uring_sqe *sqe = uring_get_sqe(w->uring);
+
+            if (sqe != NULL) {
+                uring_prep_cancel(sqe, UD_ACCEPT(i), UD_IGNORE);
+            }
+        }
+    } else {
+        epoll_ctl(w->epfd, EPOLL_CTL_DEL, w->listen_fd, NULL);
     }
+    close(w->listen_fd);
+    w->listen_fd = -1;
+}
 
-    buff[bytes_read] = '\0'; //null terminate for string tokenization
+// Answer the main thread between batches of events: the hot paths when it
+// asks for them, and draining once the next generation has taken over.
+// Returns 0 when a drained worker has no connections left and may stop.
+static int worker_handoff(struct worker *w) {
+    unsigned gen = __atomic_load_n(&snapshot_gen, __ATOMIC_ACQUIRE);
+
+    if (gen != w->hot_gen) {
+        w->hot = hot_list(w, &w->hot_len);
+        __atomic_store_n(&w->hot_gen, gen, __ATOMIC_RELEASE);
+    }
+    if (!w->draining && __atomic_load_n(&drain_requested, __ATOMIC_RELAXED)) {
+        worker_drain(w);
+    }
+    return !w->draining || w->nconns > 0;
+}
 
-    char *method, *path, *protocol, *saveptr;
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
 
-    method = strtok_r(buff, " ", &saveptr); 
+// Drain the accept queue; with EPOLLET we only hear about it once per burst
+static void accept_connections(struct worker *w) {
+    for (;;) {
+        struct sockaddr_in peer;
+        socklen_t peer_len = sizeof(peer);
+        int client_sock = accept4(w->listen_fd, (struct sockaddr *)&peer, &peer_len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_sock < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                perror("error accepting");
+            }
+            return;
+        }
 
-    path = strtok_r(NULL, " ", &saveptr); 
+        COUNTER_ADD(w->accepted, 1);
+        struct connection *c = conn_open(client_sock, &peer);
+        if (c == NULL) {
+            close(client_sock);
+            continue;
+        }
 
-    protocol = strtok_r(NULL, "\r\n", &saveptr); 
+        struct epoll_event ev = {0};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.fd = client_sock;
+        if (epoll_ctl(w->epfd, EPOLL_CTL_ADD, client_sock, &ev) < 0) {
+            perror("epoll_ctl add client");
+            conn_close(c);
+            continue;
+        }
+        conn_process(c);//the request may already be waiting
+    }
+}
 
-    if (!method || !path || !protocol) {//check for valid request
-        fprintf(stderr, "Invalid HTTP request line\n");
+// Hand a completion to the connection it belongs to
+static void uring_complete(uint64_t user_data, int res) {
+    struct connection *c = (struct connection *)(uintptr_t)(user_data & ~(uint64_t)IO_TAG);
+    struct conn_io *io = (user_data & IO_TAG) == IO_RX ? &c->rx : &c->tx;
 
-        close(client_sock);
+    io->pending = 0;
+    if (!io->poll) {
+        io->done = 1;
+        io->res = res;
+    }
+    if (c->closing) {
+        if (!c->rx.pending && !c->tx.pending) {
+            conn_free(c);
+        }
         return;
     }
-    char lgbuff[1024];//buffer for log msg
+    conn_drive(c);
+}
 
-    snprintf(lgbuff, sizeof(lgbuff), "Received %s request for %s", method, path);
-    logMsg(lgbuff);
-    
-    if (strcmp(method, "GET") == 0) {//checking for method and calling its function
-        handle_get_request(client_sock, path);
+static int uring_arm_accept(struct worker *w, int i) {
+    struct io_uring_sqe *sqe = uring_get_sqe(w->uring);
 
-    } else if (strcmp(method, "HEAD") == 0) {
-        handle_head_request(client_sock, path);
+    if (sqe == NULL) {
+        return -1;
+    }
+    w->accept_peer_len[i] = sizeof(w->accept_peer[i]);
+    uring_prep_accept(sqe, 0, (struct sockaddr *)&w->accept_peer[i], &w->accept_peer_len[i],
+                      SOCK_NONBLOCK | SOCK_CLOEXEC, UD_ACCEPT(i));
+    return 0;
+}
 
-    } else if (strcmp(method, "POST") == 0) {
-        handle_post_request(client_sock, path);
+static int uring_arm_epoll(struct worker *w) {
+    struct io_uring_sqe *sqe = uring_get_sqe(w->uring);
 
-    } else {
-               const char *response = "HTTP/1.1 501 Not a method\r\nContent-Length: 0\r\n\r\n";//just incase of wrong methof
-        send(client_sock, response, strlen(response), 0);
+    if (sqe == NULL) {
+        return -1;
     }
-    close(client_sock); // Close the client socket after handling the request
+    uring_prep_poll(sqe, w->epfd, POLLIN, 1, UD_EPOLL);
+    return 0;
 }
 
-void handle_get_request(int client_sock, const char* path) {
-    char fPath[1024];//giving buffer for file pth
+// io_uring flavour of the event loop. Clients are accepted by URING_ACCEPTS
+// accepts kept in flight on the listener, registered as fixed file 0, and their reads and
+// writes are ring operations (see conn_recv). Script pipes and FastCGI
+// sockets stay in w->epfd, which the ring watches with a multishot poll.
+// Returns -1 without having touched the listener if the ring cannot be set up.
+static int run_uring_loop(struct worker *w) {
+    struct epoll_event events[MAX_EVENTS];
+    struct uring *u = malloc(sizeof(*u));
+    int err = u != NULL ? uring_init(u, 4096, cfg->uring_sqpoll) : -ENOMEM;
+
+    if (err == 0) {
+        err = uring_register_files(u, &w->listen_fd, 1);
+        if (err < 0) {
+            uring_exit(u);
+        }
+    }
+    if (err < 0) {
+        if (w->id == 0) {
+            fprintf(stderr, "io_uring unavailable (%s), using epoll\n", strerror(-err));
+        }
+        free(u);
+        return -1;
+    }
 
-   
-    if (strcmp(path, "/") == 0) {//mapping path to correct file path
-        strcpy(fPath, "www/index.html");  
-    } else {
-                snprintf(fPath, sizeof(fPath), "www%s", path);// snprintf to avoid buffer overfloW
+    w->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (w->epfd < 0) {
+        perror("epoll_create1");
+        uring_exit(u);
+        free(u);
+        return 0;
     }
-     const char* mime_type = get_mime_type(fPath);//getting mime type
+    w->uring = u;
+    for (int i = 0; i < URING_ACCEPTS; i++) {
+        uring_arm_accept(w, i);
+    }
+    uring_arm_epoll(w);
 
-    if (mime_type == NULL) {  //error responses 415 invalid media type
-        send_response(client_sock, "HTTP/1.1 415 Unsupported Media Type", "text/plain", "415 Unsupported Media Type: file type not supported", 0);
-        return;
+    while (!__atomic_load_n(&stop_requested, __ATOMIC_RELAXED) && worker_handoff(w)) {
+        int r = uring_submit_and_wait(u, timer_wheel_timeout(&w->timers, now_ms(), 1000));//at least once a second, to notice shutdown
+        if (r < 0) {
+            fprintf(stderr, "io_uring_enter: %s\n", strerror(-r));
+            break;
+        }
+
+        struct io_uring_cqe *cqe;
+        while ((cqe = uring_peek_cqe(u)) != NULL) {
+            uint64_t user_data = cqe->user_data;
+            int res = cqe->res;
+            int more = cqe->flags & IORING_CQE_F_MORE;
+
+            uring_cqe_seen(u);//free the slot before handlers queue more work
+            if (user_data == UD_IGNORE) {
+                continue;
+            }
+            if ((user_data & IO_TAG) == IO_RX && user_data < UD_ACCEPT(URING_ACCEPTS)) {
+                int i = user_data >> 3;
+
+                if (res >= 0) {
+                    const struct sockaddr_in *peer = w->accept_peer[i].sin_family == AF_INET ? &w->accept_peer[i] : NULL;
+
+                    COUNTER_ADD(w->accepted, 1);
+                    struct connection *c = conn_open(res, peer);
+                    if (c == NULL) {
+                        close(res);
+                    } else {
+                        conn_drive(c);//the recv it submits completes at once if the request is here
+                    }
+                } else if (res != -ECONNABORTED && res != -EINTR && !(res == -ECANCELED && w->draining)) {
+                    fprintf(stderr, "error accepting: %s\n", strerror(-res));
+                }
+                if (!w->draining) {
+                    uring_arm_accept(w, i);
+                }
+                continue;
+            }
+            if (user_data == UD_EPOLL) {
+                int n;
+                do {
+                    n = epoll_wait(w->epfd, events, MAX_EVENTS, 0);
+                    for (int i = 0; i < n; i++) {
+                        if (cgi_event(w, events[i].data.fd) < 0) {
+                            fcgi_event(w, events[i].data.fd);
+                        }
+                    }
+                } while (n == MAX_EVENTS);
+                if (!more) {
+                    uring_arm_epoll(w);
+                }
+                continue;
+            }
+            uring_complete(user_data, res);
+        }
+        arena_reset(&w->scratch);
+        timer_wheel_run(&w->timers, now_ms());
     }
+    uring_exit(u);//cancels whatever is still in flight
+    free(u);
+    w->uring = NULL;
+    close(w->epfd);
+    return 0;
+}
 
-    struct stat pathStat;
+void run_event_loop(struct worker *w) {
+    struct epoll_event events[MAX_EVENTS];
 
-    if (stat(fPath, &pathStat) < 0) {//checking for file
-        send_response(client_sock, "HTTP/1.1 404 Not Found", "text/html", "404 Not Found: file not found.", 0);
+    if (set_nonblocking(w->listen_fd) < 0) {
+        perror("Error making listen socket non-blocking");
+        return;
+    }
+    worker_timers_init(w);
+    if (cfg->mode == SERVE_URING && run_uring_loop(w) == 0) {
         return;
     }
 
-    int fileFd = open(fPath, O_RDONLY);//opening file
-
-    if (fileFd < 0) {
-        perror("file open failed");
-        send_response(client_sock, "HTTP/1.1 404 Not Found", "text/html", "404 Not Found: file not found.", 0);
+    w->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (w->epfd < 0) {
+        perror("epoll_create1");
         return;
     }
 
-    if (fstat(fileFd, &pathStat) < 0) {//checking for file stats
-        perror("Failed to get file statistics");
-        send_response(client_sock, "HTTP/1.1 500 Internal Server Error", "text/html", "500 Internal Server Error: Couldnt get info.", 0);
-        close(fileFd);
+    struct epoll_event ev = {0};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.fd = w->listen_fd;
+    if (epoll_ctl(w->epfd, EPOLL_CTL_ADD, w->listen_fd, &ev) < 0) {
+        perror("epoll_ctl add listener");
+        close(w->epfd);
         return;
     }
 
-    char *fileCont = malloc(pathStat.st_size + 1);//allocating memory for file content
+    while (!__atomic_load_n(&stop_requested, __ATOMIC_RELAXED) && worker_handoff(w)) {
+        int n = epoll_wait(w->epfd, events, MAX_EVENTS, timer_wheel_timeout(&w->timers, now_ms(), 1000));//at least once a second, to notice shutdown
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("epoll_wait");
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == w->listen_fd) {
+                accept_connections(w);
+                continue;
+            }
+
+            struct connection *c = conn_get(fd);
+            if (c != NULL && c->owner == w) {//a stale event for a closed pipe whose fd another worker reused
+                conn_process(c);
+            } else if (cgi_event(w, fd) < 0) {
+                fcgi_event(w, fd);
+            }
+        }
+        arena_reset(&w->scratch);
+        timer_wheel_run(&w->timers, now_ms());
+    }
+    close(w->epfd);
+}
+
+void handle_connections(int server_sock) {
+
+    struct sockaddr_in client_addr;//structure for client
+
+    socklen_t client_addrlen = sizeof(client_addr);//settingn size
+
+    int client_sock;
+
+    for (;;) {
+        if (__atomic_load_n(&stop_requested, __ATOMIC_RELAXED)) {
+            return;
+        }
+        if (handoff_signal != 0) {
+            handoff_signal = 0;
+            if (hand_over() == 0) {
+                return;//nothing in flight between connections, so nothing to drain
+            }
+        }
+        client_sock = accept(server_sock, (struct sockaddr *)&client_addr, &client_addrlen);//accepting connection
+        if (client_sock >= 0) {
+            process_request(client_sock);
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {//listener shared with an event loop generation, which made it non-blocking
+            struct pollfd pfd = { server_sock, POLLIN, 0 };
+
+            poll(&pfd, 1, -1);
+            continue;
+        }
+        if (errno == EINTR && handoff_signal != 0) {
+            continue;
+        }
+        break;
+    }
+
+    if (errno != EINTR) {
+
+        perror("error accepting");
+    }
+}
+
 
-    if (fileCont == NULL || read(fileFd, fileCont, pathStat.st_size) < 0) {//reading file
-        perror("unable to read file");
-        send_response(client_sock, "HTTP/1.1 500 Internal Server Error", "text/html", "500 Internal Server Error: unable to read file.", 0);
-        free(fileCont);
-        close(fileFd);
+void process_request(int client_sock) {
+    struct connection *c = conn_open(client_sock, NULL);//blocking socket, so each step runs to completion
+    struct timeval rcv = { cfg->header_timeout, 0 }, snd = { cfg->send_timeout, 0 };
+
+    if (c == NULL) {
+        close(client_sock);
         return;
     }
-    fileCont[pathStat.st_size] = '\0';//null terminate
+    setsockopt(client_sock, SOL_SOCKET, SO_RCVTIMEO, &rcv, sizeof(rcv));//a silent client must not hold the only thread
+    setsockopt(client_sock, SOL_SOCKET, SO_SNDTIMEO, &snd, sizeof(snd));
+    if (conn_process(c) == 0) {//every call blocks, so only a socket timeout gets here
+        conn_close(c);
+    }
+    arena_reset(&self->scratch);
+}
+
+// Codings the client accepts that we may have, best first; br wins ties
+static int accepted_codings(const struct connection *c, enum content_coding *out) {
+    const struct http_span *v = http_find_header(&c->req, c->rbuf, "accept-encoding");
+    int q_br, q_gzip, n = 0;
 
-    
-    send_response(client_sock, "HTTP/1.1 200 OK", mime_type, fileCont, pathStat.st_size);//sending response to client
+    if (v == NULL) {
+        return 0;//no header, send identity
+    }
+    q_br = http_qvalue(c->rbuf, v, "br");
+    q_gzip = http_qvalue(c->rbuf, v, "gzip");
+    if (q_br > 0 && q_br >= q_gzip) {
+        out[n++] = CODING_BR;
+    }
+    if (q_gzip > 0) {
+        out[n++] = CODING_GZIP;
+    }
+    if (q_br > 0 && q_br < q_gzip) {
+        out[n++] = CODING_BR;
+    }
+    return n;
+}
 
-    free(fileCont);//free file content
-    close(fileFd);//close file descriptor
+static int coding_level(enum content_coding coding) {
+    return coding == CODING_BR ? cfg->brotli_quality : cfg->gzip_level;
 }
 
+// Serve one representation of path: the file as it is on disk (coding says
+// how it is encoded, for sidecars), or compressed on the fly into the cache
+// when encode is set. Returns -1, queueing nothing, if path is not a regular
+// file, and -2 if it is a directory.
+static int serve_file(struct connection *c, const char *path, const char *mime_type,
+                      enum content_coding coding, int vary, enum content_coding encode) {
+    struct file_cache *fc = &c->owner->cache;
+    long now = now_ms();
+    struct cache_entry *entry = cache_lookup(fc, path, coding, mime_type, now);
+    struct file_rep rep;
+
+    if (entry == NULL) {
+        struct stat st;
+
+        if (is_conditional(c) && fd_cache_stat(&c->owner->fds, path, now, &st) == 0 && S_ISREG(st.st_mode)) {
+            enum content_coding sent = encode != CODING_IDENTITY && (size_t)st.st_size <= fc->max_entry ?
+                                       encode : coding;//what we would send, cache permitting
+
+            file_rep_init(&rep, &st, mime_type, sent, vary);
+            if (not_modified(c, &rep)) {
+                queue_not_modified(c, &rep);//revalidated without opening it
+                return 0;
+            }
+        }
+
+        struct fd_entry *file = fd_cache_open(&c->owner->fds, path, now);//no path walk if seen lately
 
-void handle_head_request(int client_sock, const char* path) {
-    char fPath[512]; //setting up buffer for file path
+        if (file == NULL || (file->fd < 0 && !fd_error_lasting(file->err))) {//out of memory or descriptors, not a 404
+            send_response(c->fd, "HTTP/1.1 503 Service Unavailable", NULL, NULL, 0);
+            if (file != NULL) {
+                fd_cache_release(file);
+            }
+            return 0;
+        }
+        if (file->fd < 0 || !S_ISREG(file->st.st_mode)) {//missing, or directories and devices cant be streamed
+            int dir = file->fd >= 0 && S_ISDIR(file->st.st_mode);
 
-   
-    if (strcmp(path, "/") == 0) {//mapping path to correct file path
-        strcpy(fPath, "www/index.html");
+            fd_cache_release(file);
+            return dir ? -2 : -1;
+        }
 
-    } else {
-            snprintf(fPath, sizeof(fPath), "www%s", path);
+        const struct stat *pathStat = &file->st;
+        file_rep_init(&rep, pathStat, mime_type, coding, vary);
+        entry = cache_insert(fc, path, file->fd, pathStat, &rep, now);
+        if (entry == NULL) {//too big to keep, stream it from the file
+            if (not_modified(c, &rep)) {
+                queue_not_modified(c, &rep);
+                fd_cache_release(file);
+                return 0;
+            }
+            c->file_fd = file->fd;//conn_flush sendfiles it, the reference goes when done
+            c->file_entry = file;
+            c->file_off = 0;
+            c->file_end = pathStat->st_size;
+            queue_file_response(c, c->head, format_file_head(c->head, sizeof(c->head), &rep, pathStat->st_size),
+                                &rep, pathStat->st_size);//queue header for the file
+            return 0;
+        }
+        fd_cache_release(file);//small enough to keep in memory for the next hit
     }
 
-    
-    if (strstr(path, "..") != NULL) {//checking for invalid path
-        const char *errorMsg = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
-        send(client_sock, errorMsg, strlen(errorMsg), 0);
-        return;
+    const char *head = entry->head;//hot hit: no syscalls before the writev
+    size_t head_len = entry->head_len;
+    char *data = entry->data;
+    size_t size = entry->size;
+
+    rep = entry->rep;
+    if (encode != CODING_IDENTITY) {
+        const struct cache_variant *v = cache_encode(fc, entry, encode, coding_level(encode));
+
+        if (v != NULL) {
+            head = v->head;
+            head_len = v->head_len;
+            data = v->data;
+            size = v->size;
+            rep.coding = encode;
+        }
+    }
+
+    if (not_modified(c, &rep)) {
+        queue_not_modified(c, &rep);
+        cache_release(entry);
+        return 0;
+    }
+    c->entry = entry;
+    c->body = data;
+    c->body_len = size;
+    queue_file_response(c, head, head_len, &rep, size);
+    return 0;
+}
+
+// A directory was asked for without its trailing slash: send the client to
+// the slashed URL, so that relative links in its index resolve inside it.
+// The URL is rebuilt from rel, the normalized path; only the query is kept
+// from the target.
+static void queue_directory_redirect(struct connection *c, const char *target, const char *rel) {
+    static const char hex[] = "0123456789ABCDEF";
+    char location[3 * 1024 + 3];//every byte of a normalized path escaped, two slashes
+    size_t len = 0;
+    size_t path_len = strcspn(target, "?#");
+
+    location[len++] = '/';//never the raw target: "//host/.." would make it another site
+    for (const char *p = rel; *p != '\0' && len + 5 < sizeof(location); p++) {
+        unsigned char ch = *p;
+
+        if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') ||
+            strchr("-._~!$&'()*+,;=:@/", ch) != NULL) {
+            location[len++] = ch;
+        } else {//decoded by path_normalize, so escape again
+            location[len++] = '%';
+            location[len++] = hex[ch >> 4];
+            location[len++] = hex[ch & 15];
+        }
     }
+    location[len++] = '/';
+    location[len] = '\0';
 
-    struct stat fStat;//structing file stats
+    int n = snprintf(c->head, sizeof(c->head), "HTTP/1.1 301 Moved Permanently\r\n"
+                     "Location: %s%s\r\n"
+                     "Content-Length: 0\r\n",
+                     location, target[path_len] == '?' ? target + path_len : "");
 
-    if (stat(fPath, &fStat) < 0 || S_ISDIR(fStat.st_mode)) {//if file not found or its a directory
-               const char *notFound = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
-        send(client_sock, notFound, strlen(notFound), 0);
+    if (n < 0 || (size_t)n >= sizeof(c->head) - 32) {//no room left for Connection
+        send_response(c->fd, "HTTP/1.1 404 Not Found", "text/html", "404 Not Found: file not found.", 0);
         return;
     }
+    queue_file_head(c, c->head, n);
+}
 
-    
-    char header[256];//buffer for header
+// Is the normalized path rel a directory? Asked through the descriptor
+// cache, so the answer is usually free.
+static int is_directory(struct connection *c, const char *rel) {
+    struct fd_entry *file = fd_cache_open(&c->owner->fds, rel, now_ms());
+    int dir = file != NULL && file->fd >= 0 && S_ISDIR(file->st.st_mode);
 
-    snprintf(header, sizeof(header),//printing out header
-             "HTTP/1.1 200 OK\r\n"
-             "Content-Type: %s\r\n"  
-             "Content-Length: %lld\r\n\r\n", get_mime_type(fPath), (long long)fStat.st_size);
-    send(client_sock, header, strlen(header), 0);//send to client
+    if (file != NULL) {
+        fd_cache_release(file);
+    }
+    return dir;
 }
 
-void handle_post_request(int client_sock, const char* path) {// this is an attempt to handle post request. not finished 
-    char fPath[512];  //another buff
+// serve_static from the pack: the same answers without touching the
+// filesystem. rel is normalized, with the index appended; anything the pack
+// does not have is a 404.
+static void serve_packed(struct connection *c, const char *target, const char *rel, const char *mime_type) {
+    const struct pack_file *f = mime_type != NULL ? pack_lookup(&site_pack, rel) : NULL;
+
+    if (f == NULL) {
+        if (pack_directory(&site_pack, rel)) {
+            queue_directory_redirect(c, target, rel);
+        } else if (mime_type == NULL) {
+            send_response(c->fd, "HTTP/1.1 415 Unsupported Media Type", "text/plain", "415 Unsupported Media Type: file type not supported", 0);
+        } else {
+            send_response(c->fd, "HTTP/1.1 404 Not Found", "text/html", "404 Not Found: file not found.", 0);
+        }
+        return;
+    }
 
-    if (strcmp(path, "/") == 0) {//mapping once again
-        strcpy(fPath, "www/index.html"); 
+    int vary = compressible_type(mime_type);
+    enum content_coding accepted[CODING_COUNT];
+    enum content_coding coding = CODING_IDENTITY;
+    int naccepted = vary ? accepted_codings(c, accepted) : 0;
+    const struct pack_variant *v = NULL;
+    struct file_rep rep;
 
+    for (int i = 0; i < naccepted && v == NULL; i++) {//compressed when the pack was made
+        if ((v = pack_variant(f, accepted[i])) != NULL) {
+            coding = accepted[i];
+        }
+    }
+    if (v == NULL) {
+        v = pack_variant(f, CODING_IDENTITY);
+    }
+    pack_rep(v, mime_type, coding, vary, &rep);
+    if (not_modified(c, &rep)) {
+        queue_not_modified(c, &rep);
+        return;
+    }
+    if (v->body_len > cfg->cache_max_file) {//sendfile rather than copying it out of the mapping
+        c->file_fd = site_pack.fd;
+        c->file_base = c->file_off = v->body_off;
+        c->file_end = v->body_off + v->body_len;
     } else {
-            snprintf(fPath, sizeof(fPath), "www%s", path);
+        c->body = (char *)site_pack.base + v->body_off;//read-only mapping, never written through
+        c->body_len = v->body_len;
     }
+    queue_file_response(c, site_pack.base + v->head_off, v->head_len, &rep, v->body_len);
+}
 
-    if (strstr(fPath, ".cgi") != NULL) {//checking for cgi file
-        int pid = fork();  
-
-        if (pid == 0) {   //waitpidforking process
-            
-            setenv("REQUEST_METHOD", "POST", 1);//setting up env variables
+// GET and HEAD: pick the representation and queue it. Text types are
+// negotiated on Accept-Encoding, preferring a precompressed sidecar
+// (app.js.br, app.js.gz) and falling back to compressing into the cache.
+static void serve_static(struct connection *c, const char *target) {
+    char fPath[1024];//normalized path under the document root
+    int len = path_normalize(target, strlen(target), fPath, sizeof(fPath) - sizeof(INDEX_FILE));
 
-            
-            dup2(client_sock, STDOUT_FILENO);
-            dup2(client_sock, STDERR_FILENO);
+    if (len < 0) {//bad escape, or climbing out of the root
+        send_response(c->fd, "HTTP/1.1 400 Bad Request", NULL, NULL, 0);
+        return;
+    }
+    if (len == 0 || fPath[len - 1] == '/') {//a directory: serve its index
+        strcpy(fPath + len, INDEX_FILE);
+    }
 
-            
-            execl(fPath, fPath, NULL);//executing cgi script
-            perror("didnt execute cgi script");
-            exit(EXIT_FAILURE);
+     const char* mime_type = get_mime_type(fPath);//getting mime type
 
-        } else if (pid > 0) {  
-            int status;
+    if (site_pack.base != NULL) {
+        serve_packed(c, target, fPath, mime_type);
+        return;
+    }
+    if (mime_type == NULL) {  //error responses 415 invalid media type
+        if (is_directory(c, fPath)) {
+            queue_directory_redirect(c, target, fPath);
+            return;
+        }
+        send_response(c->fd, "HTTP/1.1 415 Unsupported Media Type", "text/plain", "415 Unsupported Media Type: file type not supported", 0);
+        return;
+    }
 
-            waitpid(pid, &status, 0); 
+    int vary = compressible_type(mime_type);
+    enum content_coding accepted[CODING_COUNT];
+    enum content_coding encode = CODING_IDENTITY;
+    int naccepted = vary ? accepted_codings(c, accepted) : 0;
 
-            if (WIFEXITED(status) && WEXITSTATUS(status) != 0) {//checking exiting statis
-                const char *errorMsg = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n\r\n";
-                send(client_sock, errorMsg, strlen(errorMsg), 0);
-            }
+    for (int i = 0; i < naccepted; i++) {
+        char sidecar[1100];
 
-        } else { 
-            const char *errorMsg = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n\r\n";
-            send(client_sock, errorMsg, strlen(errorMsg), 0);
+        snprintf(sidecar, sizeof(sidecar), "%s%s", fPath, coding_suffix(accepted[i]));
+        if (serve_file(c, sidecar, mime_type, accepted[i], 1, CODING_IDENTITY) == 0) {
+            return;//compressed ahead of time, no CPU spent here
+        }
+    }
+    for (int i = 0; i < naccepted && encode == CODING_IDENTITY; i++) {
+        if (coding_available(accepted[i])) {
+            encode = accepted[i];
         }
+    }
 
-    } else {
-       
-        const char *notFound = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
-        send(client_sock, notFound, strlen(notFound), 0);
+    int r = serve_file(c, fPath, mime_type, CODING_IDENTITY, vary, encode);
+    if (r == -2) {
+        queue_directory_redirect(c, target, fPath);
+    } else if (r < 0) {
+        send_response(c->fd, "HTTP/1.1 404 Not Found", "text/html", "404 Not Found: file not found.", 0);
     }
 }
 
+void handle_get_request(int client_sock, const char* path) {
+    serve_static(conn_get(client_sock), path);
+}
+
+
+void handle_head_request(int client_sock, const char* path) {
+    struct connection *c = conn_get(client_sock);
+
+    serve_static(c, path);//exactly the headers GET would send
+    c->body_off = c->body_len;//header only
+    c->file_off = c->file_end;
+}
+
+void handle_post_request(int client_sock, const char* path) {//scripts are routed before the method switch, so nothing is left to take a body
+    (void)path;
+    send_response(client_sock, "HTTP/1.1 404 Not Found", NULL, NULL, 0);
+}
+
 void send_response(int client_sock, const char *header, const char *content_type, const char *body, int body_length) {
-    char responseHead[1024]; //buffer for response header
+    struct connection *c = conn_get(client_sock);
 
-    
-    int headLength = snprintf(responseHead, sizeof(responseHead),//printing out header
-                                 "%s\r\n"
-                                 "Content-Type: %s\r\n"
-                                 "Content-Length: %d\r\n"
-                                 "\r\n",
-                                 header, content_type, body_length);
+    if (c == NULL) {
+        return;
+    }
 
-    
-    send(client_sock, responseHead, headLength, 0);//sending header
+    queue_head(c, header, content_type, body_length);
 
-    
-    if (body && body_length > 0) {//sending body to client and is greater than 0
-        send(client_sock, body, body_length, 0);
+    if (body && body_length > 0) {//copying body so it outlives the caller's buffer
+        c->body = buf_get(&c->owner->bufs, body_length, &c->body_cap);
+        if (c->body != NULL) {
+            memcpy(c->body, body, body_length);
+            c->body_len = body_length;
+        }
     }
 }
 
@@ -302,14 +2447,5 @@ const char* get_mime_type(const char *filename) {
     if (!p || p == filename) {//making sure its not null
         return NULL;
     }
-
-   
-    if (strcmp(p, ".html") == 0) return "text/html";
-    else if (strcmp(p, ".css") == 0) return "text/css";
-    else if (strcmp(p, ".js") == 0) return "application/javascript";
-    else if (strcmp(p, ".png") == 0) return "image/png";
-    else if (strcmp(p, ".jpeg") == 0 || strcmp(p, ".jpg") == 0) return "image/jpeg";
-    else if (strcmp(p, ".gif") == 0) return "image/gif";
-    else if (strcmp(p, ".txt") == 0) return "text/plain";
-    else return NULL; //returning null if not there 
+    return mime_lookup(p + 1, strlen(p + 1));//perfect hash, NULL if not there
 }
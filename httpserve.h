@@ -2,10 +2,195 @@
 #define HTTPSERVE_H
 
 #include <stdio.h>  // For size_t
+#include <stdint.h> // For uint32_t
+#include <pthread.h>
+#include <netinet/in.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include "filecache.h"
+#include "fdcache.h"
+#include "parser.h"
+#include "scan.h"
+#include "fcgi.h"
+#include "cgi.h"
+#include "mime.h"
+#include "accesslog.h"
+#include "metrics.h"
+#include "uring.h"
+#include "pool.h"
+#include "path.h"
+#include "pack.h"
+#include "admit.h"
+#include "timerwheel.h"
+#include "handoff.h"
 
 // Server configuration constants
 #define SERVER_PORT 8080
+#define DOCUMENT_ROOT "www"
+#define INDEX_FILE "index.html"  // served for a request naming a directory
 #define BUFFER_SIZE 16384
+#define MAX_EVENTS 256
+#define URING_ACCEPTS 4  // accepts a uring-mode worker keeps in flight, each with its own peer address
+#define CONFIG_PATH_MAX 256
+#define METRICS_PATH "/__metrics"
+
+// How start_server() drives connections
+enum serve_mode {
+    SERVE_EPOLL,    // edge-triggered epoll reactor (default)
+    SERVE_BLOCKING, // accept and answer one connection at a time
+    SERVE_URING,    // io_uring completions, epoll if the kernel lacks support
+};
+
+// Runtime settings, filled from defaults, an optional config file and the command line
+struct server_config {
+    int port;
+    int listen_backlog;     // pending connections the kernel queues on each listener
+    int max_connections;    // open client connections, beyond which new ones get 503; 0 = fd limit only
+    int max_connections_per_ip; // open connections from one address, beyond which 429; 0 = no limit
+    int request_rate_per_ip; // requests per second one address may make before 429; 0 = no limit
+    int request_burst_per_ip; // requests it may make at once, 0 = one second's worth
+    enum serve_mode mode;
+    int workers;     // event loop threads, 0 = one per online CPU
+    int pin_workers; // pin worker i to the i-th allowed CPU
+    int uring_sqpoll; // let a kernel thread per worker poll io_uring submissions
+    int keepalive_timeout;  // seconds an idle connection is held open, 0 = no keep-alive
+    int header_timeout;     // seconds a client has to send a complete request head
+    int send_timeout;       // seconds a response may make no progress before the client is dropped
+    int drain_timeout;      // seconds a replaced process may finish its responses, 0 = as long as they take
+    int keepalive_requests; // requests served on one connection before closing it
+    size_t cache_bytes;     // hot-file cache budget, split evenly across workers
+    size_t cache_max_file;  // files larger than this are always streamed
+    int cache_valid_ms;     // how long a cached file's stat identity is trusted
+    int fd_cache_entries;   // open files and failed opens remembered, split evenly across workers
+    size_t max_header_bytes; // request line plus headers, larger heads get 431
+    size_t max_uri;         // longer request targets get 414
+    int max_headers;        // more header lines get 431
+    int gzip_level;         // on-the-fly gzip, 1-9
+    int brotli_quality;     // on-the-fly brotli, 0-11 (needs HAVE_BROTLI)
+    int fcgi_procs;         // processes started per FastCGI script
+    int fcgi_timeout;       // seconds a FastCGI request may take before 504
+    int cgi_timeout;        // seconds a CGI script may go without output before it is killed
+    char mime_types[CONFIG_PATH_MAX]; // mime.types file overriding the built-in table, "" for none
+    char pack[CONFIG_PATH_MAX]; // site snapshot from mkpack served instead of www/, "" for none
+    char access_log[CONFIG_PATH_MAX]; // access log file, "-" for stdout, "off" for none
+    enum access_log_format access_log_format;
+    int access_log_ring;    // records a worker can queue before the log thread catches up
+};
+
+// Settings in effect; set once at startup before any worker runs
+extern const struct server_config *cfg;
+
+// One event loop thread with its own SO_REUSEPORT listener
+struct worker {
+    int id;
+    int cpu;         // CPU the thread is pinned to, -1 if unpinned
+    int listen_fd;
+    int epfd;
+    struct uring *uring;     // completion ring in uring mode, else NULL
+    struct sockaddr_in accept_peer[URING_ACCEPTS]; // where the ring's accepts say who connected
+    socklen_t accept_peer_len[URING_ACCEPTS];
+    pthread_t thread;
+
+    unsigned long accepted; // connections taken off this worker's listener
+    unsigned long served;   // requests answered by this worker
+
+    int nconns;              // open connections
+    struct timer_wheel timers; // connection and CGI deadlines
+    struct timer housekeeping; // once a second: cache, FastCGI and CGI upkeep
+
+    char *hot;               // paths in this worker's caches, for the next generation
+    size_t hot_len;
+    unsigned hot_gen;        // snapshot request hot answers
+    int draining;            // handed over: accepting nothing, closing after each response
+    int stopped;             // out of its event loop
+
+    struct file_cache cache;  // hot files, private to this worker
+    struct fd_cache fds;      // open descriptors and failed opens, for what cache misses
+    struct fcgi_pool *fcgi;   // this worker's FastCGI connections and queues
+    struct cgi_job *cgi;      // CGI scripts started by this worker, until reaped
+    struct access_ring log;   // finished requests waiting for the log thread
+    struct metrics metrics;   // this worker's share of /__metrics
+
+    struct slab conn_slab;    // struct connection
+    struct slab cgi_slab;     // struct cgi_job
+    struct buf_pool bufs;     // read buffers, response bodies, script and FastCGI output
+    struct arena scratch;     // request scratch, reset after every batch of events
+} __attribute__((aligned(64)));
+
+// Where a connection is in its request/response cycle
+enum conn_state {
+    CONN_READING,        // collecting the request head
+    CONN_WRITING_HEADER, // flushing the status line and headers
+    CONN_WRITING_BODY,   // flushing the response body
+    CONN_WAITING,        // request handed to a FastCGI application
+    CONN_CGI,            // streaming to and from a CGI script
+    CONN_DONE,           // response fully written
+};
+
+// A ring operation a connection has in flight in uring mode. The socket call
+// that would have blocked submits it; the completion is parked here until
+// the connection is driven again and makes the very same call, which then
+// returns the parked result instead.
+struct conn_io {
+    uint8_t pending;        // submitted, completion not yet seen
+    uint8_t done;           // completed, res not yet taken
+    uint8_t poll;           // only a readiness poll, no result to hand back
+    int res;                // byte count or negative errno
+};
+
+// Per-client state, looked up by socket fd
+struct connection {
+    int fd;
+    enum conn_state state;
+    struct worker *owner;   // worker whose loop drives this connection
+    struct timer timer;     // header, keep-alive or send deadline, by state
+    uint64_t sent_mark;     // log.bytes when the send deadline was armed
+    int keep_alive;         // leave the socket open after this response
+    int framing_lost;       // request body could not be delimited, close afterwards
+    unsigned requests;      // requests seen on this connection
+
+    char *rbuf;             // BUFFER_SIZE bytes from owner->bufs, NULL while idle;
+    size_t rlen;            // request bytes read so far (NUL terminated)
+    struct http_request req; // parse state and result for the request at rbuf[0]
+    enum parse_result parse_status; // PARSE_DONE or the error to answer with
+    size_t req_len;         // head plus body; anything after it is pipelined
+
+    char head[1024];        // serialized status line and headers
+    size_t head_len;
+    size_t head_off;        // bytes of head already sent
+
+    char *body;             // in-memory response body, owned when body_cap is set
+    struct cache_entry *entry; // cached file body points into, released when done
+    size_t body_cap;        // owned body: its owner->bufs capacity
+    size_t body_len;
+    size_t body_off;        // bytes of body already sent
+
+    int file_fd;            // file streamed after the head with sendfile, -1 if none
+    struct fd_entry *file_entry; // cached descriptor file_fd belongs to, released when done
+    off_t file_base;        // where the body starts in file_fd: 0, or its offset in the pack
+    off_t file_off;         // next byte of the file to send
+    off_t file_end;         // one past the last byte to send
+    int splice_pipe[2];     // kernel bounce buffer when sendfile is unsupported
+    size_t pipe_pending;    // bytes parked in splice_pipe, not yet on the socket
+    int corked;             // TCP_CORK set for a multipart body or a streaming CGI response
+
+    struct http_range ranges[MAX_RANGES]; // byte ranges of a 206, sent in order
+    int nranges;            // 0 unless this response is a 206
+    int range_next;         // next multipart part to queue; nranges is the closing boundary
+    const char *range_type; // Content-Type of each part
+    long long range_size;   // full length for Content-Range
+    unsigned long boundary; // multipart/byteranges separator
+
+    struct cgi_job *cgi;    // script answering this request, NULL if none
+
+    struct sockaddr_in peer; // client address, zeroed if unknown
+    struct access_record log; // this request's access log entry, pending while start is set
+
+    struct conn_io rx, tx;  // uring mode: receive and send in flight
+    struct iovec tx_iov[2]; // gather list of a pending sendmsg, which must outlive the call
+    struct msghdr tx_msg;
+    int closing;            // closed, freed once the ring gives back rx and tx
+};
 
 // Function prototypes for server operations
 
@@ -18,9 +203,26 @@ int create_socket(int port);
 // Handle incoming connections on the server socket
 void handle_connections(int server_sock);
 
+// Run a worker's event loop (epoll, or io_uring when configured) until shutdown is requested
+void run_event_loop(struct worker *w);
+
 // Process incoming HTTP requests
 void process_request(int client_sock);
 
+// Look up the connection owning a client socket (NULL if none)
+struct connection *conn_get(int fd);
+
+// Carry on with a connection whose CONN_WAITING response has been queued
+void conn_resume(struct connection *c);
+
+// Account for n response bytes written to the client socket
+void conn_sent(struct connection *c, size_t n);
+
+// read() and send() on a client socket; in uring mode EAGAIN means the
+// operation was submitted and the connection is driven again when it completes
+ssize_t conn_recv(struct connection *c, void *buf, size_t len);
+ssize_t conn_send(struct connection *c, const void *buf, size_t len);
+
 // Handle GET requests
 void handle_get_request(int client_sock, const char* path);
 
@@ -30,9 +232,18 @@ void handle_head_request(int client_sock, const char* path);
 // Handle POST requests
 void handle_post_request(int client_sock, const char* path);
 
-// Send an HTTP response to the client
+// Queue an HTTP response on the client's connection
 void send_response(int client_sock, const char *header, const char *content_type, const char *body, int body_length);
 
+// Reset a config to built-in defaults
+void config_defaults(struct server_config *c);
+
+// Apply one "key value" setting; returns -1 (after printing why) if it is rejected
+int config_set(struct server_config *c, const char *key, const char *value);
+
+// Apply every setting in a config file; returns -1 on the first bad line
+int config_load(struct server_config *c, const char *path);
+
 // Determine the MIME type based on the file extension
 const char* get_mime_type(const char *filename);
 
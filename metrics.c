@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stddef.h>
+#include "metrics.h"
+
+static const char *const method_names[HTTP_CONNECT + 1] = {
+    [HTTP_UNKNOWN] = "other",
+    [HTTP_GET] = "GET",
+    [HTTP_HEAD] = "HEAD",
+    [HTTP_POST] = "POST",
+    [HTTP_PUT] = "PUT",
+    [HTTP_DELETE] = "DELETE",
+    [HTTP_OPTIONS] = "OPTIONS",
+    [HTTP_PATCH] = "PATCH",
+    [HTTP_TRACE] = "TRACE",
+    [HTTP_CONNECT] = "CONNECT",
+};
+
+// Exclusive upper end of bucket i in microseconds
+static uint64_t bucket_limit(unsigned i) {
+    if (i < (1u << METRICS_SUB_BITS)) {
+        return i + 1;
+    }
+
+    unsigned shift = (i >> METRICS_SUB_BITS) - 1;
+    uint64_t step = (1u << METRICS_SUB_BITS) + (i & ((1u << METRICS_SUB_BITS) - 1));
+    return (step + 1) << shift;
+}
+
+static void render_histogram(FILE *f, const char *name, const char *help,
+                             const struct metrics *const *each, int n, size_t offset) {
+    unsigned long cumulative = 0, count = 0, sum_us = 0;
+
+    fprintf(f, "# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+    for (unsigned i = 0; i < METRICS_BUCKETS; i++) {
+        for (int w = 0; w < n; w++) {
+            const struct latency_histogram *h = (const void *)((const char *)each[w] + offset);
+            cumulative += COUNTER_READ(h->counts[i]);
+        }
+        fprintf(f, "%s_bucket{le=\"%g\"} %lu\n", name, bucket_limit(i) / 1e6, cumulative);
+    }
+    for (int w = 0; w < n; w++) {
+        const struct latency_histogram *h = (const void *)((const char *)each[w] + offset);
+        count += COUNTER_READ(h->count);
+        sum_us += COUNTER_READ(h->sum_us);
+    }
+    fprintf(f, "%s_bucket{le=\"+Inf\"} %lu\n%s_sum %.6f\n%s_count %lu\n",
+            name, count, name, sum_us / 1e6, name, count);
+}
+
+void metrics_render(FILE *f, const struct metrics *const *each, int n, const struct metrics_gauges *g) {
+    unsigned long bytes = 0;
+
+    fprintf(f, "# HELP http_requests_total Requests answered, by method.\n"
+               "# TYPE http_requests_total counter\n");
+    for (int m = 0; m <= HTTP_CONNECT; m++) {
+        unsigned long total = 0;
+
+        for (int w = 0; w < n; w++) {
+            total += COUNTER_READ(each[w]->requests[m]);
+        }
+        fprintf(f, "http_requests_total{method=\"%s\"} %lu\n", method_names[m], total);
+    }
+
+    fprintf(f, "# HELP http_responses_total Responses by status code, 0 for requests closed before one was sent.\n"
+               "# TYPE http_responses_total counter\n");
+    for (int s = 0; s < METRICS_STATUS_MAX; s++) {
+        unsigned long total = 0;
+
+        for (int w = 0; w < n; w++) {
+            total += COUNTER_READ(each[w]->status[s]);
+        }
+        if (total > 0) {//codes never sent are left out rather than listed as zero
+            fprintf(f, "http_responses_total{code=\"%d\"} %lu\n", s, total);
+        }
+    }
+
+    for (int w = 0; w < n; w++) {
+        bytes += COUNTER_READ(each[w]->bytes_sent);
+    }
+    fprintf(f, "# HELP http_response_bytes_total Bytes sent to clients, headers included, counted as responses end.\n"
+               "# TYPE http_response_bytes_total counter\n"
+               "http_response_bytes_total %lu\n", bytes);
+
+    fprintf(f, "# HELP http_connections_active Open client connections.\n"
+               "# TYPE http_connections_active gauge\n"
+               "http_connections_active %lu\n"
+               "# HELP http_connections_accepted_total Client connections accepted.\n"
+               "# TYPE http_connections_accepted_total counter\n"
+               "http_connections_accepted_total %lu\n",
+            g->connections, g->accepted);
+
+    unsigned long busy = 0, client = 0;
+    for (int w = 0; w < n; w++) {
+        busy += COUNTER_READ(each[w]->refused_busy);
+        client += COUNTER_READ(each[w]->refused_client);
+    }
+    fprintf(f, "# HELP http_connections_refused_total Connections answered and closed at accept by admission control.\n"
+               "# TYPE http_connections_refused_total counter\n"
+               "http_connections_refused_total{reason=\"max_connections\"} %lu\n"
+               "http_connections_refused_total{reason=\"max_connections_per_ip\"} %lu\n",
+            busy, client);
+
+    unsigned long lookups = g->cache_hits + g->cache_misses;
+    fprintf(f, "# HELP file_cache_hits_total File cache lookups that found a fresh entry.\n"
+               "# TYPE file_cache_hits_total counter\n"
+               "file_cache_hits_total %lu\n"
+               "# HELP file_cache_misses_total File cache lookups that had to go to the file.\n"
+               "# TYPE file_cache_misses_total counter\n"
+               "file_cache_misses_total %lu\n"
+               "# HELP file_cache_hit_ratio Share of file cache lookups that hit, since startup.\n"
+               "# TYPE file_cache_hit_ratio gauge\n"
+               "file_cache_hit_ratio %g\n",
+            g->cache_hits, g->cache_misses, lookups ? (double)g->cache_hits / lookups : 0.0);
+
+    fprintf(f, "# HELP fd_cache_hits_total File opens, failed ones included, answered by the descriptor cache.\n"
+               "# TYPE fd_cache_hits_total counter\n"
+               "fd_cache_hits_total %lu\n"
+               "# HELP fd_cache_misses_total File opens that had to walk the path.\n"
+               "# TYPE fd_cache_misses_total counter\n"
+               "fd_cache_misses_total %lu\n",
+            g->fd_cache_hits, g->fd_cache_misses);
+
+    fprintf(f, "# HELP access_log_dropped_total Access log records lost because a ring was full.\n"
+               "# TYPE access_log_dropped_total counter\n"
+               "access_log_dropped_total %lu\n", g->log_dropped);
+
+    fprintf(f, "# HELP memory_pool_bytes Memory the workers' connection, buffer and scratch pools took from the system.\n"
+               "# TYPE memory_pool_bytes gauge\n"
+               "memory_pool_bytes %lu\n", g->pool_bytes);
+
+    render_histogram(f, "http_first_byte_seconds",
+                     "Time from request arrival (accept for a connection's first request) to the first response byte.",
+                     each, n, offsetof(struct metrics, first_byte));
+    render_histogram(f, "http_request_duration_seconds",
+                     "Time from request arrival (accept for a connection's first request) to the end of the response.",
+                     each, n, offsetof(struct metrics, total));
+}
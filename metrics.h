@@ -0,0 +1,87 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "parser.h"
+
+// Request metrics. Every worker counts its own requests in a private
+// struct metrics with plain relaxed stores; nothing is shared or locked on
+// the request path. A scrape of /__metrics sums all workers' copies.
+
+// Bump a counter owned by the calling thread; other threads only ever read it
+#define COUNTER_ADD(var, n) __atomic_store_n(&(var), (var) + (n), __ATOMIC_RELAXED)
+#define COUNTER_READ(var) __atomic_load_n(&(var), __ATOMIC_RELAXED)
+
+// Latency buckets in the HDR histogram layout: each power of two of
+// microseconds is split into 2^METRICS_SUB_BITS linear steps, so every
+// bucket is within 12.5% of its value. Values of 2^METRICS_MAX_BITS us
+// (about 4.5 minutes) and more only count towards +Inf.
+#define METRICS_SUB_BITS 3
+#define METRICS_MAX_BITS 28
+#define METRICS_BUCKETS ((METRICS_MAX_BITS - METRICS_SUB_BITS + 1) << METRICS_SUB_BITS)
+#define METRICS_STATUS_MAX 600  // status codes counted individually, the rest as 0
+
+struct latency_histogram {
+    unsigned long counts[METRICS_BUCKETS + 1]; // last one is overflow
+    unsigned long count;
+    unsigned long sum_us;
+};
+
+// One worker's counters
+struct metrics {
+    unsigned long requests[HTTP_CONNECT + 1];   // by enum http_method
+    unsigned long status[METRICS_STATUS_MAX];   // by status code, 0 if none was sent
+    unsigned long bytes_sent;
+    unsigned long refused_busy;     // connections turned away at accept: max_connections reached
+    unsigned long refused_client;   // and max_connections_per_ip reached
+    struct latency_histogram first_byte;        // request arrival to first response byte
+    struct latency_histogram total;             // request arrival to end of response
+};
+
+// Bucket of a latency in microseconds
+static inline unsigned histogram_bucket(uint64_t us) {
+    if (us < (1u << METRICS_SUB_BITS)) {
+        return (unsigned)us;
+    }
+
+    unsigned e = 63 - __builtin_clzll(us);//us >= 2^e, e >= METRICS_SUB_BITS
+    unsigned i = ((e - METRICS_SUB_BITS + 1) << METRICS_SUB_BITS) +
+                 ((us >> (e - METRICS_SUB_BITS)) & ((1u << METRICS_SUB_BITS) - 1));
+    return i < METRICS_BUCKETS ? i : METRICS_BUCKETS;
+}
+
+static inline void histogram_record(struct latency_histogram *h, uint64_t us) {
+    unsigned i = histogram_bucket(us);
+
+    COUNTER_ADD(h->counts[i], 1);
+    COUNTER_ADD(h->count, 1);
+    COUNTER_ADD(h->sum_us, us);
+}
+
+// Count a finished request
+static inline void metrics_request(struct metrics *m, enum http_method method, unsigned status,
+                                   uint64_t bytes, uint64_t total_us) {
+    COUNTER_ADD(m->requests[method], 1);
+    COUNTER_ADD(m->status[status < METRICS_STATUS_MAX ? status : 0], 1);
+    COUNTER_ADD(m->bytes_sent, bytes);
+    histogram_record(&m->total, total_us);
+}
+
+// Server-wide gauges sampled at scrape time
+struct metrics_gauges {
+    unsigned long connections;  // open client connections
+    unsigned long accepted;     // connections accepted so far
+    unsigned long cache_hits;
+    unsigned long cache_misses;
+    unsigned long fd_cache_hits;  // opens answered by the descriptor cache
+    unsigned long fd_cache_misses;
+    unsigned long log_dropped;  // access log records lost to full rings
+    unsigned long pool_bytes;   // held by the workers' memory pools
+};
+
+// Write the sum of n workers' metrics and the gauges to f in the
+// Prometheus text exposition format
+void metrics_render(FILE *f, const struct metrics *const *each, int n, const struct metrics_gauges *g);
+
+#endif // METRICS_H
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "mime.h"
+#include "mime_table.h"
+
+// Entries from mime_load(), open addressing on mime_hash(); empty until then
+struct mime_override {
+    char *ext;
+    size_t len;
+    char *type;
+};
+
+static struct mime_override *overrides;
+static uint32_t override_mask;  // table size - 1, 0 while there is none
+
+static const char *find_override(const char *ext, size_t len) {
+    for (uint32_t i = mime_hash(ext, len, 0) & override_mask;; i = (i + 1) & override_mask) {
+        const struct mime_override *o = &overrides[i];
+
+        if (o->ext == NULL) {
+            return NULL;
+        }
+        if (o->len == len && strncasecmp(o->ext, ext, len) == 0) {
+            return o->type;
+        }
+    }
+}
+
+const char *mime_lookup(const char *ext, size_t len) {
+    if (len == 0 || len > MIME_MAX_EXT) {
+        return NULL;
+    }
+    if (override_mask != 0) {
+        const char *type = find_override(ext, len);
+        if (type != NULL) {
+            return type;
+        }
+    }
+
+    uint32_t seed = mime_disp[mime_hash(ext, len, 0) & (MIME_BUCKETS - 1)];
+    const struct mime_slot *s = &mime_slots[mime_hash(ext, len, seed) & (MIME_SLOTS - 1)];
+
+    if (s->len == len && strncasecmp(s->ext, ext, len) == 0) {
+        return mime_names[s->type];
+    }
+    return NULL;
+}
+
+// Add one override unless the file already named the extension
+static int add_override(struct mime_override *table, uint32_t mask, const char *ext, const char *type) {
+    size_t len = strlen(ext);
+    uint32_t i = mime_hash(ext, len, 0) & mask;
+
+    while (table[i].ext != NULL) {
+        if (table[i].len == len && strcasecmp(table[i].ext, ext) == 0) {
+            return 0;//first one wins, as in mimegen
+        }
+        i = (i + 1) & mask;
+    }
+    table[i].ext = strdup(ext);
+    table[i].len = len;
+    table[i].type = strdup(type);
+    return table[i].ext != NULL && table[i].type != NULL ? 0 : -1;
+}
+
+int mime_load(const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[1024];
+    size_t count = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {//first pass sizes the table
+        char *save, *tok = line[0] == '#' ? NULL : strtok_r(line, " \t\r\n", &save);
+
+        while (tok != NULL && (tok = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+            count++;
+        }
+    }
+
+    uint32_t size = 16;
+    while (size < count * 2) {
+        size <<= 1;
+    }
+    struct mime_override *table = calloc(size, sizeof(*table));
+    if (table == NULL) {
+        fclose(f);
+        return -1;
+    }
+
+    rewind(f);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *save, *type = line[0] == '#' ? NULL : strtok_r(line, " \t\r\n", &save);
+        char *ext;
+
+        while (type != NULL && (ext = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+            if (strlen(ext) <= MIME_MAX_EXT && add_override(table, size - 1, ext, type) < 0) {
+                fclose(f);
+                return -1;
+            }
+        }
+    }
+    fclose(f);
+
+    overrides = table;
+    override_mask = size - 1;
+    return 0;
+}
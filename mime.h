@@ -0,0 +1,47 @@
+#ifndef MIME_H
+#define MIME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Extension to media type lookup. The built-in table is a perfect hash
+// generated from mime.types into mime_table.h:
+//
+//   cc -O2 -o mimegen mimegen.c && ./mimegen mime.types > mime_table.h
+//
+// Each extension hashes to a bucket whose displacement sends it to a slot of
+// its own, so a lookup is two hashes and one comparison however many types
+// there are.
+
+#define MIME_MAX_EXT 31 // longer extensions are never looked up
+
+// FNV-1a over the ASCII-lowercased extension, then a murmur3 finalizer so
+// different seeds give independent slots. Shared with mimegen.
+static inline uint32_t mime_hash(const char *ext, size_t len, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+
+    for (size_t i = 0; i < len; i++) {
+        unsigned char ch = ext[i];
+
+        if (ch >= 'A' && ch <= 'Z') {
+            ch += 'a' - 'A';
+        }
+        h = (h ^ ch) * 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Media type for an extension (without the dot, any case), or NULL.
+// Types from mime_load() take precedence over the built-in table.
+const char *mime_lookup(const char *ext, size_t len);
+
+// Read a mime.types style file whose entries override the built-in table.
+// Call before any worker runs; returns -1 (after printing why) on failure.
+int mime_load(const char *path);
+
+#endif // MIME_H
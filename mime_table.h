@@ -0,0 +1,2775 @@
+// Generated by mimegen from mime.types, do not edit.
+// 1518 extensions, 1195 types
+
+#define MIME_BUCKETS 512
+#define MIME_SLOTS 2048
+
+static const char *const mime_names[1195] = {
+    "application/A2L",
+    "application/AML",
+    "application/andrew-inset",
+    "application/annodex",
+    "application/ATF",
+    "application/ATFX",
+    "application/atom+xml",
+    "application/atomcat+xml",
+    "application/atomdeleted+xml",
+    "application/atomserv+xml",
+    "application/atomsvc+xml",
+    "application/atsc-dwd+xml",
+    "application/atsc-held+xml",
+    "application/atsc-rsat+xml",
+    "application/ATXML",
+    "application/auth-policy+xml",
+    "application/automationml-amlx+zip",
+    "application/bacnet-xdd+zip",
+    "application/bbolin",
+    "application/calendar+xml",
+    "application/cbor",
+    "application/cccex",
+    "application/ccmp+xml",
+    "application/ccxml+xml",
+    "application/CDFX+XML",
+    "application/cdmi-capability",
+    "application/cdmi-container",
+    "application/cdmi-domain",
+    "application/cdmi-object",
+    "application/cdmi-queue",
+    "application/CEA",
+    "application/cellml+xml",
+    "application/clr",
+    "application/clue_info+xml",
+    "application/cms",
+    "application/cpl+xml",
+    "application/csrattrs",
+    "application/cu-seeme",
+    "application/cwl",
+    "application/dash+xml",
+    "application/dashdelta",
+    "application/davmount+xml",
+    "application/DCD",
+    "application/dicom",
+    "application/DII",
+    "application/DIT",
+    "application/dskpp+xml",
+    "application/dsptype",
+    "application/dssc+der",
+    "application/dssc+xml",
+    "application/dvcs",
+    "application/efi",
+    "application/emma+xml",
+    "application/emotionml+xml",
+    "application/epub+zip",
+    "application/exi",
+    "application/express",
+    "application/fastinfoset",
+    "application/fdf",
+    "application/fdt+xml",
+    "application/font-tdpfr",
+    "application/futuresplash",
+    "application/geo+json",
+    "application/geopackage+sqlite3",
+    "application/gltf-buffer",
+    "application/gml+xml",
+    "application/gzip",
+    "application/hta",
+    "application/hyperstudio",
+    "application/inkml+xml",
+    "application/ipfix",
+    "application/its+xml",
+    "application/java-archive",
+    "application/java-serialized-object",
+    "application/java-vm",
+    "application/jrd+json",
+    "application/json",
+    "application/json-patch+json",
+    "application/ld+json",
+    "application/lgr+xml",
+    "application/link-format",
+    "application/lost+xml",
+    "application/lostsync+xml",
+    "application/lpf+zip",
+    "application/LXF",
+    "application/m3g",
+    "application/mac-binhex40",
+    "application/mac-compactpro",
+    "application/mads+xml",
+    "application/manifest+json",
+    "application/marc",
+    "application/marcxml+xml",
+    "application/mathematica",
+    "application/mathml+xml",
+    "application/mbox",
+    "application/metalink4+xml",
+    "application/mets+xml",
+    "application/MF4",
+    "application/mmt-aei+xml",
+    "application/mmt-usd+xml",
+    "application/mods+xml",
+    "application/mp21",
+    "application/msaccess",
+    "application/msword",
+    "application/mxf",
+    "application/n-quads",
+    "application/n-triples",
+    "application/ocsp-request",
+    "application/ocsp-response",
+    "application/octet-stream",
+    "application/ODA",
+    "application/ODX",
+    "application/oebps-package+xml",
+    "application/ogg",
+    "application/onenote",
+    "application/oxps",
+    "application/p21",
+    "application/p2p-overlay+xml",
+    "application/pdf",
+    "application/PDX",
+    "application/pem-certificate-chain",
+    "application/pgp-encrypted",
+    "application/pgp-keys",
+    "application/pgp-signature",
+    "application/pics-rules",
+    "application/pkcs10",
+    "application/pkcs12",
+    "application/pkcs7-mime",
+    "application/pkcs7-signature",
+    "application/pkcs8",
+    "application/pkcs8-encrypted",
+    "application/pkix-attr-cert",
+    "application/pkix-cert",
+    "application/pkix-crl",
+    "application/pkix-pkipath",
+    "application/pkixcmp",
+    "application/postscript",
+    "application/provenance+xml",
+    "application/prs.cww",
+    "application/prs.hpub+zip",
+    "application/prs.nprend",
+    "application/prs.rdf-xml-crypt",
+    "application/prs.xsf+xml",
+    "application/pskc+xml",
+    "application/rdf+xml",
+    "application/reginfo+xml",
+    "application/relax-ng-compact-syntax",
+    "application/resource-lists+xml",
+    "application/resource-lists-diff+xml",
+    "application/rfc+xml",
+    "application/rls-services+xml",
+    "application/route-apd+xml",
+    "application/route-s-tsid+xml",
+    "application/route-usd+xml",
+    "application/rpki-ghostbusters",
+    "application/rpki-manifest",
+    "application/rpki-roa",
+    "application/rtf",
+    "application/sarif+json",
+    "application/sarif-external-properties+json",
+    "application/scim+json",
+    "application/scvp-cv-request",
+    "application/scvp-cv-response",
+    "application/scvp-vp-request",
+    "application/scvp-vp-response",
+    "application/sdp",
+    "application/senml+cbor",
+    "application/senml+json",
+    "application/senml+xml",
+    "application/senml-etch+cbor",
+    "application/senml-etch+json",
+    "application/senml-exi",
+    "application/sensml+cbor",
+    "application/sensml+json",
+    "application/sensml+xml",
+    "application/sensml-exi",
+    "application/sgml-open-catalog",
+    "application/shf+xml",
+    "application/sieve",
+    "application/simple-filter+xml",
+    "application/smil+xml",
+    "application/sparql-query",
+    "application/sparql-results+xml",
+    "application/sql",
+    "application/srgs",
+    "application/srgs+xml",
+    "application/sru+xml",
+    "application/ssml+xml",
+    "application/stix+json",
+    "application/swid+cbor",
+    "application/swid+xml",
+    "application/tamp-apex-update",
+    "application/tamp-apex-update-confirm",
+    "application/tamp-community-update",
+    "application/tamp-community-update-confirm",
+    "application/tamp-error",
+    "application/tamp-sequence-adjust",
+    "application/tamp-sequence-adjust-confirm",
+    "application/tamp-update",
+    "application/tamp-update-confirm",
+    "application/td+json",
+    "application/tei+xml",
+    "application/thraud+xml",
+    "application/timestamp-query",
+    "application/timestamp-reply",
+    "application/timestamped-data",
+    "application/tm+json",
+    "application/trig",
+    "application/ttml+xml",
+    "application/urc-grpsheet+xml",
+    "application/urc-ressheet+xml",
+    "application/urc-targetdesc+xml",
+    "application/urc-uisocketdesc+xml",
+    "application/vnd.1000minds.decision-model+xml",
+    "application/vnd.3gpp.pic-bw-large",
+    "application/vnd.3gpp.pic-bw-small",
+    "application/vnd.3gpp.pic-bw-var",
+    "application/vnd.3gpp2.sms",
+    "application/vnd.3gpp2.tcap",
+    "application/vnd.3lightssoftware.imagescal",
+    "application/vnd.3M.Post-it-Notes",
+    "application/vnd.accpac.simply.aso",
+    "application/vnd.accpac.simply.imp",
+    "application/vnd.acucobol",
+    "application/vnd.acucorp",
+    "application/vnd.adobe.flash.movie",
+    "application/vnd.adobe.formscentral.fcdt",
+    "application/vnd.adobe.fxp",
+    "application/vnd.adobe.xdp+xml",
+    "application/vnd.afpc.modca",
+    "application/vnd.afpc.modca-overlay",
+    "application/vnd.afpc.modca-pagesegment",
+    "application/vnd.age",
+    "application/vnd.ahead.space",
+    "application/vnd.airzip.filesecure.azf",
+    "application/vnd.airzip.filesecure.azs",
+    "application/vnd.amazon.mobi8-ebook",
+    "application/vnd.americandynamics.acc",
+    "application/vnd.amiga.ami",
+    "application/vnd.android.ota",
+    "application/vnd.android.package-archive",
+    "application/vnd.anki",
+    "application/vnd.anser-web-certificate-issue-initiation",
+    "application/vnd.anser-web-funds-transfer-initiation",
+    "application/vnd.apache.arrow.file",
+    "application/vnd.apache.arrow.stream",
+    "application/vnd.apexlang",
+    "application/vnd.apple.installer+xml",
+    "application/vnd.apple.keynote",
+    "application/vnd.apple.mpegurl",
+    "application/vnd.apple.numbers",
+    "application/vnd.apple.pages",
+    "application/vnd.aristanetworks.swi",
+    "application/vnd.artisan+json",
+    "application/vnd.astraea-software.iota",
+    "application/vnd.audiograph",
+    "application/vnd.autopackage",
+    "application/vnd.balsamiq.bmml+xml",
+    "application/vnd.balsamiq.bmpr",
+    "application/vnd.banana-accounting",
+    "application/vnd.belightsoft.lhzd+zip",
+    "application/vnd.belightsoft.lhzl+zip",
+    "application/vnd.blueice.multipass",
+    "application/vnd.bluetooth.ep.oob",
+    "application/vnd.bluetooth.le.oob",
+    "application/vnd.bmi",
+    "application/vnd.businessobjects",
+    "application/vnd.cendio.thinlinc.clientconf",
+    "application/vnd.chemdraw+xml",
+    "application/vnd.chess-pgn",
+    "application/vnd.chipnuts.karaoke-mmd",
+    "application/vnd.cinderella",
+    "application/vnd.citationstyles.style+xml",
+    "application/vnd.claymore",
+    "application/vnd.cloanto.rp9",
+    "application/vnd.clonk.c4group",
+    "application/vnd.cluetrust.cartomobile-config",
+    "application/vnd.cluetrust.cartomobile-config-pkg",
+    "application/vnd.coffeescript",
+    "application/vnd.collabio.xodocuments.document",
+    "application/vnd.collabio.xodocuments.document-template",
+    "application/vnd.collabio.xodocuments.presentation",
+    "application/vnd.collabio.xodocuments.presentation-template",
+    "application/vnd.collabio.xodocuments.spreadsheet",
+    "application/vnd.collabio.xodocuments.spreadsheet-template",
+    "application/vnd.comicbook+zip",
+    "application/vnd.comicbook-rar",
+    "application/vnd.commerce-battelle",
+    "application/vnd.commonspace",
+    "application/vnd.contact.cmsg",
+    "application/vnd.coreos.ignition+json",
+    "application/vnd.cosmocaller",
+    "application/vnd.crick.clicker",
+    "application/vnd.crick.clicker.keyboard",
+    "application/vnd.crick.clicker.palette",
+    "application/vnd.crick.clicker.template",
+    "application/vnd.crick.clicker.wordbank",
+    "application/vnd.criticaltools.wbs+xml",
+    "application/vnd.crypto-shade-file",
+    "application/vnd.cryptomator.encrypted",
+    "application/vnd.cryptomator.vault",
+    "application/vnd.ctc-posml",
+    "application/vnd.cups-ppd",
+    "application/vnd.dart",
+    "application/vnd.data-vision.rdz",
+    "application/vnd.datalog",
+    "application/vnd.dbf",
+    "application/vnd.debian.binary-package",
+    "application/vnd.dece.data",
+    "application/vnd.dece.ttml+xml",
+    "application/vnd.dece.unspecified",
+    "application/vnd.dece.zip",
+    "application/vnd.denovo.fcselayout-link",
+    "application/vnd.desmume.movie",
+    "application/vnd.dna",
+    "application/vnd.document+json",
+    "application/vnd.doremir.scorecloud-binary-document",
+    "application/vnd.dpgraph",
+    "application/vnd.dreamfactory",
+    "application/vnd.dtg.local.flash",
+    "application/vnd.dvb.ait",
+    "application/vnd.dvb.service",
+    "application/vnd.dynageo",
+    "application/vnd.dzr",
+    "application/vnd.ecowin.chart",
+    "application/vnd.eln+zip",
+    "application/vnd.enliven",
+    "application/vnd.epson.esf",
+    "application/vnd.epson.msf",
+    "application/vnd.epson.quickanime",
+    "application/vnd.epson.salt",
+    "application/vnd.epson.ssf",
+    "application/vnd.ericsson.quickcall",
+    "application/vnd.espass-espass+zip",
+    "application/vnd.eszigno3+xml",
+    "application/vnd.etsi.asic-e+zip",
+    "application/vnd.etsi.asic-s+zip",
+    "application/vnd.etsi.timestamp-token",
+    "application/vnd.eu.kasparian.car+json",
+    "application/vnd.evolv.ecig.profile",
+    "application/vnd.evolv.ecig.settings",
+    "application/vnd.evolv.ecig.theme",
+    "application/vnd.exstream-empower+zip",
+    "application/vnd.exstream-package",
+    "application/vnd.ezpix-album",
+    "application/vnd.ezpix-package",
+    "application/vnd.familysearch.gedcom+zip",
+    "application/vnd.fastcopy-disk-image",
+    "application/vnd.fdsn.mseed",
+    "application/vnd.fdsn.seed",
+    "application/vnd.ficlab.flb+zip",
+    "application/vnd.filmit.zfc",
+    "application/vnd.FloGraphIt",
+    "application/vnd.fluxtime.clip",
+    "application/vnd.font-fontforge-sfd",
+    "application/vnd.framemaker",
+    "application/vnd.fsc.weblaunch",
+    "application/vnd.fujitsu.oasys",
+    "application/vnd.fujitsu.oasys2",
+    "application/vnd.fujitsu.oasys3",
+    "application/vnd.fujitsu.oasysgp",
+    "application/vnd.fujitsu.oasysprs",
+    "application/vnd.fujixerox.ddd",
+    "application/vnd.fujixerox.docuworks",
+    "application/vnd.fujixerox.docuworks.binder",
+    "application/vnd.fujixerox.docuworks.container",
+    "application/vnd.fuzzysheet",
+    "application/vnd.genomatix.tuxedo",
+    "application/vnd.genozip",
+    "application/vnd.gentics.grd+json",
+    "application/vnd.gentoo.ebuild",
+    "application/vnd.gentoo.eclass",
+    "application/vnd.gentoo.xpak",
+    "application/vnd.geogebra.file",
+    "application/vnd.geogebra.slides",
+    "application/vnd.geogebra.tool",
+    "application/vnd.geometry-explorer",
+    "application/vnd.geonext",
+    "application/vnd.geoplan",
+    "application/vnd.geospace",
+    "application/vnd.google-earth.kml+xml",
+    "application/vnd.google-earth.kmz",
+    "application/vnd.grafeq",
+    "application/vnd.groove-account",
+    "application/vnd.groove-help",
+    "application/vnd.groove-identity-message",
+    "application/vnd.groove-injector",
+    "application/vnd.groove-tool-message",
+    "application/vnd.groove-tool-template",
+    "application/vnd.groove-vcard",
+    "application/vnd.hal+xml",
+    "application/vnd.HandHeld-Entertainment+xml",
+    "application/vnd.hbci",
+    "application/vnd.hdt",
+    "application/vnd.hhe.lesson-player",
+    "application/vnd.hp-HPGL",
+    "application/vnd.hp-hpid",
+    "application/vnd.hp-hps",
+    "application/vnd.hp-jlyt",
+    "application/vnd.hp-PCL",
+    "application/vnd.hydrostatix.sof-data",
+    "application/vnd.ibm.electronic-media",
+    "application/vnd.ibm.MiniPay",
+    "application/vnd.ibm.rights-management",
+    "application/vnd.ibm.secure-container",
+    "application/vnd.iccprofile",
+    "application/vnd.igloader",
+    "application/vnd.imagemeter.folder+zip",
+    "application/vnd.imagemeter.image+zip",
+    "application/vnd.immervision-ivp",
+    "application/vnd.immervision-ivu",
+    "application/vnd.ims.imsccv1p1",
+    "application/vnd.insors.igm",
+    "application/vnd.intercon.formnet",
+    "application/vnd.intergeo",
+    "application/vnd.intu.qbo",
+    "application/vnd.intu.qfx",
+    "application/vnd.ipld.car",
+    "application/vnd.ipunplugged.rcprofile",
+    "application/vnd.irepository.package+xml",
+    "application/vnd.is-xpr",
+    "application/vnd.isac.fcs",
+    "application/vnd.jam",
+    "application/vnd.jcp.javame.midlet-rms",
+    "application/vnd.jisp",
+    "application/vnd.joost.joda-archive",
+    "application/vnd.kahootz",
+    "application/vnd.kde.karbon",
+    "application/vnd.kde.kchart",
+    "application/vnd.kde.kformula",
+    "application/vnd.kde.kivio",
+    "application/vnd.kde.kontour",
+    "application/vnd.kde.kpresenter",
+    "application/vnd.kde.kspread",
+    "application/vnd.kde.kword",
+    "application/vnd.kenameaapp",
+    "application/vnd.kidspiration",
+    "application/vnd.Kinar",
+    "application/vnd.koan",
+    "application/vnd.kodak-descriptor",
+    "application/vnd.las",
+    "application/vnd.las.las+json",
+    "application/vnd.las.las+xml",
+    "application/vnd.llamagraphics.life-balance.desktop",
+    "application/vnd.llamagraphics.life-balance.exchange+xml",
+    "application/vnd.logipipe.circuit+zip",
+    "application/vnd.loom",
+    "application/vnd.lotus-1-2-3",
+    "application/vnd.lotus-approach",
+    "application/vnd.lotus-freelance",
+    "application/vnd.lotus-notes",
+    "application/vnd.lotus-organizer",
+    "application/vnd.lotus-screencam",
+    "application/vnd.lotus-wordpro",
+    "application/vnd.macports.portpkg",
+    "application/vnd.mapbox-vector-tile",
+    "application/vnd.marlin.drm.mdcf",
+    "application/vnd.maxar.archive.3tz+zip",
+    "application/vnd.maxmind.maxmind-db",
+    "application/vnd.mcd",
+    "application/vnd.medcalcdata",
+    "application/vnd.mediastation.cdkey",
+    "application/vnd.medicalholodeck.recordxr",
+    "application/vnd.MFER",
+    "application/vnd.mfmp",
+    "application/vnd.micrografx.flo",
+    "application/vnd.micrografx.igx",
+    "application/vnd.mif",
+    "application/vnd.Mobius.DAF",
+    "application/vnd.Mobius.DIS",
+    "application/vnd.Mobius.MBK",
+    "application/vnd.Mobius.MQY",
+    "application/vnd.Mobius.MSL",
+    "application/vnd.Mobius.PLC",
+    "application/vnd.Mobius.TXF",
+    "application/vnd.mophun.application",
+    "application/vnd.mophun.certificate",
+    "application/vnd.mozilla.xul+xml",
+    "application/vnd.ms-3mfdocument",
+    "application/vnd.ms-artgalry",
+    "application/vnd.ms-asf",
+    "application/vnd.ms-cab-compressed",
+    "application/vnd.ms-excel",
+    "application/vnd.ms-excel.addin.macroEnabled.12",
+    "application/vnd.ms-excel.sheet.binary.macroEnabled.12",
+    "application/vnd.ms-excel.sheet.macroEnabled.12",
+    "application/vnd.ms-excel.template.macroEnabled.12",
+    "application/vnd.ms-fontobject",
+    "application/vnd.ms-htmlhelp",
+    "application/vnd.ms-ims",
+    "application/vnd.ms-lrm",
+    "application/vnd.ms-officetheme",
+    "application/vnd.ms-pki.seccat",
+    "application/vnd.ms-powerpoint",
+    "application/vnd.ms-powerpoint.addin.macroEnabled.12",
+    "application/vnd.ms-powerpoint.presentation.macroEnabled.12",
+    "application/vnd.ms-powerpoint.slide.macroEnabled.12",
+    "application/vnd.ms-powerpoint.slideshow.macroEnabled.12",
+    "application/vnd.ms-powerpoint.template.macroEnabled.12",
+    "application/vnd.ms-project",
+    "application/vnd.ms-tnef",
+    "application/vnd.ms-word.document.macroEnabled.12",
+    "application/vnd.ms-word.template.macroEnabled.12",
+    "application/vnd.ms-works",
+    "application/vnd.ms-wpl",
+    "application/vnd.ms-xpsdocument",
+    "application/vnd.msa-disk-image",
+    "application/vnd.mseq",
+    "application/vnd.multiad.creator",
+    "application/vnd.multiad.creator.cif",
+    "application/vnd.musician",
+    "application/vnd.muvee.style",
+    "application/vnd.mynfc",
+    "application/vnd.nebumind.line",
+    "application/vnd.nervana",
+    "application/vnd.neurolanguage.nlu",
+    "application/vnd.nimn",
+    "application/vnd.nintendo.nitro.rom",
+    "application/vnd.nintendo.snes.rom",
+    "application/vnd.nitf",
+    "application/vnd.noblenet-directory",
+    "application/vnd.noblenet-sealer",
+    "application/vnd.noblenet-web",
+    "application/vnd.nokia.n-gage.data",
+    "application/vnd.nokia.radio-preset",
+    "application/vnd.nokia.radio-presets",
+    "application/vnd.novadigm.EDM",
+    "application/vnd.novadigm.EDX",
+    "application/vnd.novadigm.EXT",
+    "application/vnd.oasis.opendocument.base",
+    "application/vnd.oasis.opendocument.chart",
+    "application/vnd.oasis.opendocument.chart-template",
+    "application/vnd.oasis.opendocument.formula",
+    "application/vnd.oasis.opendocument.graphics",
+    "application/vnd.oasis.opendocument.graphics-template",
+    "application/vnd.oasis.opendocument.image",
+    "application/vnd.oasis.opendocument.image-template",
+    "application/vnd.oasis.opendocument.presentation",
+    "application/vnd.oasis.opendocument.presentation-template",
+    "application/vnd.oasis.opendocument.spreadsheet",
+    "application/vnd.oasis.opendocument.spreadsheet-template",
+    "application/vnd.oasis.opendocument.text",
+    "application/vnd.oasis.opendocument.text-master",
+    "application/vnd.oasis.opendocument.text-template",
+    "application/vnd.oasis.opendocument.text-web",
+    "application/vnd.olpc-sugar",
+    "application/vnd.oma.dd2+xml",
+    "application/vnd.onepager",
+    "application/vnd.onepagertamp",
+    "application/vnd.onepagertamx",
+    "application/vnd.onepagertat",
+    "application/vnd.onepagertatp",
+    "application/vnd.onepagertatx",
+    "application/vnd.openblox.game+xml",
+    "application/vnd.openblox.game-binary",
+    "application/vnd.openeye.oeb",
+    "application/vnd.openofficeorg.extension",
+    "application/vnd.openstreetmap.data+xml",
+    "application/vnd.openxmlformats-officedocument.presentationml.presentation",
+    "application/vnd.openxmlformats-officedocument.presentationml.slide",
+    "application/vnd.openxmlformats-officedocument.presentationml.slideshow",
+    "application/vnd.openxmlformats-officedocument.presentationml.template",
+    "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet",
+    "application/vnd.openxmlformats-officedocument.spreadsheetml.template",
+    "application/vnd.openxmlformats-officedocument.wordprocessingml.document",
+    "application/vnd.openxmlformats-officedocument.wordprocessingml.template",
+    "application/vnd.osa.netdeploy",
+    "application/vnd.osgeo.mapguide.package",
+    "application/vnd.osgi.dp",
+    "application/vnd.osgi.subsystem",
+    "application/vnd.oxli.countgraph",
+    "application/vnd.palm",
+    "application/vnd.panoply",
+    "application/vnd.patentdive",
+    "application/vnd.pawaafile",
+    "application/vnd.pg.format",
+    "application/vnd.pg.osasli",
+    "application/vnd.piaccess.application-licence",
+    "application/vnd.picsel",
+    "application/vnd.pmi.widget",
+    "application/vnd.pocketlearn",
+    "application/vnd.powerbuilder6",
+    "application/vnd.preminet",
+    "application/vnd.previewsystems.box",
+    "application/vnd.proteus.magazine",
+    "application/vnd.psfs",
+    "application/vnd.publishare-delta-tree",
+    "application/vnd.pvi.ptid1",
+    "application/vnd.qualcomm.brew-app-res",
+    "application/vnd.Quark.QuarkXPress",
+    "application/vnd.quobject-quoxdocument",
+    "application/vnd.rainstor.data",
+    "application/vnd.rar",
+    "application/vnd.realvnc.bed",
+    "application/vnd.recordare.musicxml",
+    "application/vnd.resilient.logic",
+    "application/vnd.rig.cryptonote",
+    "application/vnd.rim.cod",
+    "application/vnd.route66.link66+xml",
+    "application/vnd.sailingtracker.track",
+    "application/vnd.sar",
+    "application/vnd.scribus",
+    "application/vnd.sealed.3df",
+    "application/vnd.sealed.csf",
+    "application/vnd.sealed.doc",
+    "application/vnd.sealed.eml",
+    "application/vnd.sealed.mht",
+    "application/vnd.sealed.ppt",
+    "application/vnd.sealed.tiff",
+    "application/vnd.sealed.xls",
+    "application/vnd.sealedmedia.softseal.html",
+    "application/vnd.sealedmedia.softseal.pdf",
+    "application/vnd.seemail",
+    "application/vnd.sema",
+    "application/vnd.semd",
+    "application/vnd.semf",
+    "application/vnd.shade-save-file",
+    "application/vnd.shana.informed.formdata",
+    "application/vnd.shana.informed.formtemplate",
+    "application/vnd.shana.informed.interchange",
+    "application/vnd.shana.informed.package",
+    "application/vnd.shp",
+    "application/vnd.shx",
+    "application/vnd.sigrok.session",
+    "application/vnd.SimTech-MindMapper",
+    "application/vnd.smaf",
+    "application/vnd.smart.notebook",
+    "application/vnd.smart.teacher",
+    "application/vnd.snesdev-page-table",
+    "application/vnd.software602.filler.form+xml",
+    "application/vnd.software602.filler.form-xml-zip",
+    "application/vnd.solent.sdkm+xml",
+    "application/vnd.spotfire.dxp",
+    "application/vnd.spotfire.sfs",
+    "application/vnd.sqlite3",
+    "application/vnd.stardivision.calc",
+    "application/vnd.stardivision.chart",
+    "application/vnd.stardivision.draw",
+    "application/vnd.stardivision.impress",
+    "application/vnd.stardivision.math",
+    "application/vnd.stardivision.writer",
+    "application/vnd.stardivision.writer-global",
+    "application/vnd.stepmania.package",
+    "application/vnd.stepmania.stepchart",
+    "application/vnd.sun.wadl+xml",
+    "application/vnd.sun.xml.calc",
+    "application/vnd.sun.xml.calc.template",
+    "application/vnd.sun.xml.draw",
+    "application/vnd.sun.xml.draw.template",
+    "application/vnd.sun.xml.impress",
+    "application/vnd.sun.xml.impress.template",
+    "application/vnd.sun.xml.math",
+    "application/vnd.sun.xml.writer",
+    "application/vnd.sun.xml.writer.global",
+    "application/vnd.sun.xml.writer.template",
+    "application/vnd.sus-calendar",
+    "application/vnd.sybyl.mol2",
+    "application/vnd.sycle+xml",
+    "application/vnd.symbian.install",
+    "application/vnd.syncml+xml",
+    "application/vnd.syncml.dm+wbxml",
+    "application/vnd.syncml.dm+xml",
+    "application/vnd.syncml.dmddf+xml",
+    "application/vnd.tao.intent-module-archive",
+    "application/vnd.tcpdump.pcap",
+    "application/vnd.theqvd",
+    "application/vnd.think-cell.ppttc+json",
+    "application/vnd.tml",
+    "application/vnd.tmobile-livetv",
+    "application/vnd.trid.tpt",
+    "application/vnd.triscape.mxs",
+    "application/vnd.trueapp",
+    "application/vnd.ufdl",
+    "application/vnd.uiq.theme",
+    "application/vnd.umajin",
+    "application/vnd.unity",
+    "application/vnd.uoml+xml",
+    "application/vnd.uri-map",
+    "application/vnd.valve.source.material",
+    "application/vnd.vcx",
+    "application/vnd.vd-study",
+    "application/vnd.vectorworks",
+    "application/vnd.veritone.aion+json",
+    "application/vnd.veryant.thin",
+    "application/vnd.ves.encrypted",
+    "application/vnd.vidsoft.vidconference",
+    "application/vnd.visio",
+    "application/vnd.visionary",
+    "application/vnd.vsf",
+    "application/vnd.wap.sic",
+    "application/vnd.wap.slc",
+    "application/vnd.wap.wbxml",
+    "application/vnd.wap.wmlc",
+    "application/vnd.wap.wmlscriptc",
+    "application/vnd.wasmflow.wafl",
+    "application/vnd.webturbo",
+    "application/vnd.wfa.p2p",
+    "application/vnd.wfa.wsc",
+    "application/vnd.wmc",
+    "application/vnd.wolfram.mathematica",
+    "application/vnd.wolfram.mathematica.package",
+    "application/vnd.wolfram.player",
+    "application/vnd.wordperfect",
+    "application/vnd.wqd",
+    "application/vnd.wt.stf",
+    "application/vnd.wv.csp+wbxml",
+    "application/vnd.xara",
+    "application/vnd.xfdl",
+    "application/vnd.xmpie.cpkg",
+    "application/vnd.xmpie.dpkg",
+    "application/vnd.xmpie.ppkg",
+    "application/vnd.xmpie.xlim",
+    "application/vnd.yamaha.hv-dic",
+    "application/vnd.yamaha.hv-script",
+    "application/vnd.yamaha.hv-voice",
+    "application/vnd.yamaha.openscoreformat",
+    "application/vnd.yamaha.smaf-audio",
+    "application/vnd.yamaha.smaf-phrase",
+    "application/vnd.yaoweme",
+    "application/vnd.yellowriver-custom-menu",
+    "application/vnd.zul",
+    "application/vnd.zzazz.deck+xml",
+    "application/voicexml+xml",
+    "application/voucher-cms+json",
+    "application/wasm",
+    "application/watcherinfo+xml",
+    "application/widget",
+    "application/wsdl+xml",
+    "application/wspolicy+xml",
+    "application/x-123",
+    "application/x-7z-compressed",
+    "application/x-abiword",
+    "application/x-apple-diskimage",
+    "application/x-bcpio",
+    "application/x-bittorrent",
+    "application/x-cdf",
+    "application/x-cdlink",
+    "application/x-comsol",
+    "application/x-cpio",
+    "application/x-csh",
+    "application/x-director",
+    "application/x-doom",
+    "application/x-dvi",
+    "application/x-font",
+    "application/x-font-pcf",
+    "application/x-freemind",
+    "application/x-ganttproject",
+    "application/x-gnumeric",
+    "application/x-go-sgf",
+    "application/x-graphing-calculator",
+    "application/x-gtar",
+    "application/x-gtar-compressed",
+    "application/x-hdf",
+    "application/x-hwp",
+    "application/x-ica",
+    "application/x-info",
+    "application/x-internet-signup",
+    "application/x-iphone",
+    "application/x-iso9660-image",
+    "application/x-java-jnlp-file",
+    "application/x-jmol",
+    "application/x-killustrator",
+    "application/x-latex",
+    "application/x-lha",
+    "application/x-lyx",
+    "application/x-lzh",
+    "application/x-lzx",
+    "application/x-maker",
+    "application/x-ms-wmd",
+    "application/x-ms-wmz",
+    "application/x-msdos-program",
+    "application/x-msi",
+    "application/x-netcdf",
+    "application/x-ns-proxy-autoconfig",
+    "application/x-nwc",
+    "application/x-object",
+    "application/x-oz-application",
+    "application/x-pkcs7-certreqresp",
+    "application/x-python-code",
+    "application/x-qgis",
+    "application/x-quicktimeplayer",
+    "application/x-rdp",
+    "application/x-redhat-package-manager",
+    "application/x-rss+xml",
+    "application/x-ruby",
+    "application/x-scilab",
+    "application/x-scilab-xcos",
+    "application/x-sh",
+    "application/x-shar",
+    "application/x-silverlight",
+    "application/x-stuffit",
+    "application/x-sv4cpio",
+    "application/x-sv4crc",
+    "application/x-tar",
+    "application/x-tcl",
+    "application/x-tex-gf",
+    "application/x-tex-pk",
+    "application/x-texinfo",
+    "application/x-trash",
+    "application/x-troff-man",
+    "application/x-troff-me",
+    "application/x-troff-ms",
+    "application/x-ustar",
+    "application/x-wais-source",
+    "application/x-wingz",
+    "application/x-x509-ca-cert",
+    "application/x-xfig",
+    "application/x-xpinstall",
+    "application/x-xz",
+    "application/xcap-att+xml",
+    "application/xcap-caps+xml",
+    "application/xcap-diff+xml",
+    "application/xcap-el+xml",
+    "application/xcap-error+xml",
+    "application/xcap-ns+xml",
+    "application/xfdf",
+    "application/xhtml+xml",
+    "application/xliff+xml",
+    "application/xml",
+    "application/xml-dtd",
+    "application/xml-external-parsed-entity",
+    "application/xop+xml",
+    "application/xslt+xml",
+    "application/xspf+xml",
+    "application/xv+xml",
+    "application/yang",
+    "application/yin+xml",
+    "application/zip",
+    "application/zstd",
+    "audio/32kadpcm",
+    "audio/aac",
+    "audio/ac3",
+    "audio/AMR",
+    "audio/AMR-WB",
+    "audio/annodex",
+    "audio/asc",
+    "audio/ATRAC-ADVANCED-LOSSLESS",
+    "audio/ATRAC-X",
+    "audio/ATRAC3",
+    "audio/basic",
+    "audio/csound",
+    "audio/dls",
+    "audio/EVRC",
+    "audio/EVRC-QCP",
+    "audio/EVRCB",
+    "audio/EVRCNW",
+    "audio/EVRCWB",
+    "audio/flac",
+    "audio/iLBC",
+    "audio/L16",
+    "audio/mhas",
+    "audio/mobile-xmf",
+    "audio/mp4",
+    "audio/mpeg",
+    "audio/mpegurl",
+    "audio/ogg",
+    "audio/prs.sid",
+    "audio/SMV",
+    "audio/sofa",
+    "audio/sp-midi",
+    "audio/usac",
+    "audio/vnd.audiokoz",
+    "audio/vnd.dece.audio",
+    "audio/vnd.digital-winds",
+    "audio/vnd.dolby.mlp",
+    "audio/vnd.dts",
+    "audio/vnd.dts.hd",
+    "audio/vnd.everad.plj",
+    "audio/vnd.lucent.voice",
+    "audio/vnd.ms-playready.media.pya",
+    "audio/vnd.nortel.vbk",
+    "audio/vnd.nuera.ecelp4800",
+    "audio/vnd.nuera.ecelp7470",
+    "audio/vnd.nuera.ecelp9600",
+    "audio/vnd.presonus.multitrack",
+    "audio/vnd.rip",
+    "audio/vnd.sealedmedia.softseal.mpeg",
+    "audio/x-aiff",
+    "audio/x-gsm",
+    "audio/x-ms-wax",
+    "audio/x-ms-wma",
+    "audio/x-pn-realaudio",
+    "audio/x-scpls",
+    "audio/x-sd2",
+    "audio/x-wav",
+    "chemical/x-alchemy",
+    "chemical/x-cache",
+    "chemical/x-cache-csf",
+    "chemical/x-cactvs-binary",
+    "chemical/x-cdx",
+    "chemical/x-chem3d",
+    "chemical/x-chemdraw",
+    "chemical/x-cif",
+    "chemical/x-cmdf",
+    "chemical/x-cml",
+    "chemical/x-compass",
+    "chemical/x-crossfire",
+    "chemical/x-csml",
+    "chemical/x-ctx",
+    "chemical/x-cxf",
+    "chemical/x-embl-dl-nucleotide",
+    "chemical/x-galactic-spc",
+    "chemical/x-gamess-input",
+    "chemical/x-gaussian-checkpoint",
+    "chemical/x-gaussian-cube",
+    "chemical/x-gaussian-input",
+    "chemical/x-gaussian-log",
+    "chemical/x-gcg8-sequence",
+    "chemical/x-genbank",
+    "chemical/x-hin",
+    "chemical/x-isostar",
+    "chemical/x-jcamp-dx",
+    "chemical/x-kinemage",
+    "chemical/x-macmolecule",
+    "chemical/x-macromodel-input",
+    "chemical/x-mdl-molfile",
+    "chemical/x-mdl-rdfile",
+    "chemical/x-mdl-rxnfile",
+    "chemical/x-mdl-sdfile",
+    "chemical/x-mdl-tgf",
+    "chemical/x-mmcif",
+    "chemical/x-molconn-Z",
+    "chemical/x-mopac-graph",
+    "chemical/x-mopac-input",
+    "chemical/x-mopac-out",
+    "chemical/x-mopac-vib",
+    "chemical/x-ncbi-asn1",
+    "chemical/x-ncbi-asn1-ascii",
+    "chemical/x-ncbi-asn1-binary",
+    "chemical/x-ncbi-asn1-spec",
+    "chemical/x-pdb",
+    "chemical/x-rosdal",
+    "chemical/x-swissprot",
+    "chemical/x-vamas-iso14976",
+    "chemical/x-vmd",
+    "chemical/x-xtel",
+    "chemical/x-xyz",
+    "font/collection",
+    "font/otf",
+    "font/ttf",
+    "font/woff",
+    "font/woff2",
+    "image/aces",
+    "image/apng",
+    "image/avci",
+    "image/avcs",
+    "image/avif",
+    "image/bmp",
+    "image/cgm",
+    "image/dicom-rle",
+    "image/dpx",
+    "image/emf",
+    "image/fits",
+    "image/gif",
+    "image/heic",
+    "image/heic-sequence",
+    "image/heif",
+    "image/heif-sequence",
+    "image/hej2k",
+    "image/hsj2",
+    "image/ief",
+    "image/jls",
+    "image/jp2",
+    "image/jpeg",
+    "image/jph",
+    "image/jphc",
+    "image/jpm",
+    "image/jpx",
+    "image/jxl",
+    "image/jxr",
+    "image/jxrA",
+    "image/jxrS",
+    "image/jxs",
+    "image/jxsc",
+    "image/jxsi",
+    "image/jxss",
+    "image/ktx",
+    "image/ktx2",
+    "image/png",
+    "image/prs.btif",
+    "image/prs.pti",
+    "image/svg+xml",
+    "image/tiff",
+    "image/tiff-fx",
+    "image/vnd.adobe.photoshop",
+    "image/vnd.airzip.accelerator.azv",
+    "image/vnd.dece.graphic",
+    "image/vnd.djvu",
+    "image/vnd.dwg",
+    "image/vnd.dxf",
+    "image/vnd.fastbidsheet",
+    "image/vnd.fpx",
+    "image/vnd.fst",
+    "image/vnd.fujixerox.edmics-mmr",
+    "image/vnd.fujixerox.edmics-rlc",
+    "image/vnd.globalgraphics.pgb",
+    "image/vnd.microsoft.icon",
+    "image/vnd.ms-modi",
+    "image/vnd.pco.b16",
+    "image/vnd.radiance",
+    "image/vnd.sealed.png",
+    "image/vnd.sealedmedia.softseal.gif",
+    "image/vnd.sealedmedia.softseal.jpg",
+    "image/vnd.tencent.tap",
+    "image/vnd.valve.source.texture",
+    "image/vnd.wap.wbmp",
+    "image/vnd.xiff",
+    "image/vnd.zbrush.pcx",
+    "image/webp",
+    "image/wmf",
+    "image/x-canon-cr2",
+    "image/x-canon-crw",
+    "image/x-cmu-raster",
+    "image/x-coreldraw",
+    "image/x-coreldrawpattern",
+    "image/x-coreldrawtemplate",
+    "image/x-corelphotopaint",
+    "image/x-epson-erf",
+    "image/x-jg",
+    "image/x-jng",
+    "image/x-nikon-nef",
+    "image/x-olympus-orf",
+    "image/x-portable-anymap",
+    "image/x-portable-bitmap",
+    "image/x-portable-graymap",
+    "image/x-portable-pixmap",
+    "image/x-rgb",
+    "image/x-xbitmap",
+    "image/x-xcf",
+    "image/x-xpixmap",
+    "image/x-xwindowdump",
+    "message/global",
+    "message/global-delivery-status",
+    "message/global-disposition-notification",
+    "message/global-headers",
+    "message/rfc822",
+    "model/gltf+json",
+    "model/gltf-binary",
+    "model/iges",
+    "model/JT",
+    "model/mesh",
+    "model/mtl",
+    "model/obj",
+    "model/prc",
+    "model/step",
+    "model/step+xml",
+    "model/step+zip",
+    "model/step-xml+zip",
+    "model/stl",
+    "model/u3d",
+    "model/vnd.cld",
+    "model/vnd.collada+xml",
+    "model/vnd.dwf",
+    "model/vnd.gdl",
+    "model/vnd.gtw",
+    "model/vnd.moml+xml",
+    "model/vnd.mts",
+    "model/vnd.opengex",
+    "model/vnd.parasolid.transmit.binary",
+    "model/vnd.parasolid.transmit.text",
+    "model/vnd.pytha.pyox",
+    "model/vnd.sap.vds",
+    "model/vnd.usda",
+    "model/vnd.usdz+zip",
+    "model/vnd.valve.source.compiled-map",
+    "model/vnd.vtu",
+    "model/vrml",
+    "model/x3d+fastinfoset",
+    "model/x3d+xml",
+    "model/x3d-vrml",
+    "multipart/vnd.bint.med-plus",
+    "multipart/voice-message",
+    "text/cache-manifest",
+    "text/calendar",
+    "text/cql",
+    "text/css",
+    "text/csv",
+    "text/csv-schema",
+    "text/dns",
+    "text/gff3",
+    "text/html",
+    "text/javascript",
+    "text/jcr-cnd",
+    "text/markdown",
+    "text/mizar",
+    "text/n3",
+    "text/plain",
+    "text/provenance-notation",
+    "text/prs.fallenstein.rst",
+    "text/prs.lines.tag",
+    "text/SGML",
+    "text/shaclc",
+    "text/shex",
+    "text/spdx",
+    "text/tab-separated-values",
+    "text/texmacs",
+    "text/troff",
+    "text/turtle",
+    "text/uri-list",
+    "text/vcard",
+    "text/vnd.a",
+    "text/vnd.abc",
+    "text/vnd.ascii-art",
+    "text/vnd.curl",
+    "text/vnd.debian.copyright",
+    "text/vnd.DMClientScript",
+    "text/vnd.esmertec.theme-descriptor",
+    "text/vnd.exchangeable",
+    "text/vnd.familysearch.gedcom",
+    "text/vnd.ficlab.flt",
+    "text/vnd.fly",
+    "text/vnd.fmi.flexstor",
+    "text/vnd.graphviz",
+    "text/vnd.hans",
+    "text/vnd.hgl",
+    "text/vnd.in3d.3dml",
+    "text/vnd.in3d.spot",
+    "text/vnd.ms-mediapackage",
+    "text/vnd.net2phone.commcenter.command",
+    "text/vnd.senx.warpscript",
+    "text/vnd.sosi",
+    "text/vnd.sun.j2me.app-descriptor",
+    "text/vnd.trolltech.linguist",
+    "text/vnd.wap.si",
+    "text/vnd.wap.sl",
+    "text/vnd.wap.wml",
+    "text/vnd.wap.wmlscript",
+    "text/vtt",
+    "text/wgsl",
+    "text/x-bibtex",
+    "text/x-boo",
+    "text/x-c++hdr",
+    "text/x-c++src",
+    "text/x-chdr",
+    "text/x-component",
+    "text/x-csh",
+    "text/x-csrc",
+    "text/x-diff",
+    "text/x-dsrc",
+    "text/x-haskell",
+    "text/x-java",
+    "text/x-lilypond",
+    "text/x-literate-haskell",
+    "text/x-moc",
+    "text/x-pascal",
+    "text/x-pcs-gcd",
+    "text/x-perl",
+    "text/x-python",
+    "text/x-scala",
+    "text/x-setext",
+    "text/x-sfv",
+    "text/x-sh",
+    "text/x-tcl",
+    "text/x-tex",
+    "text/x-vcalendar",
+    "video/annodex",
+    "video/dv",
+    "video/fli",
+    "video/gl",
+    "video/iso.segment",
+    "video/mj2",
+    "video/mp4",
+    "video/mpeg",
+    "video/ogg",
+    "video/quicktime",
+    "video/vnd.dece.hd",
+    "video/vnd.dece.mobile",
+    "video/vnd.dece.mp4",
+    "video/vnd.dece.pd",
+    "video/vnd.dece.sd",
+    "video/vnd.dece.video",
+    "video/vnd.dvb.file",
+    "video/vnd.fvt",
+    "video/vnd.mpegurl",
+    "video/vnd.ms-playready.media.pyv",
+    "video/vnd.nokia.interleaved-multimedia",
+    "video/vnd.radgamettools.bink",
+    "video/vnd.radgamettools.smacker",
+    "video/vnd.sealed.mpeg1",
+    "video/vnd.sealed.mpeg4",
+    "video/vnd.sealed.swf",
+    "video/vnd.sealedmedia.softseal.mov",
+    "video/vnd.vivo",
+    "video/vnd.youtube.yt",
+    "video/webm",
+    "video/x-flv",
+    "video/x-la-asf",
+    "video/x-matroska",
+    "video/x-mng",
+    "video/x-ms-wm",
+    "video/x-ms-wmv",
+    "video/x-ms-wmx",
+    "video/x-ms-wvx",
+    "video/x-msvideo",
+    "video/x-sgi-movie",
+};
+
+static const uint32_t mime_disp[MIME_BUCKETS] = {
+    1, 6, 1, 5, 3, 4, 1, 3, 1, 3, 1, 10,
+    4, 1, 5, 2, 6, 5, 1, 3, 1, 12, 1, 1,
+    1, 6, 3, 2, 2, 5, 5, 1, 5, 4, 2, 3,
+    13, 15, 1, 2, 6, 3, 1, 7, 7, 8, 1, 8,
+    0, 1, 24, 1, 9, 2, 1, 10, 3, 11, 1, 1,
+    1, 5, 2, 1, 11, 7, 3, 4, 2, 9, 1, 2,
+    1, 4, 4, 3, 14, 1, 2, 5, 21, 1, 4, 5,
+    1, 13, 1, 4, 1, 1, 5, 1, 13, 4, 1, 5,
+    2, 0, 1, 5, 2, 26, 1, 1, 3, 4, 3, 0,
+    2, 6, 4, 8, 0, 1, 3, 2, 1, 4, 13, 6,
+    1, 2, 1, 0, 1, 6, 1, 1, 1, 3, 6, 10,
+    4, 4, 0, 9, 13, 1, 3, 1, 1, 0, 8, 4,
+    1, 3, 2, 1, 2, 5, 1, 12, 1, 0, 2, 1,
+    2, 1, 8, 17, 1, 2, 14, 12, 2, 4, 29, 8,
+    2, 5, 11, 1, 8, 3, 6, 7, 2, 2, 12, 5,
+    2, 4, 2, 2, 9, 3, 2, 8, 29, 12, 1, 9,
+    1, 4, 2, 4, 1, 1, 1, 22, 35, 5, 17, 6,
+    1, 1, 2, 2, 2, 2, 1, 0, 5, 4, 3, 12,
+    1, 15, 7, 7, 4, 2, 12, 7, 3, 16, 3, 2,
+    18, 1, 1, 1, 6, 11, 29, 10, 1, 4, 0, 2,
+    3, 25, 8, 29, 3, 6, 27, 1, 2, 19, 6, 15,
+    2, 1, 5, 3, 27, 24, 2, 6, 4, 1, 1, 33,
+    1, 6, 22, 15, 4, 16, 2, 7, 3, 4, 5, 2,
+    2, 2, 4, 4, 4, 1, 9, 1, 13, 14, 10, 4,
+    1, 15, 1, 1, 8, 4, 11, 3, 7, 10, 2, 3,
+    0, 5, 0, 18, 1, 15, 1, 5, 4, 10, 1, 1,
+    5, 2, 21, 6, 1, 1, 1, 6, 3, 8, 1, 0,
+    4, 3, 0, 4, 1, 1, 11, 1, 3, 4, 1, 1,
+    0, 6, 1, 10, 15, 11, 21, 1, 1, 4, 6, 1,
+    1, 8, 9, 3, 12, 1, 3, 3, 3, 1, 9, 28,
+    26, 1, 15, 13, 1, 2, 9, 3, 3, 9, 2, 5,
+    14, 5, 2, 7, 6, 10, 6, 1, 56, 14, 6, 27,
+    0, 26, 14, 4, 2, 2, 2, 10, 2, 17, 4, 2,
+    37, 4, 2, 1, 4, 4, 1, 12, 1, 18, 21, 42,
+    27, 7, 7, 3, 2, 23, 2, 1, 1, 30, 4, 6,
+    2, 3, 1, 1, 5, 6, 1, 1, 36, 2, 3, 13,
+    54, 13, 1, 3, 5, 2, 4, 3, 1, 3, 2, 4,
+    20, 30, 4, 1, 0, 2, 8, 3, 17, 2, 9, 17,
+    2, 4, 12, 6, 2, 1, 5, 4, 5, 1, 6, 27,
+    7, 14, 2, 25, 1, 0, 3, 12, 3, 1, 15, 15,
+    10, 14, 1, 2, 4, 6, 2, 5, 7, 2, 6, 1,
+    1, 18, 60, 1, 9, 5, 5, 10, 5, 1, 8, 38,
+    17, 2, 12, 1, 21, 1, 11, 11,
+};
+
+// Empty slots have len 0, which no lookup has
+static const struct mime_slot {
+    const char *ext;
+    uint8_t len;
+    uint16_t type; // index in mime_names
+} mime_slots[MIME_SLOTS] = {
+    [0] = { "cryptonote", 10, 596 },
+    [1] = { "zaz", 3, 721 },
+    [2] = { "xsl", 3, 822 },
+    [3] = { "sam", 3, 453 },
+    [4] = { "sem", 3, 605 },
+    [5] = { "ic4", 3, 287 },
+    [7] = { "preminet", 8, 582 },
+    [8] = { "uvvf", 4, 308 },
+    [9] = { "mseq", 4, 507 },
+    [11] = { "mxmf", 4, 851 },
+    [13] = { "cea", 3, 30 },
+    [14] = { "nq", 2, 105 },
+    [15] = { "cdkey", 5, 461 },
+    [16] = { "uvva", 4, 862 },
+    [17] = { "gz", 2, 66 },
+    [18] = { "cdmic", 5, 26 },
+    [20] = { "sl", 2, 1124 },
+    [21] = { "m3g", 3, 85 },
+    [23] = { "ras", 3, 1012 },
+    [24] = { "numbers", 7, 250 },
+    [25] = { "mdb", 3, 102 },
+    [26] = { "tatp", 4, 551 },
+    [27] = { "ccmp", 4, 22 },
+    [28] = { "u8dsn", 5, 1032 },
+    [29] = { "hpgl", 4, 395 },
+    [30] = { "gcf", 3, 749 },
+    [31] = { "vcg", 3, 389 },
+    [33] = { "xdm", 3, 661 },
+    [34] = { "oga", 3, 855 },
+    [35] = { "avif", 4, 946 },
+    [36] = { "ascii", 5, 1102 },
+    [37] = { "std", 3, 648 },
+    [38] = { "sxm", 3, 651 },
+    [45] = { "dcd", 3, 42 },
+    [46] = { "gltf", 4, 1036 },
+    [47] = { "vwx", 3, 681 },
+    [48] = { "btf", 3, 979 },
+    [49] = { "skd", 3, 438 },
+    [51] = { "mp4", 3, 1161 },
+    [52] = { "xlf", 3, 817 },
+    [54] = { "kia", 3, 436 },
+    [55] = { "ic0", 3, 287 },
+    [56] = { "rl", 2, 147 },
+    [57] = { "wtb", 3, 695 },
+    [58] = { "box", 3, 583 },
+    [59] = { "xel", 3, 812 },
+    [63] = { "cxf", 3, 899 },
+    [64] = { "ic2", 3, 287 },
+    [65] = { "css", 3, 1075 },
+    [66] = { "mpe", 3, 1162 },
+    [68] = { "shtml", 5, 1080 },
+    [70] = { "gcg", 3, 907 },
+    [73] = { "lvp", 3, 868 },
+    [74] = { "xyz", 3, 936 },
+    [76] = { "pgb", 3, 995 },
+    [78] = { "line", 4, 513 },
+    [79] = { "mpp", 3, 499 },
+    [80] = { "emf", 3, 951 },
+    [82] = { "pfb", 3, 743 },
+    [84] = { "ovl", 3, 230 },
+    [86] = { "cbor", 4, 20 },
+    [88] = { "kom", 3, 392 },
+    [89] = { "ic3", 3, 287 },
+    [90] = { "odd", 3, 201 },
+    [93] = { "b16", 3, 998 },
+    [94] = { "qcp", 3, 843 },
+    [95] = { "mjp2", 4, 1160 },
+    [96] = { "xhe", 3, 860 },
+    [98] = { "xsm", 3, 659 },
+    [99] = { "nml", 3, 326 },
+    [100] = { "vfr", 3, 667 },
+    [101] = { "g2w", 3, 378 },
+    [102] = { "pwn", 3, 220 },
+    [103] = { "ktz", 3, 426 },
+    [104] = { "axa", 3, 834 },
+    [106] = { "dwf", 3, 1052 },
+    [107] = { "age", 3, 232 },
+    [109] = { "stml", 4, 610 },
+    [110] = { "str", 3, 575 },
+    [111] = { "rs", 2, 150 },
+    [112] = { "xmt_bin", 7, 1058 },
+    [113] = { "dsm", 3, 313 },
+    [115] = { "wad", 3, 741 },
+    [116] = { "bed", 3, 593 },
+    [117] = { "ser", 3, 73 },
+    [121] = { "s11", 3, 1178 },
+    [122] = { "gre", 3, 376 },
+    [124] = { "uvvz", 4, 311 },
+    [125] = { "mus", 3, 510 },
+    [126] = { "nim", 3, 1175 },
+    [127] = { "ac3", 3, 831 },
+    [128] = { "uvt", 3, 309 },
+    [129] = { "lostsyncxml", 11, 82 },
+    [130] = { "psfs", 4, 585 },
+    [135] = { "ogx", 3, 113 },
+    [136] = { "vcs", 3, 1154 },
+    [138] = { "amr", 3, 832 },
+    [140] = { "crl", 3, 133 },
+    [142] = { "shar", 4, 788 },
+    [143] = { "pk", 2, 796 },
+    [144] = { "ufdl", 4, 672 },
+    [145] = { "sgml", 4, 1090 },
+    [147] = { "uvvg", 4, 986 },
+    [148] = { "ppm", 3, 1025 },
+    [149] = { "thmx", 4, 491 },
+    [150] = { "mets", 4, 96 },
+    [152] = { "webmanifest", 11, 89 },
+    [153] = { "twd", 3, 624 },
+    [154] = { "mpg", 3, 1162 },
+    [155] = { "odg", 3, 533 },
+    [156] = { "dll", 3, 770 },
+    [157] = { "otg", 3, 534 },
+    [160] = { "m1v", 3, 1162 },
+    [161] = { "hpub", 4, 139 },
+    [162] = { "acutc", 5, 224 },
+    [163] = { "ism", 3, 1053 },
+    [164] = { "cdxml", 5, 268 },
+    [165] = { "sppt", 4, 607 },
+    [166] = { "relo", 4, 117 },
+    [167] = { "dart", 4, 303 },
+    [169] = { "zfc", 3, 351 },
+    [171] = { "notebook", 8, 626 },
+    [172] = { "snd", 3, 839 },
+    [173] = { "semd", 4, 614 },
+    [174] = { "lha", 3, 763 },
+    [176] = { "mpv", 3, 1187 },
+    [177] = { "patch", 5, 1137 },
+    [179] = { "vbox", 4, 583 },
+    [180] = { "nebul", 5, 513 },
+    [181] = { "hej2", 4, 958 },
+    [182] = { "ltx", 3, 1153 },
+    [183] = { "mmod", 4, 914 },
+    [184] = { "viaframe", 8, 667 },
+    [186] = { "gff3", 4, 1079 },
+    [189] = { "step", 4, 1044 },
+    [192] = { "eps3", 4, 136 },
+    [193] = { "cdmio", 5, 28 },
+    [194] = { "svg", 3, 981 },
+    [195] = { "xpm", 3, 1029 },
+    [198] = { "slc", 3, 690 },
+    [199] = { "dsc", 3, 1089 },
+    [200] = { "csvs", 4, 1077 },
+    [201] = { "susp", 4, 655 },
+    [202] = { "mov", 3, 1164 },
+    [205] = { "bh2", 3, 361 },
+    [206] = { "dor", 3, 1053 },
+    [207] = { "davmount", 8, 41 },
+    [208] = { "cdmiq", 5, 29 },
+    [210] = { "cld", 3, 1050 },
+    [211] = { "tree", 4, 591 },
+    [212] = { "oa2", 3, 358 },
+    [213] = { "wm", 2, 1189 },
+    [216] = { "icm", 3, 405 },
+    [217] = { "mqy", 3, 471 },
+    [218] = { "cbr", 3, 286 },
+    [219] = { "wz", 2, 804 },
+    [220] = { "mp3", 3, 853 },
+    [222] = { "apr", 3, 448 },
+    [223] = { "pot", 3, 1086 },
+    [224] = { "wqd", 3, 703 },
+    [225] = { "frm", 3, 672 },
+    [227] = { "clkk", 4, 293 },
+    [228] = { "lcs", 3, 445 },
+    [229] = { "fli", 3, 1157 },
+    [230] = { "scl", 3, 657 },
+    [231] = { "xwd", 3, 1030 },
+    [232] = { "osm", 3, 557 },
+    [233] = { "sitx", 4, 790 },
+    [234] = { "shp", 3, 621 },
+    [235] = { "sco", 3, 840 },
+    [236] = { "ns4", 3, 450 },
+    [237] = { "mpkg", 4, 247 },
+    [238] = { "lgr", 3, 79 },
+    [240] = { "sdkm", 4, 631 },
+    [241] = { "p10", 3, 125 },
+    [242] = { "jxsi", 4, 974 },
+    [246] = { "3mf", 3, 478 },
+    [247] = { "uoml", 4, 676 },
+    [248] = { "azf", 3, 234 },
+    [249] = { "uvd", 3, 308 },
+    [250] = { "igl", 3, 406 },
+    [252] = { "acn", 3, 835 },
+    [254] = { "s1h", 3, 610 },
+    [255] = { "ttl", 3, 1097 },
+    [256] = { "seed", 4, 349 },
+    [257] = { "dpkg", 4, 709 },
+    [260] = { "woff2", 5, 941 },
+    [261] = { "lmp", 3, 1053 },
+    [262] = { "xslt", 4, 822 },
+    [263] = { "avci", 4, 944 },
+    [264] = { "stpnc", 5, 116 },
+    [265] = { "x_t", 3, 1059 },
+    [266] = { "mcm", 3, 913 },
+    [268] = { "nsg", 3, 450 },
+    [270] = { "gau", 3, 905 },
+    [272] = { "plf", 3, 580 },
+    [273] = { "lbc", 3, 848 },
+    [274] = { "nbp", 3, 701 },
+    [275] = { "etx", 3, 1149 },
+    [277] = { "key", 3, 122 },
+    [279] = { "ogv", 3, 1163 },
+    [281] = { "flb", 3, 350 },
+    [282] = { "tra", 3, 671 },
+    [283] = { "u3d", 3, 1049 },
+    [285] = { "swi", 3, 252 },
+    [286] = { "mft", 3, 155 },
+    [290] = { "kpr", 3, 432 },
+    [291] = { "s3df", 4, 602 },
+    [292] = { "qgs", 3, 779 },
+    [293] = { "et3", 3, 334 },
+    [295] = { "woff", 4, 940 },
+    [296] = { "lxf", 3, 84 },
+    [297] = { "pskcxml", 7, 143 },
+    [298] = { "tamx", 4, 549 },
+    [299] = { "art", 3, 1018 },
+    [301] = { "fg5", 3, 360 },
+    [302] = { "mods", 4, 100 },
+    [303] = { "mxl", 3, 594 },
+    [304] = { "aso", 3, 221 },
+    [305] = { "wmls", 4, 1126 },
+    [307] = { "mxml", 4, 824 },
+    [308] = { "wafl", 4, 694 },
+    [309] = { "vcx", 3, 679 },
+    [310] = { "emm", 3, 401 },
+    [313] = { "sgi", 3, 1001 },
+    [314] = { "musd", 4, 99 },
+    [315] = { "bib", 3, 1129 },
+    [316] = { "mop", 3, 923 },
+    [317] = { "cif", 3, 509 },
+    [319] = { "ac", 2, 131 },
+    [320] = { "ssml", 4, 187 },
+    [322] = { "hbci", 4, 392 },
+    [324] = { "ecig", 4, 340 },
+    [325] = { "wmf", 3, 1009 },
+    [326] = { "jad", 3, 1121 },
+    [329] = { "smo", 3, 1181 },
+    [330] = { "xotp", 4, 282 },
+    [331] = { "pfa", 3, 743 },
+    [332] = { "pgn", 3, 269 },
+    [333] = { "asice", 5, 335 },
+    [334] = { "ns2", 3, 450 },
+    [336] = { "yang", 4, 825 },
+    [337] = { "p7c", 3, 127 },
+    [338] = { "sema", 4, 613 },
+    [339] = { "jxr", 3, 969 },
+    [341] = { "m4u", 3, 1173 },
+    [342] = { "manifest", 8, 1072 },
+    [343] = { "rst", 3, 1088 },
+    [347] = { "or3", 3, 451 },
+    [348] = { "atomsvc", 7, 10 },
+    [349] = { "iges", 4, 1038 },
+    [350] = { "qt", 2, 1164 },
+    [351] = { "nnw", 3, 522 },
+    [352] = { "oprc", 4, 571 },
+    [354] = { "kne", 3, 437 },
+    [355] = { "ptid", 4, 587 },
+    [356] = { "heic", 4, 954 },
+    [357] = { "sfd-hdstx", 9, 400 },
+    [358] = { "jar", 3, 72 },
+    [360] = { "odt", 3, 541 },
+    [361] = { "oxps", 4, 115 },
+    [362] = { "3tz", 3, 457 },
+    [363] = { "mmr", 3, 993 },
+    [364] = { "shc", 3, 1091 },
+    [365] = { "cbz", 3, 285 },
+    [366] = { "sik", 3, 798 },
+    [367] = { "xls", 3, 482 },
+    [370] = { "gph", 3, 352 },
+    [372] = { "crw", 3, 1011 },
+    [373] = { "epub", 4, 54 },
+    [375] = { "dfac", 4, 318 },
+    [377] = { "flx", 3, 1111 },
+    [379] = { "vpm", 3, 1071 },
+    [380] = { "cgm", 3, 948 },
+    [382] = { "nds", 3, 517 },
+    [385] = { "cascii", 6, 888 },
+    [389] = { "ssvc", 4, 298 },
+    [390] = { "rgbe", 4, 999 },
+    [391] = { "oza", 3, 776 },
+    [392] = { "zmm", 3, 391 },
+    [393] = { "trig", 4, 207 },
+    [394] = { "paw", 3, 574 },
+    [395] = { "rapd", 4, 151 },
+    [396] = { "i2g", 3, 414 },
+    [397] = { "bmml", 4, 257 },
+    [398] = { "zir", 3, 720 },
+    [400] = { "clkp", 4, 294 },
+    [401] = { "tatx", 4, 552 },
+    [402] = { "cw", 2, 138 },
+    [403] = { "acu", 3, 223 },
+    [406] = { "ppam", 4, 494 },
+    [408] = { "diff", 4, 1137 },
+    [409] = { "wav", 3, 884 },
+    [410] = { "multitrack", 10, 874 },
+    [411] = { "keynote", 7, 248 },
+    [412] = { "fdt", 3, 59 },
+    [413] = { "jng", 3, 1019 },
+    [414] = { "dvi", 3, 742 },
+    [415] = { "pdx", 3, 119 },
+    [416] = { "dx", 2, 911 },
+    [417] = { "wks", 3, 503 },
+    [418] = { "qxt", 3, 589 },
+    [419] = { "le", 2, 264 },
+    [420] = { "lpf", 3, 83 },
+    [423] = { "uvvx", 4, 310 },
+    [424] = { "ecelp7470", 9, 872 },
+    [425] = { "ott", 3, 543 },
+    [427] = { "fpx", 3, 991 },
+    [428] = { "cpt", 3, 87 },
+    [429] = { "mdc", 3, 456 },
+    [430] = { "odc", 3, 530 },
+    [432] = { "rct", 3, 140 },
+    [433] = { "jnlp", 4, 759 },
+    [434] = { "jpe", 3, 963 },
+    [435] = { "lzh", 3, 765 },
+    [437] = { "ddd", 3, 362 },
+    [438] = { "st", 2, 599 },
+    [439] = { "ez3", 3, 345 },
+    [440] = { "dxp", 3, 632 },
+    [441] = { "mopcrt", 6, 923 },
+    [442] = { "wmv", 3, 1190 },
+    [443] = { "sty", 3, 1153 },
+    [444] = { "ic8", 3, 287 },
+    [446] = { "pil", 3, 577 },
+    [448] = { "class", 5, 74 },
+    [449] = { "ddeb", 4, 307 },
+    [450] = { "siv", 3, 178 },
+    [452] = { "avcs", 4, 945 },
+    [453] = { "atxml", 5, 14 },
+    [454] = { "sms", 3, 217 },
+    [455] = { "sc", 2, 404 },
+    [456] = { "pyox", 4, 1060 },
+    [459] = { "ei6", 3, 576 },
+    [460] = { "scr", 3, 789 },
+    [461] = { "orc", 3, 840 },
+    [462] = { "ez2", 3, 344 },
+    [463] = { "xfdf", 4, 815 },
+    [464] = { "edm", 3, 526 },
+    [466] = { "pcx", 3, 1007 },
+    [467] = { "ecigprofile", 11, 339 },
+    [469] = { "mcd", 3, 459 },
+    [470] = { "mml", 3, 93 },
+    [472] = { "sfd", 3, 354 },
+    [473] = { "ma", 2, 92 },
+    [474] = { "tsa", 3, 196 },
+    [475] = { "a2l", 3, 0 },
+    [477] = { "skt", 3, 438 },
+    [478] = { "sgl", 3, 641 },
+    [479] = { "lyx", 3, 764 },
+    [480] = { "uris", 4, 1098 },
+    [481] = { "xla", 3, 482 },
+    [482] = { "evc", 3, 842 },
+    [483] = { "glbuf", 5, 64 },
+    [485] = { "yin", 3, 826 },
+    [487] = { "dp", 2, 568 },
+    [488] = { "dxf", 3, 989 },
+    [489] = { "ml2", 3, 656 },
+    [490] = { "fm", 2, 355 },
+    [491] = { "xdf", 3, 811 },
+    [492] = { "flt", 3, 1109 },
+    [493] = { "csl", 3, 272 },
+    [494] = { "xdw", 3, 363 },
+    [495] = { "carjson", 7, 338 },
+    [497] = { "abc", 3, 1101 },
+    [498] = { "oti", 3, 536 },
+    [499] = { "mb", 2, 92 },
+    [503] = { "s1n", 3, 1000 },
+    [505] = { "tsq", 3, 203 },
+    [506] = { "qca", 3, 332 },
+    [507] = { "tau", 3, 191 },
+    [508] = { "scd", 3, 601 },
+    [509] = { "sensmle", 7, 175 },
+    [510] = { "vew", 3, 448 },
+    [512] = { "wv", 2, 705 },
+    [514] = { "vfk", 3, 1107 },
+    [517] = { "cap", 3, 664 },
+    [520] = { "rlc", 3, 994 },
+    [522] = { "mag", 3, 324 },
+    [523] = { "sds", 3, 636 },
+    [524] = { "gtm", 3, 387 },
+    [525] = { "atomdeleted", 11, 8 },
+    [526] = { "spx", 3, 855 },
+    [527] = { "cod", 3, 597 },
+    [528] = { "vcd", 3, 736 },
+    [529] = { "ipk", 3, 620 },
+    [530] = { "tsd", 3, 205 },
+    [533] = { "gdz", 3, 346 },
+    [535] = { "xop", 3, 821 },
+    [536] = { "wbmp", 4, 1005 },
+    [537] = { "xo", 2, 545 },
+    [538] = { "sgf", 3, 748 },
+    [539] = { "pkd", 3, 392 },
+    [542] = { "mseed", 5, 348 },
+    [545] = { "flac", 4, 847 },
+    [546] = { "gram", 4, 184 },
+    [547] = { "btif", 4, 979 },
+    [548] = { "sml", 3, 180 },
+    [549] = { "tgz", 3, 751 },
+    [550] = { "sgif", 4, 1001 },
+    [551] = { "csf", 3, 887 },
+    [552] = { "portpkg", 7, 454 },
+    [553] = { "ep", 2, 263 },
+    [554] = { "text", 4, 1086 },
+    [557] = { "wax", 3, 879 },
+    [558] = { "cbin", 4, 888 },
+    [559] = { "s1a", 3, 611 },
+    [560] = { "x3dz", 4, 1068 },
+    [562] = { "a", 1, 1100 },
+    [563] = { "spng", 4, 1000 },
+    [564] = { "s1m", 3, 876 },
+    [565] = { "gsm", 3, 878 },
+    [566] = { "wif", 3, 725 },
+    [568] = { "rsheet", 6, 210 },
+    [571] = { "finf", 4, 57 },
+    [572] = { "knp", 3, 437 },
+    [573] = { "prf", 3, 124 },
+    [576] = { "ecelp4800", 9, 871 },
+    [577] = { "ots", 3, 540 },
+    [580] = { "apxml", 5, 15 },
+    [581] = { "s1e", 3, 609 },
+    [582] = { "ic7", 3, 287 },
+    [583] = { "prz", 3, 449 },
+    [584] = { "pki", 3, 135 },
+    [585] = { "sldm", 4, 496 },
+    [586] = { "eol", 3, 863 },
+    [587] = { "txt", 3, 1086 },
+    [588] = { "com", 3, 770 },
+    [589] = { "mpd", 3, 39 },
+    [590] = { "omg", 3, 838 },
+    [591] = { "h", 1, 1133 },
+    [592] = { "anx", 3, 3 },
+    [593] = { "qxd", 3, 589 },
+    [595] = { "ns3", 3, 450 },
+    [596] = { "hvd", 3, 712 },
+    [597] = { "lsx", 3, 1186 },
+    [598] = { "gtar", 4, 750 },
+    [599] = { "taz", 3, 751 },
+    [601] = { "avi", 3, 1193 },
+    [603] = { "deb", 3, 307 },
+    [604] = { "mvt", 3, 455 },
+    [605] = { "aep", 3, 255 },
+    [606] = { "smov", 4, 1181 },
+    [607] = { "vbk", 3, 870 },
+    [608] = { "py", 2, 1147 },
+    [609] = { "aion", 4, 682 },
+    [610] = { "heics", 5, 955 },
+    [612] = { "sy2", 3, 656 },
+    [613] = { "pfx", 3, 126 },
+    [614] = { "ist", 3, 910 },
+    [615] = { "atomsrv", 7, 9 },
+    [616] = { "ai", 2, 136 },
+    [617] = { "spot", 4, 1116 },
+    [618] = { "xz", 2, 808 },
+    [619] = { "pyc", 3, 778 },
+    [622] = { "ors", 3, 108 },
+    [623] = { "js", 2, 1081 },
+    [624] = { "mjs", 3, 1081 },
+    [625] = { "uvz", 3, 311 },
+    [626] = { "wgt", 3, 726 },
+    [627] = { "tuc", 3, 199 },
+    [628] = { "ica", 3, 754 },
+    [629] = { "uvvp", 4, 1168 },
+    [630] = { "tat", 3, 550 },
+    [632] = { "123", 3, 447 },
+    [633] = { "wrl", 3, 1066 },
+    [636] = { "drle", 4, 949 },
+    [638] = { "nb", 2, 699 },
+    [639] = { "dmp", 3, 664 },
+    [641] = { "cellml", 6, 31 },
+    [642] = { "smc", 3, 518 },
+    [644] = { "listafp", 7, 229 },
+    [645] = { "senmlx", 6, 168 },
+    [646] = { "vst", 3, 686 },
+    [647] = { "soc", 3, 176 },
+    [648] = { "qcall", 5, 332 },
+    [649] = { "msp", 3, 109 },
+    [651] = { "djv", 3, 987 },
+    [652] = { "bkm", 3, 514 },
+    [654] = { "gjc", 3, 905 },
+    [655] = { "fbs", 3, 990 },
+    [656] = { "cuc", 3, 194 },
+    [657] = { "bar", 3, 588 },
+    [660] = { "p8", 2, 129 },
+    [661] = { "nnd", 3, 520 },
+    [663] = { "rpm", 3, 782 },
+    [664] = { "oa3", 3, 359 },
+    [665] = { "msty", 4, 511 },
+    [667] = { "b", 1, 921 },
+    [668] = { "sig", 3, 123 },
+    [669] = { "uvh", 3, 1165 },
+    [670] = { "cpio", 4, 738 },
+    [671] = { "gbr", 3, 154 },
+    [672] = { "semf", 4, 615 },
+    [673] = { "cpa", 3, 895 },
+    [676] = { "sh", 2, 787 },
+    [677] = { "pnm", 3, 1022 },
+    [678] = { "u8msg", 5, 1031 },
+    [679] = { "eps2", 4, 136 },
+    [680] = { "gdl", 3, 1053 },
+    [682] = { "eps", 3, 136 },
+    [684] = { "ktx", 3, 976 },
+    [685] = { "rcprofile", 9, 418 },
+    [689] = { "td", 2, 211 },
+    [690] = { "gpt", 3, 922 },
+    [691] = { "appcache", 8, 1072 },
+    [692] = { "cmc", 3, 291 },
+    [693] = { "dit", 3, 45 },
+    [694] = { "plb", 3, 214 },
+    [695] = { "vsw", 3, 686 },
+    [697] = { "sxl", 3, 609 },
+    [698] = { "sid", 3, 856 },
+    [699] = { "prc", 3, 1043 },
+    [701] = { "uvvm", 4, 1166 },
+    [702] = { "ifc", 3, 116 },
+    [703] = { "qam", 3, 329 },
+    [704] = { "cdt", 3, 1015 },
+    [705] = { "pdb", 3, 571 },
+    [706] = { "210", 3, 116 },
+    [707] = { "vss", 3, 686 },
+    [708] = { "cc", 2, 1132 },
+    [709] = { "clkt", 4, 295 },
+    [710] = { "dae", 3, 1051 },
+    [711] = { "qwt", 3, 589 },
+    [712] = { "uis", 3, 212 },
+    [714] = { "jdx", 3, 911 },
+    [715] = { "kin", 3, 912 },
+    [716] = { "eln", 3, 325 },
+    [717] = { "pat", 3, 1014 },
+    [718] = { "qxl", 3, 589 },
+    [719] = { "ent", 3, 820 },
+    [720] = { "cls", 3, 1153 },
+    [721] = { "artisan", 7, 253 },
+    [722] = { "mpga", 4, 853 },
+    [723] = { "dl", 2, 305 },
+    [724] = { "jfif", 4, 963 },
+    [725] = { "ssw", 3, 1180 },
+    [726] = { "kon", 3, 431 },
+    [727] = { "sxg", 3, 653 },
+    [728] = { "latex", 5, 762 },
+    [729] = { "sla", 3, 601 },
+    [730] = { "svc", 3, 321 },
+    [731] = { "win", 3, 1053 },
+    [732] = { "spn", 3, 1000 },
+    [733] = { "scim", 4, 160 },
+    [734] = { "wml", 3, 1125 },
+    [735] = { "emma", 4, 52 },
+    [739] = { "xpr", 3, 420 },
+    [740] = { "dpgraph", 7, 317 },
+    [741] = { "mol", 3, 915 },
+    [742] = { "fbdoc", 5, 767 },
+    [743] = { "usdz", 4, 1063 },
+    [744] = { "vmt", 3, 678 },
+    [746] = { "afp", 3, 229 },
+    [747] = { "jsontd", 6, 200 },
+    [749] = { "ppkg", 4, 710 },
+    [750] = { "htke", 4, 435 },
+    [752] = { "daf", 3, 468 },
+    [754] = { "tnef", 4, 500 },
+    [756] = { "otf", 3, 938 },
+    [758] = { "exe", 3, 770 },
+    [759] = { "zst", 3, 828 },
+    [761] = { "iso", 3, 758 },
+    [762] = { "wpl", 3, 504 },
+    [763] = { "rusd", 4, 153 },
+    [764] = { "flo", 3, 465 },
+    [766] = { "smf", 3, 639 },
+    [767] = { "inkml", 5, 69 },
+    [768] = { "ipfix", 5, 70 },
+    [769] = { "ivu", 3, 410 },
+    [771] = { "markdown", 8, 1083 },
+    [772] = { "tpt", 3, 669 },
+    [773] = { "lzx", 3, 766 },
+    [775] = { "mc1", 3, 460 },
+    [776] = { "shaclc", 6, 1091 },
+    [777] = { "jpm", 3, 966 },
+    [778] = { "wmlsc", 5, 693 },
+    [779] = { "smp", 3, 876 },
+    [780] = { "ksp", 3, 433 },
+    [781] = { "crtr", 4, 508 },
+    [783] = { "rar", 3, 592 },
+    [786] = { "ktr", 3, 426 },
+    [787] = { "rnd", 3, 140 },
+    [788] = { "mmd", 3, 270 },
+    [789] = { "grxml", 5, 185 },
+    [790] = { "tsv", 3, 1094 },
+    [791] = { "l16", 3, 849 },
+    [793] = { "tst", 3, 337 },
+    [794] = { "cr2", 3, 1010 },
+    [795] = { "wdb", 3, 503 },
+    [796] = { "bmi", 3, 265 },
+    [797] = { "epsf", 4, 136 },
+    [798] = { "pya", 3, 869 },
+    [799] = { "xpi", 3, 807 },
+    [801] = { "bsp", 3, 1064 },
+    [802] = { "s1w", 3, 604 },
+    [804] = { "c4p", 3, 275 },
+    [806] = { "o", 1, 775 },
+    [807] = { "ebuild", 6, 370 },
+    [808] = { "usda", 4, 1062 },
+    [809] = { "gim", 3, 385 },
+    [810] = { "xpak", 4, 372 },
+    [811] = { "sci", 3, 785 },
+    [812] = { "gqf", 3, 382 },
+    [813] = { "sv4crc", 6, 792 },
+    [814] = { "xlam", 4, 483 },
+    [816] = { "nsf", 3, 450 },
+    [818] = { "mmf", 3, 625 },
+    [819] = { "png", 3, 978 },
+    [820] = { "fcdt", 4, 226 },
+    [822] = { "hans", 4, 1113 },
+    [823] = { "csv", 3, 1076 },
+    [826] = { "tex", 3, 1153 },
+    [827] = { "alc", 3, 885 },
+    [829] = { "xlt", 3, 482 },
+    [831] = { "cml", 3, 31 },
+    [832] = { "acc", 3, 237 },
+    [834] = { "opf", 3, 112 },
+    [835] = { "mpdd", 4, 40 },
+    [838] = { "ink", 3, 69 },
+    [839] = { "sldx", 4, 559 },
+    [840] = { "xyze", 4, 999 },
+    [842] = { "xhvml", 5, 824 },
+    [843] = { "ic5", 3, 287 },
+    [845] = { "dls", 3, 841 },
+    [846] = { "cmsc", 4, 34 },
+    [847] = { "obgx", 4, 553 },
+    [848] = { "stpxz", 5, 1047 },
+    [849] = { "rb", 2, 784 },
+    [850] = { "es3", 3, 334 },
+    [851] = { "grv", 3, 386 },
+    [852] = { "imp", 3, 222 },
+    [853] = { "c3d", 3, 890 },
+    [854] = { "wk3", 3, 447 },
+    [855] = { "prt", 3, 927 },
+    [856] = { "pcap", 4, 664 },
+    [857] = { "uri", 3, 1098 },
+    [859] = { "gjf", 3, 905 },
+    [861] = { "1clr", 4, 32 },
+    [862] = { "qtl", 3, 780 },
+    [863] = { "fcs", 3, 421 },
+    [864] = { "mj2", 3, 1160 },
+    [865] = { "ppt", 3, 493 },
+    [866] = { "mgp", 3, 567 },
+    [867] = { "smh", 3, 606 },
+    [869] = { "sofa", 4, 858 },
+    [870] = { "ptrom", 5, 628 },
+    [871] = { "qxb", 3, 589 },
+    [872] = { "dim", 3, 347 },
+    [874] = { "vmd", 3, 934 },
+    [875] = { "xbd", 3, 364 },
+    [876] = { "tiff", 4, 982 },
+    [877] = { "mmdb", 4, 458 },
+    [880] = { "ustar", 5, 802 },
+    [882] = { "qps", 3, 586 },
+    [883] = { "teicorpus", 9, 201 },
+    [884] = { "odi", 3, 535 },
+    [885] = { "rsm", 3, 1053 },
+    [886] = { "oth", 3, 544 },
+    [888] = { "saf", 3, 716 },
+    [889] = { "imgcal", 6, 219 },
+    [890] = { "jtd", 3, 1106 },
+    [891] = { "smpg", 4, 1178 },
+    [892] = { "vtnstd", 6, 682 },
+    [893] = { "msh", 3, 1040 },
+    [894] = { "isws", 4, 683 },
+    [895] = { "enw", 3, 845 },
+    [896] = { "sw", 2, 932 },
+    [897] = { "fti", 3, 243 },
+    [899] = { "bmpr", 4, 258 },
+    [900] = { "djvu", 4, 987 },
+    [902] = { "lca", 3, 445 },
+    [903] = { "csml", 4, 897 },
+    [904] = { "ait", 3, 320 },
+    [905] = { "cer", 3, 132 },
+    [906] = { "vsd", 3, 686 },
+    [907] = { "eclass", 6, 371 },
+    [908] = { "rdf", 3, 144 },
+    [909] = { "sensml", 6, 173 },
+    [910] = { "cwl", 3, 38 },
+    [912] = { "mfm", 3, 464 },
+    [913] = { "asn", 3, 926 },
+    [914] = { "provx", 5, 137 },
+    [915] = { "uvvi", 4, 986 },
+    [916] = { "fxp", 3, 227 },
+    [917] = { "wcm", 3, 503 },
+    [918] = { "msa", 3, 506 },
+    [919] = { "sfc", 3, 518 },
+    [920] = { "c11amz", 6, 277 },
+    [921] = { "jisp", 4, 424 },
+    [922] = { "xlm", 3, 482 },
+    [923] = { "cda", 3, 735 },
+    [924] = { "wgsl", 4, 1128 },
+    [925] = { "jrd", 3, 75 },
+    [926] = { "csh", 3, 739 },
+    [927] = { "dv", 2, 1156 },
+    [928] = { "ntf", 3, 450 },
+    [929] = { "igm", 3, 412 },
+    [930] = { "pl", 2, 1146 },
+    [931] = { "dssc", 4, 48 },
+    [933] = { "xlc", 3, 482 },
+    [934] = { "smv", 3, 857 },
+    [935] = { "imf", 3, 407 },
+    [937] = { "onetmp", 6, 114 },
+    [938] = { "u8mdn", 5, 1033 },
+    [939] = { "gen", 3, 908 },
+    [940] = { "smk", 3, 1177 },
+    [941] = { "m4s", 3, 1159 },
+    [942] = { "hdr", 3, 999 },
+    [943] = { "abw", 3, 731 },
+    [944] = { "jpeg", 4, 963 },
+    [945] = { "tur", 3, 198 },
+    [946] = { "ifb", 3, 1073 },
+    [948] = { "jpf", 3, 967 },
+    [950] = { "wpd", 3, 702 },
+    [951] = { "jpx", 3, 967 },
+    [952] = { "c9s", 3, 299 },
+    [953] = { "bmed", 4, 1070 },
+    [954] = { "tlclient", 8, 267 },
+    [957] = { "imi", 3, 408 },
+    [958] = { "azs", 3, 235 },
+    [959] = { "les", 3, 394 },
+    [961] = { "iota", 4, 254 },
+    [962] = { "lbd", 3, 443 },
+    [963] = { "oxt", 3, 556 },
+    [965] = { "atfx", 4, 5 },
+    [966] = { "odx", 3, 111 },
+    [967] = { "cst", 3, 288 },
+    [969] = { "mpy", 3, 402 },
+    [971] = { "sse", 3, 439 },
+    [972] = { "quox", 4, 590 },
+    [973] = { "ged", 3, 1108 },
+    [974] = { "slt", 3, 330 },
+    [975] = { "nsh", 3, 450 },
+    [977] = { "rnc", 3, 146 },
+    [978] = { "spq", 3, 163 },
+    [979] = { "sit", 3, 790 },
+    [980] = { "ico", 3, 996 },
+    [981] = { "asc", 3, 122 },
+    [982] = { "wasm", 4, 724 },
+    [983] = { "tam", 3, 547 },
+    [984] = { "rxt", 3, 462 },
+    [986] = { "soa", 3, 1078 },
+    [988] = { "osf", 3, 715 },
+    [989] = { "urim", 4, 677 },
+    [990] = { "dts", 3, 865 },
+    [991] = { "hps", 3, 397 },
+    [993] = { "lbe", 3, 444 },
+    [994] = { "nitf", 4, 519 },
+    [996] = { "ogex", 4, 1057 },
+    [997] = { "mads", 4, 88 },
+    [998] = { "pti", 3, 980 },
+    [999] = { "g3w", 3, 379 },
+    [1000] = { "p7r", 3, 777 },
+    [1002] = { "xct", 3, 365 },
+    [1003] = { "jxss", 4, 975 },
+    [1005] = { "xns", 3, 814 },
+    [1006] = { "model-inter", 11, 680 },
+    [1007] = { "ahead", 5, 233 },
+    [1008] = { "mpt", 3, 499 },
+    [1009] = { "ppsm", 4, 497 },
+    [1010] = { "shex", 4, 1092 },
+    [1011] = { "tag", 3, 1089 },
+    [1013] = { "oxlicg", 6, 570 },
+    [1014] = { "jxra", 4, 970 },
+    [1015] = { "brf", 3, 1086 },
+    [1016] = { "csrattrs", 8, 36 },
+    [1017] = { "sdc", 3, 635 },
+    [1018] = { "xbm", 3, 1027 },
+    [1019] = { "flv", 3, 1185 },
+    [1020] = { "ngdat", 5, 523 },
+    [1021] = { "stf", 3, 704 },
+    [1022] = { "uvg", 3, 986 },
+    [1023] = { "distz", 5, 247 },
+    [1027] = { "pac", 3, 773 },
+    [1028] = { "qwd", 3, 589 },
+    [1031] = { "gqs", 3, 382 },
+    [1032] = { "unityweb", 8, 675 },
+    [1033] = { "ogg", 3, 855 },
+    [1034] = { "sjpg", 4, 1002 },
+    [1035] = { "apkg", 4, 241 },
+    [1036] = { "rpst", 4, 524 },
+    [1037] = { "sdoc", 4, 604 },
+    [1038] = { "mrc", 3, 90 },
+    [1040] = { "car", 3, 417 },
+    [1041] = { "mhas", 4, 850 },
+    [1042] = { "onetoc2", 7, 114 },
+    [1043] = { "jpg2", 4, 962 },
+    [1044] = { "sru", 3, 186 },
+    [1045] = { "fst", 3, 992 },
+    [1049] = { "nef", 3, 1020 },
+    [1050] = { "p", 1, 1144 },
+    [1051] = { "dcm", 3, 43 },
+    [1053] = { "xpx", 3, 413 },
+    [1056] = { "sxc", 3, 645 },
+    [1057] = { "fchk", 4, 903 },
+    [1058] = { "tgf", 3, 919 },
+    [1059] = { "dd2", 3, 546 },
+    [1060] = { "gcd", 3, 1145 },
+    [1062] = { "msu", 3, 109 },
+    [1063] = { "pub", 3, 343 },
+    [1064] = { "xots", 4, 284 },
+    [1065] = { "ndl", 3, 450 },
+    [1066] = { "mng", 3, 1188 },
+    [1068] = { "xca", 3, 810 },
+    [1069] = { "cpl", 3, 35 },
+    [1070] = { "gv", 2, 1112 },
+    [1071] = { "c3ex", 4, 21 },
+    [1073] = { "heifs", 5, 957 },
+    [1074] = { "uvs", 3, 1169 },
+    [1076] = { "otc", 3, 531 },
+    [1077] = { "uvf", 3, 308 },
+    [1078] = { "hh", 2, 1131 },
+    [1079] = { "tm", 2, 1095 },
+    [1080] = { "gml", 3, 65 },
+    [1082] = { "obg", 3, 554 },
+    [1084] = { "eml", 3, 1035 },
+    [1085] = { "gtw", 3, 1054 },
+    [1087] = { "irm", 3, 403 },
+    [1088] = { "psg", 3, 231 },
+    [1089] = { "cat", 3, 492 },
+    [1090] = { "xspf", 4, 823 },
+    [1091] = { "wmz", 3, 769 },
+    [1092] = { "cii", 3, 242 },
+    [1093] = { "jls", 3, 961 },
+    [1094] = { "sieve", 5, 178 },
+    [1095] = { "upa", 3, 392 },
+    [1096] = { "igs", 3, 1038 },
+    [1097] = { "cab", 3, 481 },
+    [1098] = { "its", 3, 71 },
+    [1099] = { "imscc", 5, 411 },
+    [1100] = { "xodt", 4, 279 },
+    [1101] = { "sarif", 5, 158 },
+    [1102] = { "fig", 3, 806 },
+    [1104] = { "tnf", 3, 500 },
+    [1105] = { "sjp", 3, 1002 },
+    [1106] = { "dpg", 3, 317 },
+    [1107] = { "ami", 3, 238 },
+    [1110] = { "p7z", 3, 127 },
+    [1111] = { "las", 3, 440 },
+    [1112] = { "pyv", 3, 1174 },
+    [1113] = { "fts", 3, 952 },
+    [1116] = { "dzr", 3, 323 },
+    [1117] = { "pseg3820", 8, 229 },
+    [1120] = { "ps", 2, 136 },
+    [1121] = { "ecigtheme", 9, 341 },
+    [1122] = { "ppd", 3, 302 },
+    [1123] = { "ndc", 3, 566 },
+    [1124] = { "mbk", 3, 470 },
+    [1125] = { "nwc", 3, 774 },
+    [1126] = { "emotionml", 9, 53 },
+    [1127] = { "tcu", 3, 193 },
+    [1128] = { "at3", 3, 838 },
+    [1129] = { "ods", 3, 539 },
+    [1130] = { "lhzd", 4, 260 },
+    [1131] = { "ghf", 3, 384 },
+    [1132] = { "apexlang", 8, 246 },
+    [1133] = { "n3", 2, 1085 },
+    [1134] = { "xmls", 4, 46 },
+    [1136] = { "cww", 3, 138 },
+    [1138] = { "ms", 2, 801 },
+    [1139] = { "jp2", 3, 962 },
+    [1140] = { "cpkg", 4, 708 },
+    [1141] = { "cpp", 3, 1132 },
+    [1142] = { "scm", 3, 452 },
+    [1143] = { "sus", 3, 655 },
+    [1144] = { "genozip", 7, 368 },
+    [1147] = { "hbc", 3, 392 },
+    [1148] = { "icf", 3, 287 },
+    [1149] = { "html", 4, 1080 },
+    [1150] = { "fly", 3, 1110 },
+    [1151] = { "fla", 3, 319 },
+    [1152] = { "aif", 3, 877 },
+    [1153] = { "gif", 3, 953 },
+    [1154] = { "spp", 3, 164 },
+    [1157] = { "spd", 3, 611 },
+    [1158] = { "fsc", 3, 356 },
+    [1159] = { "xtel", 4, 935 },
+    [1160] = { "roff", 4, 1096 },
+    [1161] = { "dna", 3, 314 },
+    [1162] = { "dpx", 3, 950 },
+    [1163] = { "mph", 3, 737 },
+    [1164] = { "xps", 3, 505 },
+    [1165] = { "hgl", 3, 1114 },
+    [1166] = { "odp", 3, 537 },
+    [1168] = { "ext", 3, 528 },
+    [1169] = { "stpz", 4, 1046 },
+    [1170] = { "xhtml", 5, 816 },
+    [1171] = { "cdx", 3, 889 },
+    [1172] = { "ttml", 4, 208 },
+    [1173] = { "doc", 3, 103 },
+    [1176] = { "potm", 4, 498 },
+    [1177] = { "c4g", 3, 275 },
+    [1180] = { "mm", 2, 745 },
+    [1181] = { "ez", 2, 2 },
+    [1182] = { "msl", 3, 472 },
+    [1183] = { "rd", 2, 916 },
+    [1184] = { "ins", 3, 756 },
+    [1186] = { "ics", 3, 1073 },
+    [1188] = { "clue", 4, 33 },
+    [1189] = { "fit", 3, 952 },
+    [1190] = { "isp", 3, 756 },
+    [1191] = { "dvc", 3, 50 },
+    [1192] = { "txd", 3, 367 },
+    [1195] = { "sd", 2, 918 },
+    [1196] = { "koz", 3, 861 },
+    [1197] = { "cdy", 3, 271 },
+    [1199] = { "cache", 5, 886 },
+    [1200] = { "1km", 3, 213 },
+    [1201] = { "dist", 4, 247 },
+    [1202] = { "mtl", 3, 1041 },
+    [1203] = { "msd", 3, 348 },
+    [1204] = { "tao", 3, 663 },
+    [1205] = { "glb", 3, 1037 },
+    [1207] = { "h++", 3, 1131 },
+    [1208] = { "dvb", 3, 1171 },
+    [1209] = { "pbd", 3, 581 },
+    [1210] = { "aifc", 4, 877 },
+    [1212] = { "ivp", 3, 409 },
+    [1215] = { "rip", 3, 875 },
+    [1216] = { "cmdf", 4, 893 },
+    [1219] = { "wadl", 4, 644 },
+    [1220] = { "xvml", 4, 824 },
+    [1221] = { "bin", 3, 109 },
+    [1222] = { "atc", 3, 224 },
+    [1223] = { "hif", 3, 946 },
+    [1224] = { "ccxml", 5, 23 },
+    [1225] = { "lasxml", 6, 442 },
+    [1226] = { "s14", 3, 1179 },
+    [1227] = { "sdd", 3, 638 },
+    [1228] = { "mp21", 4, 101 },
+    [1231] = { "erf", 3, 1017 },
+    [1233] = { "jxs", 3, 972 },
+    [1234] = { "vrm", 3, 1066 },
+    [1235] = { "pages", 5, 251 },
+    [1236] = { "x_b", 3, 1058 },
+    [1237] = { "wg", 2, 579 },
+    [1238] = { "hta", 3, 67 },
+    [1239] = { "x3d", 3, 1068 },
+    [1240] = { "uvvs", 4, 1169 },
+    [1243] = { "pre", 3, 449 },
+    [1244] = { "quiz", 4, 590 },
+    [1245] = { "apex", 4, 246 },
+    [1246] = { "pqa", 3, 571 },
+    [1247] = { "lasjson", 7, 441 },
+    [1249] = { "hs", 2, 1139 },
+    [1250] = { "nimn", 4, 516 },
+    [1251] = { "ts", 2, 1122 },
+    [1252] = { "vis", 3, 687 },
+    [1254] = { "spc", 3, 901 },
+    [1255] = { "pbm", 3, 1023 },
+    [1256] = { "wk4", 3, 447 },
+    [1258] = { "qbo", 3, 415 },
+    [1259] = { "frame", 5, 767 },
+    [1260] = { "sce", 3, 335 },
+    [1261] = { "coffee", 6, 278 },
+    [1262] = { "loas", 4, 860 },
+    [1264] = { "esa", 3, 569 },
+    [1265] = { "psd", 3, 984 },
+    [1268] = { "skm", 3, 438 },
+    [1271] = { "json-patch", 10, 77 },
+    [1272] = { "umj", 3, 674 },
+    [1273] = { "boo", 3, 1130 },
+    [1274] = { "hal", 3, 390 },
+    [1275] = { "t", 1, 1096 },
+    [1276] = { "udeb", 4, 307 },
+    [1278] = { "mid", 3, 859 },
+    [1279] = { "bsd", 3, 896 },
+    [1283] = { "link66", 6, 598 },
+    [1284] = { "tfx", 3, 983 },
+    [1285] = { "eot", 3, 487 },
+    [1288] = { "amlx", 4, 16 },
+    [1289] = { "xsf", 3, 142 },
+    [1290] = { "xcs", 3, 19 },
+    [1292] = { "gsheet", 6, 209 },
+    [1293] = { "bpd", 3, 392 },
+    [1294] = { "vtu", 3, 1065 },
+    [1295] = { "htm", 3, 1080 },
+    [1296] = { "mesh", 4, 1040 },
+    [1300] = { "gan", 3, 746 },
+    [1301] = { "moo", 3, 924 },
+    [1302] = { "xfd", 3, 707 },
+    [1303] = { "teacher", 7, 627 },
+    [1306] = { "xml", 3, 818 },
+    [1308] = { "efi", 3, 51 },
+    [1310] = { "pdf", 3, 118 },
+    [1312] = { "lhs", 3, 1142 },
+    [1314] = { "hqx", 3, 86 },
+    [1315] = { "coswid", 6, 189 },
+    [1316] = { "jxrs", 4, 971 },
+    [1318] = { "uvx", 3, 310 },
+    [1319] = { "wma", 3, 880 },
+    [1320] = { "xif", 3, 1006 },
+    [1321] = { "ctx", 3, 898 },
+    [1323] = { "si", 2, 1123 },
+    [1324] = { "tamp", 4, 548 },
+    [1325] = { "dtshd", 5, 866 },
+    [1329] = { "psb", 3, 215 },
+    [1332] = { "lhzl", 4, 261 },
+    [1333] = { "viv", 3, 1182 },
+    [1334] = { "pps", 3, 493 },
+    [1335] = { "bak", 3, 798 },
+    [1336] = { "x3dv", 4, 1069 },
+    [1337] = { "kcm", 3, 514 },
+    [1338] = { "ktx2", 4, 977 },
+    [1339] = { "pgm", 3, 1024 },
+    [1340] = { "webm", 4, 1184 },
+    [1342] = { "sensmlx", 7, 174 },
+    [1343] = { "shx", 3, 622 },
+    [1345] = { "m4a", 3, 852 },
+    [1346] = { "azw3", 4, 236 },
+    [1347] = { "u8hdr", 5, 1034 },
+    [1348] = { "rsat", 4, 13 },
+    [1349] = { "fvt", 3, 1172 },
+    [1351] = { "mts", 3, 1056 },
+    [1353] = { "srt", 3, 1086 },
+    [1355] = { "rq", 2, 181 },
+    [1357] = { "xdp", 3, 228 },
+    [1358] = { "gam", 3, 902 },
+    [1359] = { "rdp", 3, 781 },
+    [1360] = { "pcf", 3, 744 },
+    [1361] = { "moml", 4, 1055 },
+    [1365] = { "stw", 3, 654 },
+    [1366] = { "man", 3, 799 },
+    [1367] = { "fe_launch", 9, 312 },
+    [1368] = { "auc", 3, 192 },
+    [1369] = { "mxf", 3, 104 },
+    [1373] = { "vxml", 4, 722 },
+    [1375] = { "apng", 4, 943 },
+    [1376] = { "wlnk", 4, 80 },
+    [1377] = { "uvvd", 4, 308 },
+    [1378] = { "urimap", 6, 677 },
+    [1379] = { "cql", 3, 1074 },
+    [1380] = { "orf", 3, 1021 },
+    [1381] = { "uvm", 3, 1166 },
+    [1382] = { "svgz", 4, 981 },
+    [1383] = { "wsdl", 4, 727 },
+    [1384] = { "apk", 3, 240 },
+    [1385] = { "java", 4, 1140 },
+    [1386] = { "nt", 2, 106 },
+    [1387] = { "vrml", 4, 1066 },
+    [1388] = { "ssv", 3, 616 },
+    [1391] = { "ttf", 3, 939 },
+    [1392] = { "wbxml", 5, 691 },
+    [1393] = { "pyo", 3, 778 },
+    [1395] = { "mod", 3, 819 },
+    [1397] = { "sv4cpio", 7, 791 },
+    [1398] = { "joda", 4, 425 },
+    [1399] = { "s1q", 3, 1181 },
+    [1401] = { "sic", 3, 689 },
+    [1402] = { "request", 7, 514 },
+    [1403] = { "dotx", 4, 565 },
+    [1404] = { "atf", 3, 4 },
+    [1405] = { "torrent", 7, 734 },
+    [1406] = { "sda", 3, 637 },
+    [1407] = { "flw", 3, 430 },
+    [1409] = { "hwp", 3, 753 },
+    [1410] = { "smht", 4, 606 },
+    [1411] = { "wmc", 3, 698 },
+    [1413] = { "sfs", 3, 633 },
+    [1416] = { "senml-etchc", 11, 169 },
+    [1417] = { "mvb", 3, 925 },
+    [1419] = { "mxu", 3, 1173 },
+    [1421] = { "stl", 3, 1048 },
+    [1422] = { "vsf", 3, 688 },
+    [1423] = { "uvi", 3, 986 },
+    [1424] = { "skp", 3, 438 },
+    [1425] = { "jlt", 3, 398 },
+    [1426] = { "tsr", 3, 204 },
+    [1427] = { "ic1", 3, 287 },
+    [1428] = { "c9r", 3, 299 },
+    [1429] = { "msf", 3, 328 },
+    [1430] = { "ctab", 4, 888 },
+    [1432] = { "dms", 3, 1105 },
+    [1434] = { "shf", 3, 177 },
+    [1436] = { "xdssc", 5, 49 },
+    [1437] = { "3dml", 4, 1115 },
+    [1438] = { "smzip", 5, 642 },
+    [1439] = { "gal", 3, 906 },
+    [1440] = { "sos", 3, 1120 },
+    [1441] = { "xhtm", 4, 816 },
+    [1442] = { "obj", 3, 1042 },
+    [1443] = { "c11amc", 6, 276 },
+    [1446] = { "hsj2", 4, 959 },
+    [1447] = { "scs", 3, 162 },
+    [1449] = { "oas", 3, 357 },
+    [1450] = { "rld", 3, 148 },
+    [1451] = { "s1j", 3, 1002 },
+    [1452] = { "exi", 3, 55 },
+    [1453] = { "org", 3, 451 },
+    [1454] = { "s1p", 3, 607 },
+    [1455] = { "pm", 2, 1146 },
+    [1456] = { "ota", 3, 239 },
+    [1459] = { "ggt", 3, 375 },
+    [1460] = { "vtt", 3, 1127 },
+    [1461] = { "m3u", 3, 854 },
+    [1462] = { "pptm", 4, 495 },
+    [1463] = { "7z", 2, 730 },
+    [1466] = { "mcif", 4, 920 },
+    [1467] = { "mol2", 4, 656 },
+    [1469] = { "pkipath", 7, 134 },
+    [1470] = { "ims", 3, 489 },
+    [1471] = { "axv", 3, 1155 },
+    [1472] = { "json", 4, 76 },
+    [1474] = { "dxr", 3, 740 },
+    [1476] = { "cxx", 3, 1132 },
+    [1477] = { "fzs", 3, 366 },
+    [1479] = { "bmp", 3, 947 },
+    [1481] = { "hvp", 3, 714 },
+    [1484] = { "mp1", 3, 853 },
+    [1485] = { "xer", 3, 813 },
+    [1488] = { "maker", 5, 767 },
+    [1490] = { "sxls", 4, 609 },
+    [1491] = { "jmz", 3, 760 },
+    [1492] = { "ggb", 3, 373 },
+    [1493] = { "vcf", 3, 1099 },
+    [1494] = { "scq", 3, 161 },
+    [1495] = { "loom", 4, 446 },
+    [1498] = { "spdx", 4, 1093 },
+    [1499] = { "mpf", 3, 1117 },
+    [1503] = { "sfv", 3, 1150 },
+    [1504] = { "fits", 4, 952 },
+    [1505] = { "espass", 6, 333 },
+    [1506] = { "aiff", 4, 877 },
+    [1507] = { "oeb", 3, 555 },
+    [1508] = { "icc", 3, 405 },
+    [1509] = { "nlu", 3, 515 },
+    [1510] = { "cdfx", 4, 24 },
+    [1511] = { "md", 2, 1083 },
+    [1512] = { "jam", 3, 422 },
+    [1513] = { "smi", 3, 180 },
+    [1514] = { "dtd", 3, 819 },
+    [1516] = { "mpn", 3, 475 },
+    [1518] = { "dcr", 3, 740 },
+    [1519] = { "xmt_txt", 7, 1059 },
+    [1520] = { "m3u8", 4, 249 },
+    [1521] = { "esf", 3, 327 },
+    [1522] = { "cdbcmsg", 7, 289 },
+    [1523] = { "istc", 4, 683 },
+    [1524] = { "ves", 3, 684 },
+    [1525] = { "smil", 4, 180 },
+    [1527] = { "wmx", 3, 1191 },
+    [1529] = { "xcos", 4, 786 },
+    [1531] = { "wmd", 3, 768 },
+    [1532] = { "p2p", 3, 696 },
+    [1534] = { "rep", 3, 266 },
+    [1536] = { "rif", 3, 145 },
+    [1537] = { "xul", 3, 477 },
+    [1538] = { "gl", 2, 1158 },
+    [1539] = { "xodp", 4, 281 },
+    [1542] = { "xltx", 4, 563 },
+    [1543] = { "hpi", 3, 396 },
+    [1544] = { "dif", 3, 1156 },
+    [1545] = { "potx", 4, 561 },
+    [1547] = { "spf", 3, 717 },
+    [1550] = { "oda", 3, 110 },
+    [1551] = { "p8e", 3, 130 },
+    [1553] = { "deploy", 6, 109 },
+    [1554] = { "xfdl", 4, 707 },
+    [1555] = { "study-inter", 11, 680 },
+    [1556] = { "arrow", 5, 244 },
+    [1557] = { "uvvv", 4, 1170 },
+    [1558] = { "xdd", 3, 17 },
+    [1560] = { "rlm", 3, 595 },
+    [1561] = { "docm", 4, 501 },
+    [1562] = { "cla", 3, 273 },
+    [1563] = { "yt", 2, 1183 },
+    [1566] = { "sql", 3, 183 },
+    [1567] = { "vds", 3, 1061 },
+    [1568] = { "webp", 4, 1008 },
+    [1570] = { "xlw", 3, 482 },
+    [1572] = { "s1g", 3, 1001 },
+    [1573] = { "dbf", 3, 306 },
+    [1574] = { "taglet", 6, 512 },
+    [1575] = { "stp", 3, 1044 },
+    [1576] = { "m4v", 3, 1161 },
+    [1577] = { "mxi", 3, 680 },
+    [1578] = { "pml", 3, 301 },
+    [1579] = { "psid", 4, 856 },
+    [1580] = { "bdm", 3, 660 },
+    [1581] = { "reload", 6, 595 },
+    [1582] = { "mc2", 3, 1119 },
+    [1583] = { "mbox", 4, 94 },
+    [1585] = { "cil", 3, 479 },
+    [1586] = { "rp9", 3, 274 },
+    [1587] = { "srx", 3, 182 },
+    [1588] = { "ic6", 3, 287 },
+    [1589] = { "c4f", 3, 275 },
+    [1590] = { "utz", 3, 673 },
+    [1591] = { "odm", 3, 542 },
+    [1592] = { "ecelp9600", 9, 873 },
+    [1593] = { "x3dvz", 5, 1069 },
+    [1594] = { "val", 3, 928 },
+    [1595] = { "ra", 2, 881 },
+    [1597] = { "senml-etchj", 11, 170 },
+    [1598] = { "plc", 3, 473 },
+    [1599] = { "pas", 3, 1144 },
+    [1600] = { "senmlc", 6, 166 },
+    [1602] = { "yme", 3, 718 },
+    [1603] = { "bk2", 3, 1176 },
+    [1604] = { "ssf", 3, 331 },
+    [1605] = { "ccc", 3, 1118 },
+    [1606] = { "csm", 3, 897 },
+    [1607] = { "cdr", 3, 1013 },
+    [1608] = { "hvs", 3, 713 },
+    [1609] = { "cdmid", 5, 27 },
+    [1610] = { "rss", 3, 783 },
+    [1611] = { "ly", 2, 1141 },
+    [1613] = { "pt", 2, 628 },
+    [1614] = { "see", 3, 612 },
+    [1615] = { "moc", 3, 1143 },
+    [1616] = { "ter", 3, 195 },
+    [1617] = { "fch", 3, 903 },
+    [1620] = { "xlsm", 4, 485 },
+    [1622] = { "fdf", 3, 58 },
+    [1624] = { "dii", 3, 44 },
+    [1625] = { "jpgm", 4, 966 },
+    [1626] = { "pls", 3, 882 },
+    [1628] = { "ppttc", 5, 666 },
+    [1629] = { "stpx", 4, 1045 },
+    [1630] = { "cdmia", 5, 25 },
+    [1631] = { "ram", 3, 881 },
+    [1633] = { "tei", 3, 201 },
+    [1637] = { "es", 2, 1081 },
+    [1638] = { "edx", 3, 527 },
+    [1639] = { "p12", 3, 126 },
+    [1640] = { "wps", 3, 503 },
+    [1641] = { "zmt", 3, 923 },
+    [1642] = { "uva", 3, 862 },
+    [1643] = { "chm", 3, 488 },
+    [1644] = { "lin", 3, 18 },
+    [1649] = { "xlsx", 4, 562 },
+    [1650] = { "asf", 3, 480 },
+    [1651] = { "d", 1, 1138 },
+    [1652] = { "swidtag", 7, 190 },
+    [1653] = { "plp", 3, 572 },
+    [1654] = { "pem", 3, 120 },
+    [1655] = { "csd", 3, 840 },
+    [1656] = { "sr", 2, 623 },
+    [1658] = { "lsf", 3, 1186 },
+    [1660] = { "geo", 3, 322 },
+    [1661] = { "silo", 4, 1040 },
+    [1662] = { "gxt", 3, 377 },
+    [1664] = { "hdf", 3, 752 },
+    [1665] = { "sm", 2, 643 },
+    [1666] = { "exr", 3, 942 },
+    [1668] = { "kmz", 3, 381 },
+    [1670] = { "kfo", 3, 429 },
+    [1673] = { "dis", 3, 469 },
+    [1675] = { "zone", 4, 1078 },
+    [1679] = { "jsonld", 6, 78 },
+    [1680] = { "tcl", 3, 794 },
+    [1682] = { "uvvu", 4, 1167 },
+    [1683] = { "vsc", 3, 685 },
+    [1684] = { "miz", 3, 1084 },
+    [1685] = { "aml", 3, 1 },
+    [1687] = { "rpss", 4, 525 },
+    [1688] = { "mgz", 3, 584 },
+    [1689] = { "zirz", 4, 720 },
+    [1691] = { "msi", 3, 771 },
+    [1692] = { "bat", 3, 770 },
+    [1693] = { "mail", 4, 1035 },
+    [1695] = { "hdt", 3, 393 },
+    [1696] = { "evw", 3, 846 },
+    [1699] = { "xar", 3, 706 },
+    [1701] = { "aa3", 3, 838 },
+    [1704] = { "m2v", 3, 1162 },
+    [1705] = { "uvu", 3, 1167 },
+    [1708] = { "opus", 4, 855 },
+    [1710] = { "xvm", 3, 824 },
+    [1711] = { "tsp", 3, 47 },
+    [1712] = { "maei", 4, 98 },
+    [1713] = { "tif", 3, 982 },
+    [1715] = { "xlim", 4, 711 },
+    [1716] = { "cef", 3, 899 },
+    [1717] = { "dwg", 3, 988 },
+    [1718] = { "mdi", 3, 997 },
+    [1719] = { "ufd", 3, 672 },
+    [1720] = { "cl", 2, 179 },
+    [1721] = { "sar", 3, 600 },
+    [1722] = { "chrt", 4, 428 },
+    [1723] = { "kil", 3, 761 },
+    [1725] = { "hpid", 4, 396 },
+    [1726] = { "sdo", 3, 604 },
+    [1730] = { "xht", 3, 816 },
+    [1731] = { "au", 2, 839 },
+    [1732] = { "entity", 6, 514 },
+    [1734] = { "orq", 3, 107 },
+    [1736] = { "dwd", 3, 11 },
+    [1738] = { "pfr", 3, 60 },
+    [1739] = { "uo", 2, 676 },
+    [1740] = { "xlsb", 4, 484 },
+    [1741] = { "xltm", 4, 486 },
+    [1744] = { "wbs", 3, 297 },
+    [1745] = { "jph", 3, 964 },
+    [1746] = { "p7m", 3, 127 },
+    [1748] = { "mpg4", 4, 1161 },
+    [1749] = { "dmg", 3, 732 },
+    [1750] = { "sti", 3, 650 },
+    [1751] = { "csp", 3, 288 },
+    [1752] = { "crt", 3, 805 },
+    [1753] = { "uvv", 3, 1170 },
+    [1754] = { "rfcxml", 6, 149 },
+    [1755] = { "jsontm", 6, 206 },
+    [1756] = { "glbin", 5, 64 },
+    [1757] = { "rms", 3, 423 },
+    [1758] = { "package", 7, 256 },
+    [1759] = { "spdf", 4, 611 },
+    [1760] = { "odf", 3, 532 },
+    [1761] = { "gnumeric", 8, 747 },
+    [1762] = { "lwp", 3, 453 },
+    [1764] = { "heif", 4, 956 },
+    [1765] = { "atx", 3, 837 },
+    [1768] = { "ddf", 3, 662 },
+    [1770] = { "uvvt", 4, 309 },
+    [1773] = { "senml", 5, 167 },
+    [1774] = { "pgp", 3, 121 },
+    [1775] = { "uvvh", 4, 1165 },
+    [1776] = { "fo", 2, 629 },
+    [1777] = { "scsf", 4, 603 },
+    [1778] = { "sqlite3", 7, 634 },
+    [1781] = { "jphc", 4, 965 },
+    [1783] = { "info", 4, 755 },
+    [1785] = { "iif", 3, 619 },
+    [1787] = { "epsi", 4, 136 },
+    [1788] = { "stk", 3, 68 },
+    [1789] = { "rtf", 3, 157 },
+    [1790] = { "sgm", 3, 1090 },
+    [1792] = { "lostxml", 7, 81 },
+    [1794] = { "irp", 3, 419 },
+    [1795] = { "or2", 3, 451 },
+    [1796] = { "atomcat", 7, 7 },
+    [1797] = { "cub", 3, 904 },
+    [1799] = { "spl", 3, 61 },
+    [1800] = { "rxn", 3, 917 },
+    [1801] = { "kwt", 3, 434 },
+    [1802] = { "wk1", 3, 447 },
+    [1803] = { "vcard", 5, 1099 },
+    [1804] = { "bik", 3, 1176 },
+    [1806] = { "cryptomator", 11, 300 },
+    [1807] = { "sdf", 3, 437 },
+    [1808] = { "uvp", 3, 1168 },
+    [1810] = { "itp", 3, 618 },
+    [1811] = { "aac", 3, 830 },
+    [1814] = { "book", 4, 767 },
+    [1815] = { "sis", 3, 658 },
+    [1816] = { "jxl", 3, 968 },
+    [1817] = { "asics", 5, 336 },
+    [1818] = { "adts", 4, 830 },
+    [1820] = { "gamin", 5, 902 },
+    [1821] = { "old", 3, 798 },
+    [1823] = { "m", 1, 700 },
+    [1824] = { "nns", 3, 521 },
+    [1825] = { "clkw", 4, 296 },
+    [1828] = { "sxd", 3, 647 },
+    [1829] = { "p21", 3, 116 },
+    [1830] = { "dive", 4, 573 },
+    [1832] = { "istr", 4, 910 },
+    [1834] = { "embl", 4, 900 },
+    [1836] = { "ggs", 3, 374 },
+    [1838] = { "curl", 4, 1103 },
+    [1839] = { "wspolicy", 8, 728 },
+    [1840] = { "c++", 3, 1132 },
+    [1842] = { "smp3", 4, 876 },
+    [1844] = { "ifm", 3, 617 },
+    [1845] = { "geojson", 7, 62 },
+    [1846] = { "mpc", 3, 476 },
+    [1848] = { "msm", 3, 1053 },
+    [1849] = { "dir", 3, 740 },
+    [1850] = { "xpw", 3, 413 },
+    [1851] = { "tfi", 3, 202 },
+    [1854] = { "sdw", 3, 640 },
+    [1855] = { "pkg", 3, 247 },
+    [1856] = { "evb", 3, 844 },
+    [1857] = { "spo", 3, 1116 },
+    [1858] = { "gac", 3, 383 },
+    [1859] = { "awb", 3, 833 },
+    [1860] = { "vms", 3, 933 },
+    [1861] = { "sqlite", 6, 634 },
+    [1866] = { "ftc", 3, 353 },
+    [1867] = { "hpp", 3, 1131 },
+    [1869] = { "list3820", 8, 229 },
+    [1870] = { "clkx", 4, 292 },
+    [1873] = { "wk", 2, 729 },
+    [1874] = { "ppsx", 4, 560 },
+    [1875] = { "gpkg", 4, 63 },
+    [1876] = { "sac", 3, 197 },
+    [1877] = { "sarif-external-properties", 25, 159 },
+    [1878] = { "mwf", 3, 463 },
+    [1881] = { "xott", 4, 280 },
+    [1882] = { "sswf", 4, 1180 },
+    [1883] = { "wmlc", 4, 692 },
+    [1884] = { "mpw", 3, 342 },
+    [1885] = { "ignition", 8, 290 },
+    [1886] = { "scala", 5, 1148 },
+    [1889] = { "tk", 2, 1152 },
+    [1890] = { "map", 3, 76 },
+    [1891] = { "jxsc", 4, 973 },
+    [1893] = { "c", 1, 1136 },
+    [1894] = { "pvb", 3, 216 },
+    [1895] = { "gf", 2, 795 },
+    [1897] = { "vcj", 3, 723 },
+    [1898] = { "pcl", 3, 399 },
+    [1899] = { "senmle", 6, 171 },
+    [1900] = { "mf4", 3, 97 },
+    [1901] = { "stif", 4, 608 },
+    [1902] = { "exp", 3, 56 },
+    [1904] = { "grd", 3, 369 },
+    [1907] = { "mpega", 5, 853 },
+    [1908] = { "tpl", 3, 388 },
+    [1909] = { "sxw", 3, 652 },
+    [1910] = { "rgb", 3, 1026 },
+    [1911] = { "efif", 4, 578 },
+    [1912] = { "jpg", 3, 963 },
+    [1913] = { "stc", 3, 646 },
+    [1914] = { "mp2", 3, 853 },
+    [1915] = { "cmp", 3, 719 },
+    [1917] = { "emb", 3, 900 },
+    [1918] = { "jt", 2, 1039 },
+    [1919] = { "qfx", 3, 416 },
+    [1922] = { "docx", 4, 564 },
+    [1925] = { "3dm", 3, 1115 },
+    [1926] = { "hin", 3, 909 },
+    [1927] = { "cu", 2, 37 },
+    [1928] = { "c4u", 3, 275 },
+    [1929] = { "wsc", 3, 697 },
+    [1930] = { "docjson", 7, 315 },
+    [1931] = { "vtf", 3, 1004 },
+    [1932] = { "icd", 3, 287 },
+    [1933] = { "aal", 3, 836 },
+    [1934] = { "sdkd", 4, 631 },
+    [1936] = { "twds", 4, 624 },
+    [1937] = { "cdf", 3, 735 },
+    [1938] = { "texinfo", 7, 797 },
+    [1941] = { "plj", 3, 867 },
+    [1943] = { "provn", 5, 1087 },
+    [1946] = { "sdp", 3, 165 },
+    [1948] = { "fxpl", 4, 227 },
+    [1949] = { "karbon", 6, 427 },
+    [1951] = { "mpm", 3, 262 },
+    [1953] = { "kml", 3, 380 },
+    [1954] = { "arrows", 6, 245 },
+    [1955] = { "onepkg", 6, 114 },
+    [1956] = { "mrcx", 4, 91 },
+    [1957] = { "tmo", 3, 668 },
+    [1958] = { "inp", 3, 902 },
+    [1960] = { "726", 3, 829 },
+    [1961] = { "texi", 4, 797 },
+    [1963] = { "sd2", 3, 883 },
+    [1964] = { "dataless", 8, 349 },
+    [1965] = { "ass", 3, 830 },
+    [1966] = { "xav", 3, 809 },
+    [1968] = { "jhc", 3, 965 },
+    [1969] = { "cac", 3, 886 },
+    [1970] = { "sensmlc", 7, 172 },
+    [1971] = { "me", 2, 800 },
+    [1972] = { "rdf-crypt", 9, 141 },
+    [1974] = { "mwc", 3, 317 },
+    [1975] = { "fb", 2, 767 },
+    [1976] = { "mxs", 3, 670 },
+    [1977] = { "c4d", 3, 275 },
+    [1979] = { "otp", 3, 538 },
+    [1980] = { "htc", 3, 1134 },
+    [1982] = { "iii", 3, 757 },
+    [1983] = { "gex", 3, 376 },
+    [1984] = { "mpeg", 4, 1162 },
+    [1985] = { "qvd", 3, 665 },
+    [1986] = { "tr", 2, 1096 },
+    [1988] = { "azv", 3, 985 },
+    [1989] = { "dotm", 4, 502 },
+    [1990] = { "xods", 4, 283 },
+    [1991] = { "xcf", 3, 1028 },
+    [1995] = { "gsf", 3, 743 },
+    [1996] = { "ign", 3, 290 },
+    [1997] = { "mlp", 3, 864 },
+    [1998] = { "swf", 3, 225 },
+    [1999] = { "sls", 3, 152 },
+    [2001] = { "dot", 3, 1112 },
+    [2002] = { "txf", 3, 474 },
+    [2003] = { "zip", 3, 827 },
+    [2004] = { "one", 3, 114 },
+    [2005] = { "pptx", 4, 558 },
+    [2006] = { "hxx", 3, 1131 },
+    [2008] = { "copyright", 9, 1104 },
+    [2009] = { "seml", 4, 605 },
+    [2010] = { "igx", 3, 466 },
+    [2011] = { "x3db", 4, 1067 },
+    [2012] = { "roa", 3, 156 },
+    [2013] = { "ttc", 3, 937 },
+    [2014] = { "nc", 2, 772 },
+    [2015] = { "wvx", 3, 1192 },
+    [2016] = { "kpt", 3, 432 },
+    [2017] = { "tap", 3, 1003 },
+    [2018] = { "sxi", 3, 649 },
+    [2020] = { "stix", 4, 188 },
+    [2021] = { "mif", 3, 467 },
+    [2022] = { "odb", 3, 529 },
+    [2023] = { "atom", 4, 6 },
+    [2024] = { "bcpio", 5, 733 },
+    [2025] = { "m21", 3, 101 },
+    [2026] = { "ief", 3, 960 },
+    [2027] = { "tcap", 4, 218 },
+    [2028] = { "movie", 5, 1194 },
+    [2029] = { "slaz", 4, 601 },
+    [2030] = { "scld", 4, 316 },
+    [2031] = { "tar", 3, 793 },
+    [2032] = { "meta4", 5, 95 },
+    [2033] = { "mkv", 3, 1187 },
+    [2035] = { "kwd", 3, 434 },
+    [2036] = { "lrm", 3, 490 },
+    [2037] = { "cnd", 3, 1082 },
+    [2038] = { "rm", 2, 881 },
+    [2039] = { "rdz", 3, 304 },
+    [2041] = { "ac2", 3, 259 },
+    [2042] = { "p7s", 3, 128 },
+    [2043] = { "ros", 3, 931 },
+    [2044] = { "zfo", 3, 630 },
+    [2046] = { "held", 4, 12 },
+    [2047] = { "src", 3, 803 },
+};
@@ -0,0 +1,200 @@
+// Build-time generator for the MIME perfect hash.
+//
+//   cc -O2 -o mimegen mimegen.c && ./mimegen mime.types > mime_table.h
+//
+// Reads "type ext ext ..." lines and writes mime_table.h: the type names, a
+// displacement per bucket and one slot per extension. Buckets are placed
+// largest first, each trying seeds until all of its extensions land in free
+// slots (hash and displace).
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "mime.h"
+
+#define MAX_TYPES 4096
+#define MAX_EXTS 8192
+#define MAX_SEED 1000000
+
+struct ext {
+    char name[MIME_MAX_EXT + 1];
+    size_t len;
+    int type;
+    uint32_t bucket;
+};
+
+static char *types[MAX_TYPES];
+static int ntypes;
+static struct ext exts[MAX_EXTS];
+static int nexts;
+
+static int find_ext(const char *name) {
+    for (int i = 0; i < nexts; i++) {
+        if (strcmp(exts[i].name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int read_types(const char *path) {
+    FILE *f = fopen(path, "r");
+    char line[1024];
+    int lineno = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *save, *tok;
+
+        lineno++;
+        if (line[0] == '#' || (tok = strtok_r(line, " \t\r\n", &save)) == NULL) {
+            continue;
+        }
+        if (ntypes == MAX_TYPES) {
+            fprintf(stderr, "%s:%d: too many types\n", path, lineno);
+            return -1;
+        }
+        int type = ntypes;
+        types[ntypes++] = strdup(tok);
+
+        while ((tok = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+            size_t len = strlen(tok);
+
+            if (len == 0 || len > MIME_MAX_EXT || nexts == MAX_EXTS) {
+                fprintf(stderr, "%s:%d: skipping extension '%s'\n", path, lineno, tok);
+                continue;
+            }
+            for (size_t i = 0; i < len; i++) {
+                tok[i] = tolower((unsigned char)tok[i]);
+            }
+            int dup = find_ext(tok);
+            if (dup >= 0) {
+                fprintf(stderr, "%s:%d: '%s' already maps to %s\n", path, lineno, tok, types[exts[dup].type]);
+                continue;//first one wins
+            }
+            memcpy(exts[nexts].name, tok, len + 1);
+            exts[nexts].len = len;
+            exts[nexts].type = type;
+            nexts++;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static uint32_t pow2_at_least(uint32_t n) {
+    uint32_t p = 1;
+
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s mime.types > mime_table.h\n", argv[0]);
+        return 1;
+    }
+    if (read_types(argv[1]) < 0) {
+        return 1;
+    }
+
+    uint32_t nslots = pow2_at_least(nexts);//dense enough that the slots stay in cache
+    uint32_t nbuckets = pow2_at_least(nexts / 4 + 1);
+    uint32_t *disp = calloc(nbuckets, sizeof(*disp));
+    int *slot_ext = malloc(nslots * sizeof(*slot_ext));
+    int *bucket_size = calloc(nbuckets, sizeof(*bucket_size));
+    uint32_t *order = malloc(nbuckets * sizeof(*order));
+    uint32_t *tried = malloc(nexts * sizeof(*tried));
+
+    for (uint32_t i = 0; i < nslots; i++) {
+        slot_ext[i] = -1;
+    }
+    for (int i = 0; i < nexts; i++) {
+        exts[i].bucket = mime_hash(exts[i].name, exts[i].len, 0) & (nbuckets - 1);
+        bucket_size[exts[i].bucket]++;
+    }
+    for (uint32_t i = 0; i < nbuckets; i++) {
+        order[i] = i;
+    }
+    for (uint32_t i = 1; i < nbuckets; i++) {//insertion sort, largest bucket first
+        uint32_t b = order[i], j = i;
+
+        while (j > 0 && bucket_size[order[j - 1]] < bucket_size[b]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = b;
+    }
+
+    for (uint32_t k = 0; k < nbuckets && bucket_size[order[k]] > 0; k++) {
+        uint32_t b = order[k];
+        uint32_t seed;
+
+        for (seed = 1; seed < MAX_SEED; seed++) {
+            int n = 0, ok = 1;
+
+            for (int i = 0; i < nexts && ok; i++) {
+                if (exts[i].bucket != b) {
+                    continue;
+                }
+                uint32_t s = mime_hash(exts[i].name, exts[i].len, seed) & (nslots - 1);
+
+                ok = slot_ext[s] < 0;
+                for (int j = 0; j < n && ok; j++) {
+                    ok = tried[j] != s;
+                }
+                tried[n++] = s;
+            }
+            if (ok) {
+                n = 0;
+                for (int i = 0; i < nexts; i++) {
+                    if (exts[i].bucket == b) {
+                        slot_ext[tried[n++]] = i;
+                    }
+                }
+                break;
+            }
+        }
+        if (seed == MAX_SEED) {
+            fprintf(stderr, "no displacement found for bucket %u\n", b);
+            return 1;
+        }
+        disp[b] = seed;
+    }
+
+    printf("// Generated by mimegen from mime.types, do not edit.\n"
+           "// %d extensions, %d types\n\n", nexts, ntypes);
+    printf("#define MIME_BUCKETS %u\n#define MIME_SLOTS %u\n\n", nbuckets, nslots);
+
+    printf("static const char *const mime_names[%d] = {\n", ntypes);
+    for (int i = 0; i < ntypes; i++) {
+        printf("    \"%s\",\n", types[i]);
+    }
+    printf("};\n\n");
+
+    printf("static const uint32_t mime_disp[MIME_BUCKETS] = {");
+    for (uint32_t i = 0; i < nbuckets; i++) {
+        printf("%s%u,", i % 12 == 0 ? "\n    " : " ", disp[i]);
+    }
+    printf("\n};\n\n");
+
+    printf("// Empty slots have len 0, which no lookup has\n"
+           "static const struct mime_slot {\n"
+           "    const char *ext;\n"
+           "    uint8_t len;\n"
+           "    uint16_t type; // index in mime_names\n"
+           "} mime_slots[MIME_SLOTS] = {\n");
+    for (uint32_t i = 0; i < nslots; i++) {
+        if (slot_ext[i] >= 0) {
+            const struct ext *e = &exts[slot_ext[i]];
+            printf("    [%u] = { \"%s\", %zu, %d },\n", i, e->name, e->len, e->type);
+        }
+    }
+    printf("};\n");
+    return 0;
+}
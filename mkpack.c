@@ -0,0 +1,46 @@
+// Offline packer for the static site snapshot (see pack.h).
+//
+//   cc -O2 -o mkpack mkpack.c pack.c filecache.c path.c compress.c mime.c -lz
+//   ./mkpack [-z gzip_level] [-q brotli_quality] www site.pack
+//
+// then run the server with -o pack=site.pack. Packing again and restarting picks
+// up changes to www/; the pack is replaced with a rename, so a server
+// starting meanwhile never maps half of one.
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "pack.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr, "usage: %s [-z gzip_level] [-q brotli_quality] root out.pack\n", prog);
+}
+
+int main(int argc, char *argv[]) {
+    int gzip_level = 9, brotli_quality = 11;//spent once here, so the best ratio
+    int opt;
+
+    while ((opt = getopt(argc, argv, "z:q:")) != -1) {
+        switch (opt) {
+        case 'z':
+            gzip_level = atoi(optarg);
+            break;
+        case 'q':
+            brotli_quality = atoi(optarg);
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc - optind != 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    long n = pack_build(argv[optind], argv[optind + 1], gzip_level, brotli_quality);
+    if (n < 0) {
+        return 1;
+    }
+    printf("%s: %ld files\n", argv[optind + 1], n);
+    return 0;
+}
@@ -5,6 +5,8 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/sendfile.h>
 #include <fcntl.h>
 #include "httpserve.h"
 #define BACKLOG 32 
@@ -26,7 +28,36 @@ int main(int argc, char *argv[]) {
 
 
 
+// Send every byte of the gather list with as few sendmsg() calls as the
+// socket allows, resuming after short writes
+static void send_iov(int client_sock, struct iovec *iov, int iovcnt, int flags) {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iovcnt;
+
+    while (msg.msg_iovlen > 0) {
+        ssize_t n = sendmsg(client_sock, &msg, MSG_NOSIGNAL | flags);
+        if (n < 0) {
+            return;
+        }
+        while (msg.msg_iovlen > 0 && (size_t)n >= msg.msg_iov->iov_len) {//skip the buffers that are out
+            n -= msg.msg_iov->iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0) {
+            msg.msg_iov->iov_base = (char *)msg.msg_iov->iov_base + n;
+            msg.msg_iov->iov_len -= n;
+        }
+    }
+}
+
 void start_server(int port) {
+    if (path_init(SERVER_ROOT) < 0) {
+        perror("Error opening " SERVER_ROOT);
+        exit(EXIT_FAILURE);
+    }
     int server_sock = create_socket(port);
     handle_connections(server_sock);
     close(server_sock);
@@ -128,15 +159,18 @@ void process_request(int client_sock) {
 
 void handle_get_request(int client_sock, const char* path) {
     char filepath[1024];
-    snprintf(filepath, sizeof(filepath), "%s%s", SERVER_ROOT, path);
+    int len = path_normalize(path, strlen(path), filepath, sizeof(filepath) - sizeof("index.html"));
 
-    if (strstr(path, "../") || strstr(path, "//")) {
+    if (len < 0) {
         const char *response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
         send(client_sock, response, strlen(response), 0);
         return;
     }
+    if (len == 0 || filepath[len - 1] == '/') {
+        strcpy(filepath + len, "index.html");  // directory index
+    }
 
-    int file_fd = open(filepath, O_RDONLY);
+    int file_fd = path_open(filepath, O_RDONLY);
     if (file_fd < 0) {
         const char *response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
         send(client_sock, response, strlen(response), 0);
@@ -154,12 +188,13 @@ void handle_get_request(int client_sock, const char* path) {
     const char* mime_type = get_mime_type(filepath);
     char header[1024];
     snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\nContent-Length: %ld\r\nContent-Type: %s\r\n\r\n", file_stat.st_size, mime_type);
-    send(client_sock, header, strlen(header), 0);
+    send(client_sock, header, strlen(header), MSG_MORE);//corked until the file follows, so a small one fits one segment
 
-    char buffer[1024];
-    ssize_t bytes_read;
-    while ((bytes_read = read(file_fd, buffer, sizeof(buffer))) > 0) {
-        send(client_sock, buffer, bytes_read, 0);
+    off_t offset = 0;
+    while (offset < file_stat.st_size) {
+        if (sendfile(client_sock, file_fd, &offset, file_stat.st_size - offset) <= 0) {
+            break;
+        }
     }
 
     close(file_fd);
@@ -169,15 +204,18 @@ void handle_get_request(int client_sock, const char* path) {
 
 void handle_head_request(int client_sock, const char* path) {
     char filepath[1024];
-    snprintf(filepath, sizeof(filepath), "%s%s", SERVER_ROOT, path);
+    int len = path_normalize(path, strlen(path), filepath, sizeof(filepath) - sizeof("index.html"));
 
-    if (strstr(path, "../") || strstr(path, "//")) {
+    if (len < 0) {
         const char *response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
         send(client_sock, response, strlen(response), 0);
         return;
     }
+    if (len == 0 || filepath[len - 1] == '/') {
+        strcpy(filepath + len, "index.html");  // directory index
+    }
 
-    int file_fd = open(filepath, O_RDONLY);
+    int file_fd = path_open(filepath, O_RDONLY);
     if (file_fd < 0) {
         const char *response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
         send(client_sock, response, strlen(response), 0);
@@ -201,11 +239,12 @@ void handle_head_request(int client_sock, const char* path) {
 
 
 void handle_post_request(int client_sock, const char* path) {
-    char filepath[1024];
-    snprintf(filepath, sizeof(filepath), "%s%s", SERVER_ROOT, path);
+    char filepath[1024] = SERVER_ROOT;
+    size_t root = strlen(SERVER_ROOT);
 
-    // Security enhancement: prevent directory traversal
-    if (strstr(path, "../") != NULL || strstr(path, "./") != NULL || strstr(path, ".cgi") == NULL) {
+    // One normalization for every method keeps the script under the root
+    if (path_normalize(path, strlen(path), filepath + root, sizeof(filepath) - root) <= 0 ||
+        strstr(filepath, ".cgi") == NULL || !path_executable(filepath + root)) {
         const char *response = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
         send(client_sock, response, strlen(response), 0);
         return;
@@ -223,7 +262,7 @@ void handle_post_request(int client_sock, const char* path) {
     char buffer[4096]; // Increased buffer size for potential larger outputs
     size_t bytes_read;
     const char *header = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n\r\n";
-    send(client_sock, header, strlen(header), 0);  // Assume text/plain for simplicity
+    send(client_sock, header, strlen(header), MSG_MORE);  // Assume text/plain for simplicity; leaves with the first output
 
     // Stream output from script directly to client
     while ((bytes_read = fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
@@ -234,23 +273,28 @@ void handle_post_request(int client_sock, const char* path) {
 }
 
 void send_response(int client_sock, const char *header, const char *content_type, const char *body, int body_length) {
-    // Send the HTTP header first
-    send(client_sock, header, strlen(header), 0);
+    struct iovec iov[6];
+    int n = 0;
+
+    // Collect the status line, headers and body, then send them together
+    iov[n++] = (struct iovec){ (void *)header, strlen(header) };
 
     // Append content type if provided
     if (content_type != NULL) {
-        send(client_sock, "Content-Type: ", 14, 0);
-        send(client_sock, content_type, strlen(content_type), 0);
-        send(client_sock, "\r\n", 2, 0);
+        iov[n++] = (struct iovec){ "Content-Type: ", 14 };
+        iov[n++] = (struct iovec){ (void *)content_type, strlen(content_type) };
+        iov[n++] = (struct iovec){ "\r\n", 2 };
     }
 
     // Append a new line after the header (end of header section)
-    send(client_sock, "\r\n", 2, 0);
+    iov[n++] = (struct iovec){ "\r\n", 2 };
 
     // If there is a body to send, send it
     if (body != NULL && body_length > 0) {
-        send(client_sock, body, body_length, 0);
+        iov[n++] = (struct iovec){ (void *)body, body_length };
     }
+
+    send_iov(client_sock, iov, n, 0);
 }
 
 
@@ -0,0 +1,401 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "pack.h"
+#include "path.h"
+#include "mime.h"
+
+int pack_open(struct pack *p, const char *path) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    const struct pack_header *h;
+
+    memset(p, 0, sizeof(*p));
+    if (fd < 0 || fstat(fd, &st) < 0) {
+        fprintf(stderr, "pack %s: %s\n", path, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    if ((size_t)st.st_size < sizeof(*h)) {
+        fprintf(stderr, "pack %s: too short\n", path);
+        close(fd);
+        return -1;
+    }
+    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "pack %s: mmap: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    h = base;
+    if (memcmp(h->magic, PACK_MAGIC, sizeof(h->magic)) != 0 || h->record_size != sizeof(struct pack_file) ||
+        h->size != (uint64_t)st.st_size || h->index_off % PACK_ALIGN != 0 || h->index_off > h->size ||
+        (h->size - h->index_off) / sizeof(struct pack_file) < h->count) {
+        fprintf(stderr, "pack %s: not a pack, or written by another version\n", path);
+        munmap(base, st.st_size);
+        close(fd);
+        return -1;
+    }
+
+    p->base = base;
+    p->size = st.st_size;
+    p->fd = fd;
+    p->files = (const struct pack_file *)(p->base + h->index_off);
+    p->count = h->count;
+
+    // Check every offset once here, so lookups can trust them
+    for (uint32_t i = 0; i < p->count; i++) {
+        const struct pack_file *f = &p->files[i];
+        int ok = f->path_off < h->index_off && memchr(p->base + f->path_off, '\0', h->index_off - f->path_off) != NULL;
+
+        ok = ok && (i == 0 || strcmp(p->base + p->files[i - 1].path_off, p->base + f->path_off) < 0);
+        for (int j = 0; ok && j < CODING_COUNT; j++) {
+            const struct pack_variant *v = &f->variants[j];
+
+            ok = v->head_len == 0 || (v->head_off <= h->index_off && v->head_len <= h->index_off - v->head_off &&
+                                      v->body_off <= h->index_off && v->body_len <= h->index_off - v->body_off);
+        }
+        if (!ok) {
+            fprintf(stderr, "pack %s: corrupt index entry %u\n", path, i);
+            munmap(base, st.st_size);
+            close(fd);
+            memset(p, 0, sizeof(*p));
+            return -1;
+        }
+    }
+    madvise(base, st.st_size, MADV_WILLNEED);//a site snapshot is small and all of it is hot
+    return 0;
+}
+
+const struct pack_file *pack_lookup(const struct pack *p, const char *path) {
+    uint32_t lo = 0, hi = p->count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(path, p->base + p->files[mid].path_off);
+
+        if (cmp == 0) {
+            return &p->files[mid];
+        }
+        if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+int pack_directory(const struct pack *p, const char *path) {
+    char prefix[1100];
+    size_t len = (size_t)snprintf(prefix, sizeof(prefix), "%s/", path);
+    uint32_t lo = 0, hi = p->count;
+
+    if (len >= sizeof(prefix)) {
+        return 0;
+    }
+    while (lo < hi) {//first path not below prefix
+        uint32_t mid = lo + (hi - lo) / 2;
+
+        if (strcmp(p->base + p->files[mid].path_off, prefix) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < p->count && strncmp(p->base + p->files[lo].path_off, prefix, len) == 0;
+}
+
+const struct pack_variant *pack_variant(const struct pack_file *f, enum content_coding coding) {
+    const struct pack_variant *v = &f->variants[coding];
+
+    return v->head_len != 0 ? v : NULL;
+}
+
+void pack_rep(const struct pack_variant *v, const char *mime_type, enum content_coding coding,
+              int vary, struct file_rep *rep) {
+    rep->mime_type = mime_type;
+    rep->coding = coding;
+    rep->vary = vary;
+    rep->ino = v->ino;
+    rep->size = v->size;
+    rep->mtime.tv_sec = v->mtime_sec;
+    rep->mtime.tv_nsec = v->mtime_nsec;
+}
+
+// Paths collected by the walk
+struct path_list {
+    char **paths;
+    size_t n, cap;
+};
+
+static const char *pack_mime_type(const char *rel) {
+    const char *p = strrchr(rel, '.');//same rule as get_mime_type
+
+    if (!p || p == rel) {
+        return NULL;
+    }
+    return mime_lookup(p + 1, strlen(p + 1));
+}
+
+// Collect the regular files with a known type under the directory rel
+// ("" or ending in '/'). Only real directories are entered, so a symlink
+// cannot make the walk loop; symlinked files are taken if they stay beneath
+// the root, as the server would serve them.
+static int walk(const char *rel, struct path_list *out) {
+    int fd = path_open(rel, O_RDONLY | O_DIRECTORY);
+    DIR *dir = fd >= 0 ? fdopendir(fd) : NULL;
+    struct dirent *d;
+
+    if (dir == NULL) {
+        fprintf(stderr, "mkpack: %s: %s\n", *rel ? rel : ".", strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    while ((d = readdir(dir)) != NULL) {
+        char path[1024];
+        struct stat st;
+
+        if (strcmp(d->d_name, ".") == 0 || strcmp(d->d_name, "..") == 0) {
+            continue;
+        }
+        if ((size_t)snprintf(path, sizeof(path) - 16, "%s%s", rel, d->d_name) >= sizeof(path) - 16) {
+            continue;//too long for the server to ask for
+        }
+        if (fstatat(dirfd(dir), d->d_name, &st, AT_SYMLINK_NOFOLLOW) < 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            strcat(path, "/");
+            if (walk(path, out) < 0) {
+                closedir(dir);
+                return -1;
+            }
+            continue;
+        }
+        if (pack_mime_type(path) == NULL) {
+            continue;//the server answers 415 for these, from the path alone
+        }
+        if (out->n == out->cap) {
+            size_t cap = out->cap ? out->cap * 2 : 256;
+            char **grown = realloc(out->paths, cap * sizeof(*grown));
+
+            if (grown == NULL) {
+                closedir(dir);
+                return -1;
+            }
+            out->paths = grown;
+            out->cap = cap;
+        }
+        if ((out->paths[out->n] = strdup(path)) == NULL) {
+            closedir(dir);
+            return -1;
+        }
+        out->n++;
+    }
+    closedir(dir);
+    return 0;
+}
+
+static int compare_paths(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// Read a whole regular file beneath the root; 1 if it is not one
+static int read_file(const char *rel, char **data, size_t *len, struct stat *st) {
+    int fd = path_open(rel, O_RDONLY | O_NONBLOCK);
+    size_t got = 0;
+
+    *data = NULL;
+    if (fd < 0) {
+        return 1;
+    }
+    if (fstat(fd, st) < 0 || !S_ISREG(st->st_mode)) {
+        close(fd);
+        return 1;
+    }
+    if ((*data = malloc(st->st_size ? st->st_size : 1)) == NULL) {
+        close(fd);
+        return -1;
+    }
+    while (got < (size_t)st->st_size) {
+        ssize_t n = read(fd, *data + got, st->st_size - got);
+
+        if (n <= 0) {
+            break;
+        }
+        got += n;
+    }
+    close(fd);
+    if (got != (size_t)st->st_size) {
+        fprintf(stderr, "mkpack: %s changed while being read\n", rel);
+        free(*data);
+        return -1;
+    }
+    *len = got;
+    return 0;
+}
+
+// Append len bytes at the next aligned offset; returns that offset
+static uint64_t put(FILE *out, uint64_t *off, const void *data, size_t len, size_t align) {
+    static const char zeros[PACK_ALIGN];
+    size_t pad = (align - *off % align) % align;
+    uint64_t at;
+
+    fwrite(zeros, 1, pad, out);
+    at = *off + pad;
+    fwrite(data, 1, len, out);
+    *off = at + len;
+    return at;
+}
+
+// Write one variant's head and body
+static int put_variant(FILE *out, uint64_t *off, struct pack_variant *v, const struct file_rep *rep,
+                       const char *data, size_t len) {
+    char head[512];
+    int n = format_file_head(head, sizeof(head), rep, len);
+
+    if (n < 0 || (size_t)n >= sizeof(head)) {
+        return -1;
+    }
+    v->head_off = put(out, off, head, n, 1);
+    v->head_len = n;
+    v->body_off = put(out, off, data, len, PACK_ALIGN);
+    v->body_len = len;
+    v->ino = rep->ino;
+    v->size = rep->size;
+    v->mtime_sec = rep->mtime.tv_sec;
+    v->mtime_nsec = rep->mtime.tv_nsec;
+    return 0;
+}
+
+// Write the file at rel and its variants; 1 if it vanished since the walk
+static int put_file(FILE *out, uint64_t *off, const char *rel, struct pack_file *f,
+                    int gzip_level, int brotli_quality) {
+    const char *mime_type = pack_mime_type(rel);
+    int vary = compressible_type(mime_type);
+    struct stat st;
+    struct file_rep rep;
+    char *data;
+    size_t len;
+    int r = read_file(rel, &data, &len, &st);
+
+    if (r != 0) {
+        return r;
+    }
+    memset(f, 0, sizeof(*f));
+    f->path_off = put(out, off, rel, strlen(rel) + 1, 1);
+    file_rep_init(&rep, &st, mime_type, CODING_IDENTITY, vary);
+    r = put_variant(out, off, &f->variants[CODING_IDENTITY], &rep, data, len);
+
+    for (int coding = CODING_IDENTITY + 1; r == 0 && vary && coding < CODING_COUNT; coding++) {
+        char sidecar[1100];
+        struct stat sst;
+        struct file_rep crep;
+        char *cdata;
+        size_t clen;
+
+        snprintf(sidecar, sizeof(sidecar), "%s%s", rel, coding_suffix(coding));
+        int s = read_file(sidecar, &cdata, &clen, &sst);
+        if (s < 0) {
+            r = -1;
+            break;
+        }
+        if (s == 0) {//compressed ahead of time: sent as the server would send the sidecar
+            file_rep_init(&crep, &sst, mime_type, coding, 1);
+        } else if (!coding_available(coding) ||
+                   compress_buffer(coding, coding == CODING_BR ? brotli_quality : gzip_level, data, len,
+                                   &cdata, &clen) < 0) {
+            continue;//no encoder, or it does not shrink
+        } else {
+            crep = rep;
+            crep.coding = coding;
+            crep.vary = 1;
+        }
+        r = put_variant(out, off, &f->variants[coding], &crep, cdata, clen);
+        free(cdata);
+    }
+    free(data);
+    return r;
+}
+
+long pack_build(const char *root, const char *out_path, int gzip_level, int brotli_quality) {
+    struct path_list list = {0};
+    struct pack_file *files = NULL;
+    struct pack_header h = {0};
+    char tmp[1100];
+    FILE *out = NULL;
+    uint64_t off = 0;
+    long count = -1;
+
+    if (path_init(root) < 0) {
+        fprintf(stderr, "mkpack: %s: %s\n", root, strerror(errno));
+        return -1;
+    }
+    if (walk("", &list) < 0) {
+        goto done;
+    }
+    qsort(list.paths, list.n, sizeof(*list.paths), compare_paths);
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", out_path);
+    files = calloc(list.n ? list.n : 1, sizeof(*files));
+    if (files == NULL || (out = fopen(tmp, "wb")) == NULL) {
+        fprintf(stderr, "mkpack: %s: %s\n", tmp, strerror(errno));
+        goto done;
+    }
+    put(out, &off, &h, sizeof(h), 1);//placeholder, rewritten once the index is placed
+
+    size_t n = 0;
+    for (size_t i = 0; i < list.n; i++) {
+        int r = put_file(out, &off, list.paths[i], &files[n], gzip_level, brotli_quality);
+
+        if (r < 0) {
+            fprintf(stderr, "mkpack: %s: could not pack\n", list.paths[i]);
+            goto done;
+        }
+        n += r == 0;//skipped if it is no longer a regular file
+    }
+
+    memcpy(h.magic, PACK_MAGIC, sizeof(h.magic));
+    h.count = n;
+    h.record_size = sizeof(*files);
+    h.index_off = put(out, &off, files, n * sizeof(*files), PACK_ALIGN);
+    h.size = off;
+    if (fseek(out, 0, SEEK_SET) < 0 || fwrite(&h, sizeof(h), 1, out) != 1 || fflush(out) != 0 ||
+        ferror(out) || fsync(fileno(out)) < 0) {
+        fprintf(stderr, "mkpack: %s: %s\n", tmp, strerror(errno));
+        goto done;
+    }
+    if (fclose(out) != 0 || rename(tmp, out_path) < 0) {//readers see the old pack or the whole new one
+        out = NULL;
+        fprintf(stderr, "mkpack: %s: %s\n", out_path, strerror(errno));
+        unlink(tmp);
+        goto done;
+    }
+    out = NULL;
+    count = n;
+
+done:
+    if (out != NULL) {
+        fclose(out);
+        unlink(tmp);
+    }
+    for (size_t i = 0; i < list.n; i++) {
+        free(list.paths[i]);
+    }
+    free(list.paths);
+    free(files);
+    return count;
+}
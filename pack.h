@@ -0,0 +1,82 @@
+#ifndef PACK_H
+#define PACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "filecache.h"
+
+// A snapshot of a static site in one read-only file, for deployments whose
+// www/ never changes while the server runs. mkpack (or pack_build) walks
+// the document root once and writes every servable file with its ready-made
+// 200 head and its compressed variants; the server maps the pack and serves
+// static requests from the mapping (bodies over cache_max_file with sendfile
+// from the same file) without touching the filesystem. The mapping is shared
+// by all workers through the page cache.
+//
+// Layout, in host byte order: a pack_header, then for each file its path
+// and the heads and bodies of its variants, then the index of pack_file
+// records sorted by path (strcmp order) for binary search.
+
+#define PACK_MAGIC "HSPACK1"    // 8 bytes with the NUL
+#define PACK_ALIGN 16           // bodies and the index start on this boundary
+
+struct pack_header {
+    char magic[8];
+    uint32_t count;         // files in the index
+    uint32_t record_size;   // sizeof(struct pack_file) of the packer
+    uint64_t index_off;
+    uint64_t size;          // of the whole pack, to catch truncation
+};
+
+// One representation of a file, absent when head_len is 0
+struct pack_variant {
+    uint64_t head_off;      // status line and file headers, like cache_entry.head
+    uint64_t body_off;
+    uint64_t body_len;
+    uint32_t head_len;
+    uint32_t pad;
+    uint64_t ino;           // identity the ETag is built from: the file's, or
+    int64_t size;           // the sidecar's when the variant came from one
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+};
+
+struct pack_file {
+    uint64_t path_off;      // normalized path under the root, NUL terminated
+    struct pack_variant variants[CODING_COUNT]; // by content coding
+};
+
+// A mapped pack
+struct pack {
+    const char *base;       // NULL when no pack is in use
+    size_t size;
+    int fd;                 // kept open to sendfile large bodies from
+    const struct pack_file *files;
+    uint32_t count;
+};
+
+// Map the pack at path and check its layout. Returns -1, after printing
+// why, if it cannot be used.
+int pack_open(struct pack *p, const char *path);
+
+// The file at a normalized path, NULL if the pack does not have it
+const struct pack_file *pack_lookup(const struct pack *p, const char *path);
+
+// Does the pack hold files under the directory path (no trailing '/')?
+int pack_directory(const struct pack *p, const char *path);
+
+// The variant of f in coding, NULL if the pack has none
+const struct pack_variant *pack_variant(const struct pack_file *f, enum content_coding coding);
+
+// Representation v of a file of type mime_type, for validators and ranges
+void pack_rep(const struct pack_variant *v, const char *mime_type, enum content_coding coding,
+              int vary, struct file_rep *rep);
+
+// Walk root and write a pack of every regular file with a known MIME type
+// to out (through a temporary file renamed into place). Compressible types
+// get gzip and brotli variants from sidecars (foo.js.gz) where present, else
+// compressed at the given levels where the build supports it. Returns the
+// number of files packed, or -1 after printing why.
+long pack_build(const char *root, const char *out, int gzip_level, int brotli_quality);
+
+#endif // PACK_H
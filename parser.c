@@ -0,0 +1,445 @@
+#include <string.h>
+#include <strings.h>
+#include "parser.h"
+#include "scan.h"
+
+#define KEY4(a, b, c, d) ((uint32_t)(a) | (uint32_t)(b) << 8 | (uint32_t)(c) << 16 | (uint32_t)(d) << 24)
+
+void http_parser_init(struct http_request *r) {
+    r->in_headers = 0;
+    r->line_start = 0;
+    r->scan = 0;
+    r->method = HTTP_UNKNOWN;
+    r->nheaders = 0;
+    r->head_len = 0;
+    r->content_length = -1;
+    r->chunked = 0;
+    r->te_seen = 0;
+    r->te_other = 0;
+    r->conn_close = 0;
+    r->conn_keep_alive = 0;
+}
+
+// Map a method token to its enum with integer compares on the first four bytes
+static enum http_method method_lookup(const char *p, size_t len) {
+    uint32_t key;
+
+    if (len < 3 || len > 7) {
+        return HTTP_UNKNOWN;
+    }
+    key = KEY4(p[0], p[1], p[2], len > 3 ? p[3] : 0);
+
+    switch (len) {
+    case 3:
+        switch (key) {
+        case KEY4('G', 'E', 'T', 0): return HTTP_GET;
+        case KEY4('P', 'U', 'T', 0): return HTTP_PUT;
+        }
+        break;
+    case 4:
+        switch (key) {
+        case KEY4('H', 'E', 'A', 'D'): return HTTP_HEAD;
+        case KEY4('P', 'O', 'S', 'T'): return HTTP_POST;
+        }
+        break;
+    case 5:
+        switch (key) {
+        case KEY4('P', 'A', 'T', 'C'): return p[4] == 'H' ? HTTP_PATCH : HTTP_UNKNOWN;
+        case KEY4('T', 'R', 'A', 'C'): return p[4] == 'E' ? HTTP_TRACE : HTTP_UNKNOWN;
+        }
+        break;
+    case 6:
+        if (key == KEY4('D', 'E', 'L', 'E') && p[4] == 'T' && p[5] == 'E') {
+            return HTTP_DELETE;
+        }
+        break;
+    case 7:
+        switch (key) {
+        case KEY4('O', 'P', 'T', 'I'): return memcmp(p + 4, "ONS", 3) == 0 ? HTTP_OPTIONS : HTTP_UNKNOWN;
+        case KEY4('C', 'O', 'N', 'N'): return memcmp(p + 4, "ECT", 3) == 0 ? HTTP_CONNECT : HTTP_UNKNOWN;
+        }
+        break;
+    }
+    return HTTP_UNKNOWN;
+}
+
+// "METHOD SP target SP HTTP/1.x"
+static enum parse_result parse_request_line(struct http_request *r, const char *buf, size_t start, size_t end,
+                                            const struct http_limits *lim) {
+    size_t p = start + scan_token(buf + start, end - start);
+
+    if (p == start || p >= end || buf[p] != ' ') {
+        return PARSE_BAD_REQUEST;
+    }
+    r->method_name.off = start;
+    r->method_name.len = p - start;
+    r->method = method_lookup(buf + start, p - start);
+
+    size_t t = ++p;
+    p += scan_uri(buf + p, end - p);
+    if (p - t > lim->max_uri) {
+        return PARSE_URI_TOO_LONG;
+    }
+    if (p == t || p >= end || buf[p] != ' ') {
+        return PARSE_BAD_REQUEST;
+    }
+    r->target.off = t;
+    r->target.len = p - t;
+
+    p++;
+    if (end - p != 8 || memcmp(buf + p, "HTTP/1.", 7) != 0 || buf[p + 7] < '0' || buf[p + 7] > '9') {
+        return PARSE_BAD_REQUEST;
+    }
+    r->version_minor = buf[p + 7] - '0';
+    return PARSE_DONE;
+}
+
+// Is the target of the request line at buf[start] over max_uri within what
+// the buffer holds up to len, looking no further than max_head? Judged the
+// same for a line cut short and a whole one, so the status does not depend
+// on how the head arrived.
+static int target_too_long(const char *buf, size_t start, size_t len, const struct http_limits *lim) {
+    size_t end = len < lim->max_head ? len : lim->max_head;
+
+    if (end <= start) {
+        return 0;
+    }
+    size_t p = start + scan_token(buf + start, end - start);
+    if (p == start || p >= end || buf[p] != ' ') {
+        return 0;
+    }
+    p++;
+    return scan_uri(buf + p, end - p) > lim->max_uri;
+}
+
+static int span_equals(const char *buf, const struct http_span *s, const char *lower) {
+    return s->len == strlen(lower) && strncasecmp(buf + s->off, lower, s->len) == 0;
+}
+
+// Transfer-Encoding codings in order, across repeated headers. chunked must
+// come last and only once, or the body's end cannot be told (RFC 9112 6.1).
+static enum parse_result parse_transfer_encoding(struct http_request *r, const char *buf,
+                                                 const struct http_span *value) {
+    const char *p = buf + value->off;
+    const char *end = p + value->len;
+
+    r->te_seen = 1;
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) {
+            p++;
+        }
+        const char *item = p;
+        while (p < end && *p != ',') {
+            p++;
+        }
+        const char *item_end = p;
+        while (item_end > item && (item_end[-1] == ' ' || item_end[-1] == '\t')) {
+            item_end--;
+        }
+        if (item == item_end) {
+            continue;
+        }
+        if (r->chunked) {
+            return PARSE_BAD_REQUEST;//a coding after chunked
+        }
+        if (item_end - item == 7 && strncasecmp(item, "chunked", 7) == 0) {
+            r->chunked = 1;
+        } else {
+            r->te_other = 1;
+        }
+    }
+    return PARSE_DONE;
+}
+
+// Note the headers the server itself acts on while they are in cache
+static enum parse_result index_header(struct http_request *r, const char *buf, const struct http_header *h) {
+    switch (h->name.len) {
+    case 10:
+        if (span_equals(buf, &h->name, "connection")) {
+            r->conn_close |= http_has_token(buf, &h->value, "close");
+            r->conn_keep_alive |= http_has_token(buf, &h->value, "keep-alive");
+        }
+        break;
+    case 14:
+        if (span_equals(buf, &h->name, "content-length")) {
+            long long v = 0;
+
+            if (h->value.len == 0 || h->value.len > 18) {
+                return PARSE_BAD_REQUEST;
+            }
+            for (uint32_t i = 0; i < h->value.len; i++) {
+                char ch = buf[h->value.off + i];
+                if (ch < '0' || ch > '9') {
+                    return PARSE_BAD_REQUEST;
+                }
+                v = v * 10 + (ch - '0');
+            }
+            if (r->content_length >= 0 && r->content_length != v) {
+                return PARSE_BAD_REQUEST;//conflicting lengths smell like smuggling
+            }
+            r->content_length = v;
+        }
+        break;
+    case 17:
+        if (span_equals(buf, &h->name, "transfer-encoding")) {
+            return parse_transfer_encoding(r, buf, &h->value);
+        }
+        break;
+    }
+    return PARSE_DONE;
+}
+
+// "name: value" with optional whitespace around the value
+static enum parse_result parse_header_line(struct http_request *r, const char *buf, size_t start, size_t end,
+                                           const struct http_limits *lim) {
+    size_t p = start + scan_token(buf + start, end - start);
+
+    if (p == start || p >= end || buf[p] != ':') {
+        return PARSE_BAD_REQUEST;//also rejects obsolete line folding
+    }
+    if (r->nheaders >= lim->max_headers || r->nheaders >= MAX_HEADERS) {
+        return PARSE_HEAD_TOO_BIG;
+    }
+
+    struct http_header *h = &r->headers[r->nheaders++];
+    h->name.off = start;
+    h->name.len = p - start;
+
+    p++;
+    while (p < end && (buf[p] == ' ' || buf[p] == '\t')) {
+        p++;
+    }
+    size_t v_end = end;
+    while (v_end > p && (buf[v_end - 1] == ' ' || buf[v_end - 1] == '\t')) {
+        v_end--;
+    }
+    if (scan_value(buf + p, v_end - p) != v_end - p) {
+        return PARSE_BAD_REQUEST;//stray control character
+    }
+    h->value.off = p;
+    h->value.len = v_end - p;
+    return index_header(r, buf, h);
+}
+
+enum parse_result http_parse(struct http_request *r, const char *buf, size_t len,
+                             const struct http_limits *lim) {
+    for (;;) {
+        size_t from = r->line_start + r->scan;
+        const char *nl = from < len ? memchr(buf + from, '\n', len - from) : NULL;
+
+        if (nl == NULL) {
+            r->scan = len - r->line_start;//don't search these bytes again
+            if (!r->in_headers && r->scan > lim->max_uri && target_too_long(buf, r->line_start, len, lim)) {
+                return PARSE_URI_TOO_LONG;//no need to wait for the rest of the line
+            }
+            return len > lim->max_head ? PARSE_HEAD_TOO_BIG : PARSE_INCOMPLETE;
+        }
+
+        size_t next = nl - buf + 1;
+        size_t end = nl - buf;
+        if (end > r->line_start && buf[end - 1] == '\r') {
+            end--;
+        }
+        if (next > lim->max_head) {
+            return !r->in_headers && target_too_long(buf, r->line_start, end, lim) ? PARSE_URI_TOO_LONG
+                                                                                 : PARSE_HEAD_TOO_BIG;
+        }
+
+        enum parse_result res;
+        if (!r->in_headers) {
+            if (end == r->line_start && r->line_start == 0) {
+                res = PARSE_DONE;//tolerate a stray CRLF before the request
+            } else {
+                res = parse_request_line(r, buf, r->line_start, end, lim);
+                r->in_headers = 1;
+            }
+        } else if (end == r->line_start) {
+            if (r->te_seen && !r->chunked) {
+                return PARSE_BAD_REQUEST;//no way to find the end of the body
+            }
+            if (r->te_other) {
+                return PARSE_NOT_IMPLEMENTED;
+            }
+            r->head_len = next;
+            return PARSE_DONE;
+        } else {
+            res = parse_header_line(r, buf, r->line_start, end, lim);
+        }
+        if (res != PARSE_DONE) {
+            return res;
+        }
+        r->line_start = next;
+        r->scan = 0;
+    }
+}
+
+const struct http_span *http_find_header(const struct http_request *r, const char *buf, const char *name) {
+    size_t len = strlen(name);
+
+    for (int i = 0; i < r->nheaders; i++) {
+        const struct http_header *h = &r->headers[i];
+        if (h->name.len == len && strncasecmp(buf + h->name.off, name, len) == 0) {
+            return &h->value;
+        }
+    }
+    return NULL;
+}
+
+int http_has_token(const char *buf, const struct http_span *value, const char *token) {
+    size_t token_len = strlen(token);
+    const char *p = buf + value->off;
+    const char *end = p + value->len;
+
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) {
+            p++;
+        }
+        const char *item = p;
+        while (p < end && *p != ',') {
+            p++;
+        }
+        const char *item_end = p;
+        while (item_end > item && (item_end[-1] == ' ' || item_end[-1] == '\t')) {
+            item_end--;
+        }
+        if ((size_t)(item_end - item) == token_len && strncasecmp(item, token, token_len) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// "q=0.xyz" style weight in thousandths, 1000 when malformed
+static int parse_qvalue(const char *p, const char *end) {
+    int q = 0;
+    int digits = 0;
+
+    if (p == end || (*p != '0' && *p != '1')) {
+        return 1000;
+    }
+    q = (*p++ - '0') * 1000;
+    if (p < end && *p == '.') {
+        p++;
+        for (int scale = 100; p < end && *p >= '0' && *p <= '9' && digits < 3; scale /= 10, digits++) {
+            q += (*p++ - '0') * scale;
+        }
+    }
+    return q > 1000 ? 1000 : q;
+}
+
+int http_qvalue(const char *buf, const struct http_span *value, const char *token) {
+    size_t token_len = strlen(token);
+    const char *p = buf + value->off;
+    const char *end = p + value->len;
+    int star = -1;
+
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) {
+            p++;
+        }
+        const char *item = p;
+        while (p < end && *p != ',' && *p != ';' && *p != ' ' && *p != '\t') {
+            p++;
+        }
+        size_t item_len = p - item;
+        int q = 1000;
+
+        while (p < end && *p != ',') {//parameters, only q matters
+            if ((*p == 'q' || *p == 'Q') && p + 1 < end && p[1] == '=' && (p[-1] == ';' || p[-1] == ' ')) {
+                q = parse_qvalue(p + 2, end);
+            }
+            p++;
+        }
+        if (item_len == token_len && strncasecmp(item, token, token_len) == 0) {
+            return q;
+        }
+        if (item_len == 1 && *item == '*') {
+            star = q;
+        }
+    }
+    return star;
+}
+
+// Read a decimal byte position; *v stays -1 when there are no digits
+static int read_pos(const char **pp, const char *end, long long *v) {
+    const char *p = *pp;
+
+    *v = -1;
+    if (p == end || *p < '0' || *p > '9') {
+        return 0;
+    }
+    *v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (*v > (0x7fffffffffffffffLL - 9) / 10) {
+            return -1;
+        }
+        *v = *v * 10 + (*p++ - '0');
+    }
+    *pp = p;
+    return 0;
+}
+
+int http_parse_range(const char *buf, const struct http_span *value, long long size,
+                     struct http_range *out, int max) {
+    const char *p = buf + value->off;
+    const char *end = p + value->len;
+    long long total = 0;
+    int specs = 0;
+    int n = 0;
+
+    if (end - p < 6 || strncasecmp(p, "bytes=", 6) != 0) {
+        return -1;
+    }
+    p += 6;
+
+    while (p < end) {
+        long long first, last;
+
+        while (p < end && (*p == ' ' || *p == '\t' || *p == ',')) {
+            p++;
+        }
+        if (p == end) {
+            break;
+        }
+        if (read_pos(&p, end, &first) < 0 || p == end || *p++ != '-' || read_pos(&p, end, &last) < 0) {
+            return -1;
+        }
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            p++;
+        }
+        if (p < end && *p != ',') {
+            return -1;
+        }
+        specs++;
+
+        if (first < 0) {//suffix: the final last bytes
+            if (last < 0) {
+                return -1;
+            }
+            if (last == 0 || size == 0) {
+                continue;
+            }
+            first = last >= size ? 0 : size - last;
+            last = size - 1;
+        } else {
+            if (last >= 0 && last < first) {
+                return -1;
+            }
+            if (first >= size) {
+                continue;//unsatisfiable, the others may still be fine
+            }
+            if (last < 0 || last >= size) {
+                last = size - 1;
+            }
+        }
+
+        total += last - first + 1;
+        if (n == max || total > size) {
+            return -1;//overlapping or piecemeal requests get the whole file instead
+        }
+        out[n].first = first;
+        out[n].last = last;
+        n++;
+    }
+    return specs > 0 ? n : -1;
+}
@@ -0,0 +1,103 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MAX_HEADERS 64
+#define MAX_RANGES 16
+
+enum http_method {
+    HTTP_UNKNOWN,
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_DELETE,
+    HTTP_OPTIONS,
+    HTTP_PATCH,
+    HTTP_TRACE,
+    HTTP_CONNECT,
+};
+
+enum parse_result {
+    PARSE_INCOMPLETE,   // need more bytes
+    PARSE_DONE,         // head complete, see head_len
+    PARSE_BAD_REQUEST,  // 400
+    PARSE_URI_TOO_LONG, // 414
+    PARSE_HEAD_TOO_BIG, // 431: head or header count over the limit
+    PARSE_NOT_IMPLEMENTED, // 501: a transfer coding other than chunked
+};
+
+// Bytes of the connection buffer a token occupies
+struct http_span {
+    uint32_t off;
+    uint32_t len;
+};
+
+struct http_header {
+    struct http_span name;
+    struct http_span value;
+};
+
+// One satisfiable byte range, both ends inclusive
+struct http_range {
+    long long first;
+    long long last;
+};
+
+struct http_limits {
+    size_t max_head;    // request line plus headers, blank line included
+    size_t max_uri;     // request target
+    int max_headers;    // at most MAX_HEADERS
+};
+
+// Parser state and result for one request. Everything points into the
+// caller's buffer, so the buffer must not move while the request is in use.
+struct http_request {
+    int in_headers;     // request line already parsed
+    size_t line_start;  // start of the line being parsed
+    size_t scan;        // bytes of that line already searched for '\n'
+
+    enum http_method method;
+    struct http_span method_name;
+    struct http_span target;
+    int version_minor;  // x in HTTP/1.x
+    struct http_header headers[MAX_HEADERS];
+    int nheaders;
+    size_t head_len;    // through the blank line, valid once PARSE_DONE
+
+    long long content_length; // -1 when absent
+    int chunked;        // Transfer-Encoding ends in chunked, which frames the body
+    int te_seen;        // Transfer-Encoding present; without chunked last it is a 400
+    int te_other;       // a coding before chunked that we cannot undo
+    int conn_close;     // Connection: close
+    int conn_keep_alive; // Connection: keep-alive
+};
+
+// Reset for a new request starting at offset 0 of the buffer
+void http_parser_init(struct http_request *r);
+
+// Continue parsing buf[0..len); call again with the same (grown) buffer
+// after more bytes arrive. Work already done is not repeated.
+enum parse_result http_parse(struct http_request *r, const char *buf, size_t len,
+                             const struct http_limits *lim);
+
+// Value of the first header called name (case-insensitive), or NULL
+const struct http_span *http_find_header(const struct http_request *r, const char *buf, const char *name);
+
+// Does a comma separated header value contain token (case-insensitive)?
+int http_has_token(const char *buf, const struct http_span *value, const char *token);
+
+// Weight a list like Accept-Encoding gives token, in thousandths (q=0.5 is
+// 500). Falls back to the weight of "*", and returns -1 if neither is listed.
+int http_qvalue(const char *buf, const struct http_span *value, const char *token);
+
+// Resolve a Range header value against a representation of size bytes.
+// Returns how many ranges were stored in out, 0 if none is satisfiable (416),
+// or -1 if the header is to be ignored: bad syntax, not in bytes, more than
+// max ranges, or ranges that add up to more than the whole representation.
+int http_parse_range(const char *buf, const struct http_span *value, long long size,
+                     struct http_range *out, int max);
+
+#endif // PARSER_H
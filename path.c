@@ -0,0 +1,119 @@
+#define _GNU_SOURCE
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/syscall.h>
+#include <linux/openat2.h>
+#include "path.h"
+
+static int root_fd = -1;
+static int have_openat2 = 1;    // cleared the first time the kernel says ENOSYS
+
+int path_init(const char *root) {
+    root_fd = open(root, O_PATH | O_DIRECTORY | O_CLOEXEC);
+    return root_fd < 0 ? -1 : 0;
+}
+
+static int hex_value(int ch) {
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    }
+    ch |= 0x20;//lower case
+    return ch >= 'a' && ch <= 'f' ? ch - 'a' + 10 : -1;
+}
+
+int path_normalize(const char *target, size_t len, char *out, size_t cap) {
+    size_t i = 0, n = 0;
+    size_t seg = 0;         // where the segment being copied starts in out
+
+    if (len == 0 || target[0] != '/' || cap == 0) {
+        return -1;
+    }
+    for (;;) {
+        int ch = -1;        // -1: end of the path
+
+        if (i < len && target[i] != '?' && target[i] != '#') {
+            ch = (unsigned char)target[i++];
+            if (ch == '%') {//decoded before segments are split, so %2e%2e and %2f are no way around the checks below
+                int hi = i + 1 < len ? hex_value(target[i]) : -1;
+                int lo = hi >= 0 ? hex_value(target[i + 1]) : -1;
+
+                if (lo < 0 || (hi == 0 && lo == 0)) {
+                    return -1;
+                }
+                ch = hi << 4 | lo;
+                i += 2;
+            }
+        }
+
+        if (ch != '/' && ch != -1) {
+            if (n + 1 >= cap) {
+                return -1;
+            }
+            out[n++] = ch;
+            continue;
+        }
+
+        // A segment ended: out[seg, n) is it
+        if (n - seg == 1 && out[seg] == '.') {
+            n = seg;
+        } else if (n - seg == 2 && out[seg] == '.' && out[seg + 1] == '.') {
+            if (seg == 0) {
+                return -1;//above the root
+            }
+            n = seg - 1;//drop the parent and its slash
+            while (n > 0 && out[n - 1] != '/') {
+                n--;
+            }
+        } else if (n > seg && ch == '/') {
+            if (n + 1 >= cap) {
+                return -1;
+            }
+            out[n++] = '/';
+        }
+        seg = n;
+        if (ch == -1) {
+            break;
+        }
+    }
+    out[n] = '\0';
+    return (int)n;
+}
+
+int path_open(const char *rel, int flags) {
+    const char *p = *rel ? rel : ".";
+
+    if (have_openat2) {
+        struct open_how how = {
+            .flags = flags | O_CLOEXEC,
+            .resolve = RESOLVE_BENEATH | RESOLVE_NO_MAGICLINKS,
+        };
+        int fd = (int)syscall(SYS_openat2, root_fd, p, &how, sizeof(how));
+
+        if (fd >= 0 || errno != ENOSYS) {
+            return fd;
+        }
+        have_openat2 = 0;
+    }
+    // Kernels before 5.6: a normalized path has no ".." to climb with, but
+    // a symlink under the root is followed wherever it points
+    return openat(root_fd, p, flags | O_CLOEXEC);
+}
+
+int path_stat(const char *rel, struct stat *st) {
+    return fstatat(root_fd, *rel ? rel : ".", st, 0);
+}
+
+int path_executable(const char *rel) {
+    int fd = path_open(rel, O_PATH);
+    struct stat st;
+    int ok;
+
+    if (fd < 0) {
+        return 0;
+    }
+    ok = fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && faccessat(root_fd, rel, X_OK, 0) == 0;
+    close(fd);
+    return ok;
+}
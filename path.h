@@ -0,0 +1,36 @@
+#ifndef PATH_H
+#define PATH_H
+
+#include <stddef.h>
+#include <sys/stat.h>
+
+// Request targets become paths relative to the document root in one place.
+// A target is percent-decoded and normalized in a single pass into the
+// caller's buffer: the query is cut off, empty and "." segments dropped and
+// ".." applied, so the result never starts with '/' and never contains a
+// "." or ".." segment. Files are then opened relative to a descriptor of the
+// root with openat2(RESOLVE_BENEATH), which also keeps symlinks from leading
+// out of it; the kernel walks the path once, under the root.
+
+// Open the document root; call once before any worker runs. Returns -1
+// (errno set) if it is not a directory that can be opened.
+int path_init(const char *root);
+
+// Normalize the first len bytes of target (less if a '?' or '#' comes
+// first) into out, NUL terminated. Returns the length written, which is 0
+// for the root and ends in '/' when the target named a directory. -1 if the
+// target is not an absolute path, has a bad or NUL escape, climbs above
+// the root or does not fit in cap bytes.
+int path_normalize(const char *target, size_t len, char *out, size_t cap);
+
+// openat2() a normalized path beneath the root ("" is the root itself);
+// O_CLOEXEC is always added. Returns the descriptor or -1 with errno set.
+int path_open(const char *rel, int flags);
+
+// stat() a normalized path relative to the root
+int path_stat(const char *rel, struct stat *st);
+
+// Is rel a regular file beneath the root that this process may execute?
+int path_executable(const char *rel);
+
+#endif // PATH_H
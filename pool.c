@@ -0,0 +1,196 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "pool.h"
+
+#define SLAB_CHUNK_BYTES (256 << 10) // taken from the system at a time, unless one object is bigger
+#define CHUNK_HEADER 16              // chunk link, keeps objects 16-byte aligned
+#define ARENA_CHUNK (16 << 10)       // usual arena chunk, from the buffer pool
+
+struct arena_chunk {
+    struct arena_chunk *next;
+    size_t cap;             // of the whole buffer, header included
+};
+
+void slab_init(struct slab *s, size_t size, unsigned per_chunk) {
+    memset(s, 0, sizeof(*s));
+    s->size = (size + 15) & ~(size_t)15;
+    if (s->size < sizeof(void *)) {
+        s->size = 16;
+    }
+    if (per_chunk == 0) {
+        per_chunk = SLAB_CHUNK_BYTES / s->size;
+    }
+    s->per_chunk = per_chunk > 0 ? per_chunk : 1;
+}
+
+void *slab_alloc(struct slab *s) {
+    if (s->free == NULL) {
+        char *chunk = malloc(CHUNK_HEADER + s->size * s->per_chunk);
+        if (chunk == NULL) {
+            return NULL;
+        }
+        *(void **)chunk = s->chunks;
+        s->chunks = chunk;
+        for (unsigned i = s->per_chunk; i-- > 0;) {//thread the new objects onto the free list
+            char *obj = chunk + CHUNK_HEADER + i * s->size;
+
+            *(void **)obj = s->free;
+            s->free = obj;
+        }
+        __atomic_store_n(&s->objects, s->objects + s->per_chunk, __ATOMIC_RELAXED);//read by /__metrics
+    }
+
+    void *p = s->free;
+    s->free = *(void **)p;
+    s->in_use++;
+    return p;
+}
+
+void slab_free(struct slab *s, void *p) {
+    if (p == NULL) {
+        return;
+    }
+    *(void **)p = s->free;
+    s->free = p;
+    s->in_use--;
+}
+
+size_t slab_bytes(const struct slab *s) {
+    unsigned long objects = __atomic_load_n(&s->objects, __ATOMIC_RELAXED);
+
+    return s->per_chunk ? objects * s->size + (objects / s->per_chunk) * CHUNK_HEADER : 0;
+}
+
+void buf_pool_init(struct buf_pool *p) {
+    for (int i = 0; i < POOL_CLASSES; i++) {
+        size_t size = (size_t)1 << (POOL_MIN_SHIFT + i);
+
+        slab_init(&p->classes[i], size, size >= SLAB_CHUNK_BYTES ? 4 : 0);
+    }
+    p->large = 0;
+}
+
+// Size class for want bytes, -1 if it is too big for any
+static int class_of(size_t want) {
+    int i = 0;
+
+    while (i < POOL_CLASSES && ((size_t)1 << (POOL_MIN_SHIFT + i)) < want) {
+        i++;
+    }
+    return i < POOL_CLASSES ? i : -1;
+}
+
+void *buf_get(struct buf_pool *p, size_t want, size_t *cap) {
+    int i = class_of(want);
+
+    if (i < 0) {
+        void *buf = malloc(want);
+        if (buf != NULL) {
+            *cap = want;
+            p->large++;
+        }
+        return buf;
+    }
+    *cap = (size_t)1 << (POOL_MIN_SHIFT + i);
+    return slab_alloc(&p->classes[i]);
+}
+
+void buf_put(struct buf_pool *p, void *buf, size_t cap) {
+    if (buf == NULL) {
+        return;
+    }
+    int i = class_of(cap);
+    if (i < 0) {
+        free(buf);
+        p->large--;
+        return;
+    }
+    slab_free(&p->classes[i], buf);
+}
+
+void *buf_grow(struct buf_pool *p, void *buf, size_t used, size_t *cap, size_t want) {
+    size_t new_cap;
+
+    if (buf != NULL && want <= *cap) {
+        return buf;
+    }
+    if (want < *cap * 2) {
+        want = *cap * 2;
+    }
+    char *grown = buf_get(p, want, &new_cap);
+    if (grown == NULL) {
+        return NULL;
+    }
+    if (buf != NULL) {
+        memcpy(grown, buf, used);
+        buf_put(p, buf, *cap);
+    }
+    *cap = new_cap;
+    return grown;
+}
+
+size_t buf_pool_bytes(const struct buf_pool *p) {
+    size_t total = 0;
+
+    for (int i = 0; i < POOL_CLASSES; i++) {
+        total += slab_bytes(&p->classes[i]);
+    }
+    return total;
+}
+
+void arena_init(struct arena *a, struct buf_pool *bufs) {
+    memset(a, 0, sizeof(*a));
+    a->bufs = bufs;
+}
+
+void *arena_alloc(struct arena *a, size_t n) {
+    n = (n + 15) & ~(size_t)15;
+    if (a->head == NULL || (size_t)(a->end - a->cur) < n) {
+        size_t cap;
+        size_t want = n + sizeof(struct arena_chunk) > ARENA_CHUNK ? n + sizeof(struct arena_chunk) : ARENA_CHUNK;
+        struct arena_chunk *chunk = buf_get(a->bufs, want, &cap);
+
+        if (chunk == NULL) {
+            return NULL;
+        }
+        chunk->next = a->head;
+        chunk->cap = cap;
+        a->head = chunk;
+        a->cur = (char *)chunk + ((sizeof(*chunk) + 15) & ~(size_t)15);
+        a->end = (char *)chunk + cap;
+    }
+    a->last = a->cur;
+    a->cur += n;
+    return a->last;
+}
+
+void *arena_grow(struct arena *a, void *p, size_t old, size_t n) {
+    size_t aligned = (n + 15) & ~(size_t)15;
+
+    if (p != NULL && p == a->last && (size_t)(a->end - (char *)p) >= aligned) {
+        a->cur = (char *)p + aligned;
+        return p;
+    }
+
+    void *grown = arena_alloc(a, n);
+    if (grown != NULL && p != NULL) {
+        memcpy(grown, p, old < n ? old : n);
+    }
+    return grown;
+}
+
+void arena_reset(struct arena *a) {
+    if (a->head == NULL) {
+        return;
+    }
+    while (a->head->next != NULL) {//the oldest chunk is kept
+        struct arena_chunk *next = a->head->next;
+
+        buf_put(a->bufs, a->head, a->head->cap);
+        a->head = next;
+    }
+    a->cur = (char *)a->head + ((sizeof(*a->head) + 15) & ~(size_t)15);
+    a->end = (char *)a->head + a->head->cap;
+    a->last = NULL;
+}
@@ -0,0 +1,78 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+// Per-worker memory pools, so that serving requests in steady state never
+// calls malloc. Memory is taken from the system in chunks as the load grows
+// and kept on free lists afterwards, which makes a worker's footprint its
+// peak working set rather than whatever the allocator fragments into. Only
+// the owning worker touches its pools, so there is no locking.
+
+// Fixed-size objects (connections, FastCGI requests, CGI jobs) carved out of
+// chunks; freed objects are linked through their first word
+struct slab {
+    size_t size;            // object size, a multiple of 16
+    unsigned per_chunk;     // objects per chunk taken from the system
+    void *free;
+    void *chunks;           // linked through the chunk's first 16 bytes
+    unsigned long objects;  // carved so far, free or in use
+    unsigned long in_use;
+};
+
+// Buffers in power-of-two size classes from 4 KB to 256 KB, one slab each.
+// Larger requests go to malloc and back to free, counted in large.
+#define POOL_MIN_SHIFT 12
+#define POOL_MAX_SHIFT 18
+#define POOL_CLASSES (POOL_MAX_SHIFT - POOL_MIN_SHIFT + 1)
+
+struct buf_pool {
+    struct slab classes[POOL_CLASSES];
+    unsigned long large;    // oversized buffers handed out and not yet returned
+};
+
+// Bump allocator for scratch that dies with the request being dispatched;
+// chunks come from a buf_pool and all but the first go back on reset
+struct arena {
+    struct buf_pool *bufs;
+    struct arena_chunk *head; // newest chunk, allocations are carved from it
+    char *cur, *end;
+    char *last;             // most recent allocation, which can grow in place
+};
+
+void slab_init(struct slab *s, size_t size, unsigned per_chunk);
+
+// An uninitialized object, or NULL if the system is out of memory
+void *slab_alloc(struct slab *s);
+void slab_free(struct slab *s, void *p);
+
+// Bytes taken from the system
+size_t slab_bytes(const struct slab *s);
+
+void buf_pool_init(struct buf_pool *p);
+
+// A buffer of at least want bytes; *cap is set to its real size, which is
+// what buf_put and buf_grow need back. NULL if out of memory.
+void *buf_get(struct buf_pool *p, size_t want, size_t *cap);
+void buf_put(struct buf_pool *p, void *buf, size_t cap);
+
+// Like realloc: a buffer of at least want bytes holding the first used bytes
+// of buf (which may be NULL with *cap 0). On failure buf is left as it was.
+void *buf_grow(struct buf_pool *p, void *buf, size_t used, size_t *cap, size_t want);
+
+// Bytes the size classes took from the system
+size_t buf_pool_bytes(const struct buf_pool *p);
+
+void arena_init(struct arena *a, struct buf_pool *bufs);
+
+// n bytes aligned to 16, valid until arena_reset; NULL if out of memory
+void *arena_alloc(struct arena *a, size_t n);
+
+// Resize the allocation p (NULL for a new one) from old to n bytes, in place
+// when it is the arena's latest; the contents are kept
+void *arena_grow(struct arena *a, void *p, size_t old, size_t n);
+
+// Forget every allocation, keeping the first chunk for the next request
+void arena_reset(struct arena *a);
+
+#endif // POOL_H
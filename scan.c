@@ -0,0 +1,204 @@
+#include <string.h>
+#include <immintrin.h>
+#include "scan.h"
+
+// RFC 9110 token characters; the upper half of the table is all zero
+static const unsigned char tchar[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 1, 0, 1, 1, 1, 1, 1, 0, 0, 1, 1, 0, 1, 1, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0,
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0,
+};
+
+// The same set split by nibble for pshufb: byte b is a token character when
+// token_lo[b & 15] & token_hi[b >> 4] is non-zero (one bit per high nibble)
+static const unsigned char token_lo[16] __attribute__((aligned(16))) = {
+    0xe8, 0xfc, 0xf8, 0xfc, 0xfc, 0xfc, 0xfc, 0xfc, 0xf8, 0xf8, 0xf4, 0x54, 0xd0, 0x54, 0xf4, 0x70,
+};
+static const unsigned char token_hi[16] __attribute__((aligned(16))) = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+// Ranges for _mm_cmpestri: value stops at 00-08, 0a-1f and 7f; target at 00-20 and 7f
+static const char value_ranges[16] __attribute__((aligned(16))) = "\x00\x08\x0a\x1f\x7f\x7f";
+static const char uri_ranges[16] __attribute__((aligned(16))) = "\x00\x20\x7f\x7f";
+
+static size_t token_scalar(const char *buf, size_t len) {
+    size_t i = 0;
+
+    while (i < len && tchar[(unsigned char)buf[i]]) {
+        i++;
+    }
+    return i;
+}
+
+static size_t uri_scalar(const char *buf, size_t len) {
+    size_t i = 0;
+
+    while (i < len && (unsigned char)buf[i] > 0x20 && buf[i] != 0x7f) {
+        i++;
+    }
+    return i;
+}
+
+static size_t value_scalar(const char *buf, size_t len) {
+    size_t i = 0;
+
+    while (i < len && ((unsigned char)buf[i] >= 0x20 || buf[i] == '\t') && buf[i] != 0x7f) {
+        i++;
+    }
+    return i;
+}
+
+__attribute__((target("sse4.2")))
+static size_t token_sse42(const char *buf, size_t len) {
+    const __m128i lo_tbl = _mm_load_si128((const __m128i *)token_lo);
+    const __m128i hi_tbl = _mm_load_si128((const __m128i *)token_hi);
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(buf + i));
+        __m128i lo = _mm_shuffle_epi8(lo_tbl, _mm_and_si128(v, nibble));
+        __m128i hi = _mm_shuffle_epi8(hi_tbl, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i stop = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+        unsigned mask = _mm_movemask_epi8(stop);
+
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + token_scalar(buf + i, len - i);
+}
+
+__attribute__((target("sse4.2")))
+static size_t ranges_sse42(const char *buf, size_t len, const char *ranges, int nranges) {
+    const __m128i r = _mm_load_si128((const __m128i *)ranges);
+    size_t i = 0;
+
+    for (; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(buf + i));
+        int idx = _mm_cmpestri(r, nranges, v, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+
+        if (idx != 16) {
+            return i + idx;
+        }
+    }
+    return i;
+}
+
+__attribute__((target("sse4.2")))
+static size_t uri_sse42(const char *buf, size_t len) {
+    size_t i = ranges_sse42(buf, len, uri_ranges, 4);
+
+    return i + uri_scalar(buf + i, len - i);
+}
+
+__attribute__((target("sse4.2")))
+static size_t value_sse42(const char *buf, size_t len) {
+    size_t i = ranges_sse42(buf, len, value_ranges, 6);
+
+    return i + value_scalar(buf + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static size_t token_avx2(const char *buf, size_t len) {
+    const __m256i lo_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)token_lo));
+    const __m256i hi_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)token_hi));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(buf + i));
+        __m256i lo = _mm256_shuffle_epi8(lo_tbl, _mm256_and_si256(v, nibble));
+        __m256i hi = _mm256_shuffle_epi8(hi_tbl, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i stop = _mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256());
+        unsigned mask = _mm256_movemask_epi8(stop);
+
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    _mm256_zeroupper();//the SSE tail is not VEX encoded, avoid the transition stall
+    return i + token_sse42(buf + i, len - i);//most header names end inside 32 bytes
+}
+
+__attribute__((target("avx2")))
+static size_t uri_avx2(const char *buf, size_t len) {
+    const __m256i space = _mm256_set1_epi8(0x20);
+    const __m256i del = _mm256_set1_epi8(0x7f);
+    size_t i = 0;
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(buf + i));
+        __m256i low = _mm256_cmpeq_epi8(_mm256_min_epu8(v, space), v);//v <= 0x20
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(low, _mm256_cmpeq_epi8(v, del)));
+
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    _mm256_zeroupper();
+    return i + uri_sse42(buf + i, len - i);
+}
+
+__attribute__((target("avx2")))
+static size_t value_avx2(const char *buf, size_t len) {
+    const __m256i ctl = _mm256_set1_epi8(0x1f);
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i del = _mm256_set1_epi8(0x7f);
+    size_t i = 0;
+
+    for (; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(buf + i));
+        __m256i low = _mm256_cmpeq_epi8(_mm256_min_epu8(v, ctl), v);//v <= 0x1f
+        low = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, tab), low);
+        unsigned mask = _mm256_movemask_epi8(_mm256_or_si256(low, _mm256_cmpeq_epi8(v, del)));
+
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    _mm256_zeroupper();
+    return i + value_sse42(buf + i, len - i);
+}
+
+size_t (*scan_token)(const char *buf, size_t len) = token_scalar;
+size_t (*scan_uri)(const char *buf, size_t len) = uri_scalar;
+size_t (*scan_value)(const char *buf, size_t len) = value_scalar;
+static const char *impl = "scalar";
+
+int scan_select(const char *name) {
+    __builtin_cpu_init();
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        scan_token = token_avx2;
+        scan_uri = uri_avx2;
+        scan_value = value_avx2;
+    } else if (strcmp(name, "sse4.2") == 0 && __builtin_cpu_supports("sse4.2")) {
+        scan_token = token_sse42;
+        scan_uri = uri_sse42;
+        scan_value = value_sse42;
+    } else if (strcmp(name, "scalar") == 0) {
+        scan_token = token_scalar;
+        scan_uri = uri_scalar;
+        scan_value = value_scalar;
+    } else {
+        return -1;
+    }
+    impl = strcmp(name, "avx2") == 0 ? "avx2" : strcmp(name, "sse4.2") == 0 ? "sse4.2" : "scalar";
+    return 0;
+}
+
+void scan_init(void) {
+    if (scan_select("avx2") < 0 && scan_select("sse4.2") < 0) {
+        scan_select("scalar");
+    }
+}
+
+const char *scan_impl(void) {
+    return impl;
+}
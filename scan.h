@@ -0,0 +1,28 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stddef.h>
+
+// Byte-class scanners used by the request parser. Each returns the offset of
+// the first byte in buf[0..len) that ends the run, or len if none does.
+// Until scan_init() runs they use the portable scalar versions.
+
+// First byte that is not an RFC 9110 token character (method, header name)
+extern size_t (*scan_token)(const char *buf, size_t len);
+
+// First byte <= 0x20 or DEL (end of the request target)
+extern size_t (*scan_uri)(const char *buf, size_t len);
+
+// First control byte other than TAB, or DEL (end of a header value)
+extern size_t (*scan_value)(const char *buf, size_t len);
+
+// Pick the widest implementation this CPU supports (CPUID)
+void scan_init(void);
+
+// Force an implementation: "avx2", "sse4.2" or "scalar"; -1 if unsupported
+int scan_select(const char *name);
+
+// Name of the implementation in use
+const char *scan_impl(void);
+
+#endif // SCAN_H
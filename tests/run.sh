@@ -0,0 +1,140 @@
+#!/bin/sh
+# Functional checks against a fresh build of the working tree.
+#
+#   tests/run.sh
+#
+# Builds the server, serves a small docroot on $TEST_PORT (18090) and sends
+# requests with curl --path-as-is, so targets reach the server exactly as
+# written, or byte for byte through bash's /dev/tcp where curl would fix
+# them up. Each check prints ok or FAIL; the exit status is the number of
+# failures.
+set -e
+
+here=$(cd "$(dirname "$0")" && pwd)
+root=$(dirname "$here")
+port=${TEST_PORT:-18090}
+
+work=$(mktemp -d)
+server=
+cleanup() {
+    [ -n "$server" ] && kill "$server" 2>/dev/null && wait "$server" 2>/dev/null
+    rm -rf "$work"
+}
+trap cleanup EXIT INT TERM
+
+srcs=$(cd "$root" && ls *.c | grep -v -x -e nonane.c -e help.c -e mimegen.c -e mkpack.c)
+(cd "$root" && cc -O2 -pthread -o "$work/httpserve" $srcs -lz)
+
+mkdir -p "$work/www/images"
+echo '<html>images</html>' > "$work/www/images/index.html"
+mkdir "$work/www/a b"
+printf 'var x = 1;\n' > "$work/www/app.js"
+gzip -9 -c "$work/www/app.js" > "$work/www/app.js.gz"
+cat > "$work/www/post.cgi" <<'EOF'
+#!/bin/sh
+cat > /dev/null
+printf 'Content-Type: text/plain\r\n\r\nok\n'
+EOF
+chmod +x "$work/www/post.cgi"
+echo '<html>index</html>' > "$work/www/index.html"
+echo '<html>cold</html>' > "$work/www/cold.html"
+
+(cd "$work" && exec ./httpserve -o workers=1 -o access_log=off "$port" > server.log 2>&1) &
+server=$!
+for i in 1 2 3 4 5 6 7 8 9 10; do
+    grep -q "starting server" "$work/server.log" 2>/dev/null && break
+    sleep 0.2
+done
+sleep 0.3
+if ! kill -0 "$server" 2>/dev/null; then
+    cat "$work/server.log" >&2
+    exit 1
+fi
+
+failures=0
+
+# request TARGET [curl args...]: response head on stdout
+request() {
+    target=$1
+    shift
+    curl -s --path-as-is -D - -o /dev/null "$@" "http://127.0.0.1:$port$target" | tr -d '\r'
+}
+
+# raw BYTES: send them (printf escapes) on a fresh connection, response head on stdout.
+# One write, as the server may answer a bad head and close before more arrives.
+raw() {
+    printf "$1" > "$work/raw"
+    bash -c 'trap "" PIPE; exec 3<>/dev/tcp/127.0.0.1/$1 && cat "$2" >&3; timeout 2 cat <&3' raw "$port" "$work/raw" |
+        sed -n '1,/^\r$/p' | tr -d '\r'
+}
+
+# check NAME LINE COMMAND...: the head COMMAND prints must contain LINE
+check() {
+    name=$1
+    line=$2
+    shift 2
+    if "$@" | grep -q -x -F "$line"; then
+        echo "ok    $name"
+    else
+        echo "FAIL  $name: no \"$line\" in"
+        "$@" | sed 's/^/        /'
+        failures=$((failures + 1))
+    fi
+}
+
+# expect NAME TARGET LINE [curl args...]: the response head must contain LINE
+expect() {
+    name=$1
+    target=$2
+    line=$3
+    shift 3
+    check "$name" "$line" request "$target" "$@"
+}
+
+# expect_raw NAME BYTES LINE
+expect_raw() {
+    check "$1" "$3" raw "$2"
+}
+
+# Directory redirects name a path on this server, whatever the target looked like
+expect redirect_plain /images 'Location: /images/'
+expect redirect_query '/images?a=1' 'Location: /images/?a=1'
+expect redirect_double_slash //images 'Location: /images/'
+expect redirect_other_host //evil.example/../images 'Location: /images/'
+expect redirect_escaped /im%61ges 'Location: /images/'
+expect redirect_space '/a%20b' 'Location: /a%20b/'
+
+# A sidecar and the same file asked for directly are cached apart, in either order
+expect sidecar_direct_first /app.js.gz 'Content-Type: application/gzip'
+expect sidecar_after_direct /app.js 'Content-Encoding: gzip' -H 'Accept-Encoding: gzip'
+expect sidecar_after_direct_type /app.js 'Content-Type: text/javascript' -H 'Accept-Encoding: gzip'
+expect direct_after_sidecar /app.js.gz 'Content-Type: application/gzip'
+if request /app.js.gz | grep -q -i '^Content-Encoding'; then
+    echo "FAIL  direct_no_encoding: /app.js.gz sent with Content-Encoding"
+    failures=$((failures + 1))
+else
+    echo "ok    direct_no_encoding"
+fi
+
+# A conditional request for a file not yet cached is answered from its identity
+expect conditional_cold /cold.html 'HTTP/1.1 304 Not Modified' -H 'If-Modified-Since: Fri, 01 Jan 2100 00:00:00 GMT'
+expect conditional_then_body /cold.html 'HTTP/1.1 200 OK'
+
+# Request body framing: chunk sizes are bare hex, chunked is the last coding,
+# and a request with both framings does not keep the connection
+post='POST /post.cgi HTTP/1.1\r\nHost: t\r\n'
+expect_raw chunked_ok "${post}Transfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n" 'HTTP/1.1 200 OK'
+expect_raw chunk_size_negative "${post}Transfer-Encoding: chunked\r\n\r\n-1\r\nhello\r\n0\r\n\r\n" 'HTTP/1.1 400 Bad Request'
+expect_raw chunk_size_plus "${post}Transfer-Encoding: chunked\r\n\r\n+5\r\nhello\r\n0\r\n\r\n" 'HTTP/1.1 400 Bad Request'
+expect_raw chunk_size_0x "${post}Transfer-Encoding: chunked\r\n\r\n0x5\r\nhello\r\n0\r\n\r\n" 'HTTP/1.1 400 Bad Request'
+expect_raw chunk_size_space "${post}Transfer-Encoding: chunked\r\n\r\n 5\r\nhello\r\n0\r\n\r\n" 'HTTP/1.1 400 Bad Request'
+expect_raw chunk_size_16_digits "${post}Transfer-Encoding: chunked\r\n\r\n0000000000000005\r\nhello\r\n0\r\n\r\n" 'HTTP/1.1 400 Bad Request'
+expect_raw chunk_size_extension "${post}Transfer-Encoding: chunked\r\n\r\n5;a=b\r\nhello\r\n0\r\n\r\n" 'HTTP/1.1 200 OK'
+expect_raw te_not_chunked "${post}Transfer-Encoding: gzip\r\nContent-Length: 5\r\n\r\nhello" 'HTTP/1.1 400 Bad Request'
+expect_raw te_chunked_not_last "${post}Transfer-Encoding: chunked, gzip\r\n\r\n0\r\n\r\n" 'HTTP/1.1 400 Bad Request'
+expect_raw te_chunked_twice "${post}Transfer-Encoding: chunked\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n" 'HTTP/1.1 400 Bad Request'
+expect_raw te_unknown_coding "${post}Transfer-Encoding: gzip, chunked\r\n\r\n0\r\n\r\n" 'HTTP/1.1 501 Not Implemented'
+expect_raw cl_and_te_close "${post}Content-Length: 5\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n" 'Connection: close'
+expect_raw chunked_keeps_alive "${post}Transfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n" 'Connection: keep-alive'
+
+exit $failures
@@ -0,0 +1,128 @@
+#include <string.h>
+#include "timerwheel.h"
+
+#define LEVEL_MASK (TIMER_LEVEL_SLOTS - 1)
+#define WHEEL_SPAN (1L << (TIMER_LEVELS * TIMER_LEVEL_BITS)) // ticks the top level reaches
+
+void timer_wheel_init(struct timer_wheel *tw, long now_ms) {
+    memset(tw, 0, sizeof(*tw));
+    tw->tick = now_ms / TIMER_TICK_MS;
+}
+
+// Link t into the slot its expiry falls in, seen from the current tick
+static void wheel_add(struct timer_wheel *tw, struct timer *t) {
+    long delta = t->expires - tw->tick;
+    int level = 0;
+
+    if (delta < 0) {
+        t->expires = tw->tick;//overdue: the next tick run takes it
+        delta = 0;
+    } else if (delta >= WHEEL_SPAN) {
+        t->expires = tw->tick + WHEEL_SPAN - 1;
+        delta = WHEEL_SPAN - 1;
+    }
+    while (delta >= 1L << ((level + 1) * TIMER_LEVEL_BITS)) {
+        level++;
+    }
+
+    struct timer **slot = &tw->slots[level][(t->expires >> (level * TIMER_LEVEL_BITS)) & LEVEL_MASK];
+    t->next = *slot;
+    if (t->next != NULL) {
+        t->next->pprev = &t->next;
+    }
+    t->pprev = slot;
+    *slot = t;
+}
+
+static void wheel_unlink(struct timer *t) {
+    *t->pprev = t->next;
+    if (t->next != NULL) {
+        t->next->pprev = t->pprev;
+    }
+    t->next = NULL;
+    t->pprev = NULL;
+}
+
+void timer_arm(struct timer_wheel *tw, struct timer *t, long when_ms) {
+    if (t->pprev != NULL) {
+        wheel_unlink(t);
+    } else {
+        tw->armed++;
+    }
+    t->expires = (when_ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;//round up, never early
+    wheel_add(tw, t);
+}
+
+void timer_cancel(struct timer_wheel *tw, struct timer *t) {
+    if (t->pprev != NULL) {
+        wheel_unlink(t);
+        tw->armed--;
+    }
+}
+
+// Spread one slot of a higher level over the levels below it
+static void cascade(struct timer_wheel *tw, int level, int index) {
+    struct timer *t = tw->slots[level][index];
+
+    tw->slots[level][index] = NULL;
+    while (t != NULL) {
+        struct timer *next = t->next;
+
+        wheel_add(tw, t);
+        t = next;
+    }
+}
+
+void timer_wheel_run(struct timer_wheel *tw, long now_ms) {
+    long target = now_ms / TIMER_TICK_MS;
+
+    while (tw->tick <= target) {
+        if (tw->armed == 0) {
+            tw->tick = target + 1;//nothing to fire: skip the idle ticks
+            break;
+        }
+
+        int index = tw->tick & LEVEL_MASK;
+        if (index == 0) {//level 0 wrapped: bring the next slot of each level down
+            for (int level = 1; level < TIMER_LEVELS; level++) {
+                int i = (tw->tick >> (level * TIMER_LEVEL_BITS)) & LEVEL_MASK;
+
+                cascade(tw, level, i);
+                if (i != 0) {
+                    break;
+                }
+            }
+        }
+
+        struct timer *due = tw->slots[0][index];//detach the slot so callbacks can re-arm into it
+        tw->slots[0][index] = NULL;
+        if (due != NULL) {
+            due->pprev = &due;
+        }
+        tw->tick++;//timers re-armed as overdue land on the next tick, not this detached one
+        while (due != NULL) {
+            struct timer *t = due;
+
+            wheel_unlink(t);//a callback may cancel timers still on the detached list
+            tw->armed--;
+            t->fire(t);
+        }
+    }
+}
+
+int timer_wheel_timeout(const struct timer_wheel *tw, long now_ms, int max_ms) {
+    if (tw->armed == 0) {
+        return max_ms;
+    }
+
+    long tick = tw->tick;//first slot with a timer in it, or the next cascade
+    while ((tick & LEVEL_MASK) != 0 && tw->slots[0][tick & LEVEL_MASK] == NULL) {
+        tick++;
+    }
+
+    long ms = tick * TIMER_TICK_MS - now_ms;
+    if (ms < 0) {
+        return 0;
+    }
+    return ms < max_ms ? (int)ms : max_ms;
+}
@@ -0,0 +1,56 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+// Hierarchical timing wheel for a worker's deadlines: header reads, idle
+// keep-alive, stalled sends, CGI scripts and the once-a-second housekeeping.
+// A timer is an intrusive node in its owner, so arming and cancelling are a
+// few pointer writes with no allocation, however many are armed.
+//
+// Time advances in ticks of TIMER_TICK_MS. Level 0 has one slot per tick for
+// the next 64 ticks; each level above has slots 64 times as wide, and a slot
+// is redistributed into the levels below when the wheel reaches it (the
+// classic cascading wheel). Timers never fire early; they fire on the first
+// tick at or after their deadline, and deadlines beyond the top level (about
+// 19 days) are cut short to it.
+//
+// Only the owning worker touches its wheel, so there is no locking.
+
+#define TIMER_TICK_MS 100
+#define TIMER_LEVEL_BITS 6
+#define TIMER_LEVEL_SLOTS (1 << TIMER_LEVEL_BITS)
+#define TIMER_LEVELS 4
+
+struct timer {
+    struct timer *next;
+    struct timer **pprev;   // what points at this timer, NULL when not armed
+    long expires;           // tick it is due on
+    void (*fire)(struct timer *t); // called once due, with the timer no longer armed
+};
+
+struct timer_wheel {
+    long tick;              // next tick to run
+    unsigned long armed;
+    struct timer *slots[TIMER_LEVELS][TIMER_LEVEL_SLOTS];
+};
+
+// Start an empty wheel at monotonic time now_ms
+void timer_wheel_init(struct timer_wheel *tw, long now_ms);
+
+// (Re)arm t to fire at monotonic time when_ms; t->fire must be set
+void timer_arm(struct timer_wheel *tw, struct timer *t, long when_ms);
+
+// Disarm t if it is armed
+void timer_cancel(struct timer_wheel *tw, struct timer *t);
+
+static inline int timer_pending(const struct timer *t) {
+    return t->pprev != NULL;
+}
+
+// Fire every timer due by now_ms. Callbacks may arm and cancel any timer.
+void timer_wheel_run(struct timer_wheel *tw, long now_ms);
+
+// Milliseconds the event loop may sleep before the wheel needs to run
+// again, at most max_ms
+int timer_wheel_timeout(const struct timer_wheel *tw, long now_ms, int max_ms);
+
+#endif // TIMERWHEEL_H
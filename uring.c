@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "uring.h"
+
+static int sys_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags,
+                     const void *arg, size_t argsz) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+static int sys_register(int fd, unsigned op, const void *arg, unsigned n) {
+    return (int)syscall(__NR_io_uring_register, fd, op, arg, n);
+}
+
+// Whether the kernel knows opcode op
+static int supports(int fd, unsigned op) {
+    size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *probe = calloc(1, size);
+    int ok = 0;
+
+    if (probe != NULL && sys_register(fd, IORING_REGISTER_PROBE, probe, 256) == 0) {
+        ok = op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+    }
+    free(probe);
+    return ok;
+}
+
+int uring_init(struct uring *u, unsigned entries, int sqpoll) {
+    struct io_uring_params p;
+    int fd;
+
+    memset(u, 0, sizeof(*u));
+    u->fd = -1;
+    memset(&p, 0, sizeof(p));
+    if (sqpoll) {
+        p.flags = IORING_SETUP_SQPOLL;
+        p.sq_thread_idle = 1000;
+    } else {//only this thread submits, and completions can wait for its next io_uring_enter
+        p.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN;
+    }
+    p.flags |= IORING_SETUP_CQSIZE;
+    p.cq_entries = entries * 4;//room for multishot completions arriving in bursts
+    fd = sys_setup(entries, &p);
+    if (fd < 0 && errno == EINVAL && !sqpoll) {//kernels before 6.0 lack SINGLE_ISSUER
+        p.flags &= ~(IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_COOP_TASKRUN);
+        fd = sys_setup(entries, &p);
+    }
+    if (fd < 0) {
+        return -errno;
+    }
+    u->fd = fd;
+    u->sqpoll = sqpoll;
+
+    // Ask for 5.19, which the socket opcode marks: the probe can report it
+    // where the rest of what the loop relies on cannot be asked for
+    if (!(p.features & IORING_FEAT_EXT_ARG) || !(p.features & IORING_FEAT_NODROP) ||
+        !supports(fd, IORING_OP_SOCKET)) {
+        uring_exit(u);
+        return -EOPNOTSUPP;
+    }
+
+    u->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (u->cq_ring_size > u->sq_ring_size) {
+            u->sq_ring_size = u->cq_ring_size;
+        }
+        u->cq_ring_size = u->sq_ring_size;
+    }
+    u->sq_ring = mmap(NULL, u->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      fd, IORING_OFF_SQ_RING);
+    if (u->sq_ring == MAP_FAILED) {
+        u->sq_ring = NULL;
+        goto fail;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        u->cq_ring = u->sq_ring;
+    } else {
+        u->cq_ring = mmap(NULL, u->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          fd, IORING_OFF_CQ_RING);
+        if (u->cq_ring == MAP_FAILED) {
+            u->cq_ring = NULL;
+            goto fail;
+        }
+    }
+    u->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED) {
+        u->sqes = NULL;
+        goto fail;
+    }
+
+    char *sq = u->sq_ring, *cq = u->cq_ring;
+    u->sq_head = (unsigned *)(sq + p.sq_off.head);
+    u->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    u->sq_flags = (unsigned *)(sq + p.sq_off.flags);
+    u->sq_mask = *(unsigned *)(sq + p.sq_off.ring_mask);
+    u->sq_entries = p.sq_entries;
+    u->cq_head = (unsigned *)(cq + p.cq_off.head);
+    u->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    u->cq_mask = *(unsigned *)(cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+    // Slots are always used in order, so the index array maps each to itself
+    unsigned *array = (unsigned *)(sq + p.sq_off.array);
+    for (unsigned i = 0; i < p.sq_entries; i++) {
+        array[i] = i;
+    }
+    return 0;
+
+fail:;
+    int err = -errno;
+    uring_exit(u);
+    return err;
+}
+
+void uring_exit(struct uring *u) {
+    if (u->sqes != NULL) {
+        munmap(u->sqes, u->sqes_size);
+    }
+    if (u->cq_ring != NULL && u->cq_ring != u->sq_ring) {
+        munmap(u->cq_ring, u->cq_ring_size);
+    }
+    if (u->sq_ring != NULL) {
+        munmap(u->sq_ring, u->sq_ring_size);
+    }
+    if (u->fd >= 0) {
+        close(u->fd);
+    }
+    memset(u, 0, sizeof(*u));
+    u->fd = -1;
+}
+
+// Hand the prepared entries to the kernel, waiting for a completion if wait
+static int enter(struct uring *u, int wait, int timeout_ms) {
+    unsigned submit = u->sq_pending;
+    unsigned flags = 0;
+
+    if (submit > 0) {
+        __atomic_store_n(u->sq_tail, *u->sq_tail + submit, __ATOMIC_RELEASE);
+        u->sq_pending = 0;
+    }
+    if (u->sqpoll) {//the poller thread picks them up unless it went to sleep
+        if (__atomic_load_n(u->sq_flags, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP) {
+            flags |= IORING_ENTER_SQ_WAKEUP;
+        }
+        submit = 0;
+    }
+    if (!wait && submit == 0 && flags == 0) {
+        return 0;
+    }
+
+    struct __kernel_timespec ts = {
+        .tv_sec = timeout_ms / 1000,
+        .tv_nsec = (long long)(timeout_ms % 1000) * 1000000,
+    };
+    struct io_uring_getevents_arg arg = {
+        .sigmask_sz = _NSIG / 8,
+        .ts = (uintptr_t)&ts,
+    };
+    if (wait) {
+        flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    }
+    int r = sys_enter(u->fd, submit, wait ? 1 : 0, flags, wait ? &arg : NULL, wait ? sizeof(arg) : 0);
+    if (r < 0 && errno != ETIME && errno != EINTR) {
+        return -errno;
+    }
+    return 0;
+}
+
+struct io_uring_sqe *uring_get_sqe(struct uring *u) {
+    unsigned tail = *u->sq_tail + u->sq_pending;
+
+    if (tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE) >= u->sq_entries) {
+        enter(u, 0, 0);
+        tail = *u->sq_tail + u->sq_pending;
+        if (tail - __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE) >= u->sq_entries) {
+            return NULL;
+        }
+    }
+
+    struct io_uring_sqe *sqe = &u->sqes[tail & u->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    u->sq_pending++;
+    return sqe;
+}
+
+int uring_submit_and_wait(struct uring *u, int timeout_ms) {
+    // Completions left over mean the caller has work already; only submit
+    int idle = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE) == *u->cq_head;
+    return enter(u, idle, timeout_ms);
+}
+
+struct io_uring_cqe *uring_peek_cqe(struct uring *u) {
+    unsigned head = *u->cq_head;
+
+    if (head == __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+    return &u->cqes[head & u->cq_mask];
+}
+
+void uring_cqe_seen(struct uring *u) {
+    __atomic_store_n(u->cq_head, *u->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+int uring_register_files(struct uring *u, const int *fds, unsigned n) {
+    if (sys_register(u->fd, IORING_REGISTER_FILES, fds, n) < 0) {
+        return -errno;
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#ifndef URING_H
+#define URING_H
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <linux/io_uring.h>
+
+// Thin io_uring wrapper straight over the system calls, no liburing. One
+// ring per worker, used only by that worker's thread. Submissions are
+// queued with uring_get_sqe() and a prep helper, then handed to the kernel
+// together with the wait for completions in a single io_uring_enter().
+
+struct uring {
+    int fd;
+    int sqpoll;             // a kernel thread polls the submission queue
+
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_flags;
+    unsigned sq_mask;
+    unsigned sq_entries;
+    unsigned sq_pending;    // prepared since the last submit
+    struct io_uring_sqe *sqes;
+
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void *sq_ring, *cq_ring;
+    size_t sq_ring_size, cq_ring_size, sqes_size;
+};
+
+// Set up a ring with room for entries submissions. Returns 0, or a negative
+// errno if the kernel lacks io_uring or any feature the server relies on
+// (multishot poll, timed waits), in which case the caller stays on epoll.
+int uring_init(struct uring *u, unsigned entries, int sqpoll);
+
+void uring_exit(struct uring *u);
+
+// A cleared submission slot, or NULL if the queue is full even after
+// submitting what was already in it
+struct io_uring_sqe *uring_get_sqe(struct uring *u);
+
+// Submit queued entries and, unless completions are already waiting, sleep
+// until one arrives or timeout_ms passes. Returns 0 or a negative errno.
+int uring_submit_and_wait(struct uring *u, int timeout_ms);
+
+// Oldest unconsumed completion, or NULL; release it with uring_cqe_seen()
+struct io_uring_cqe *uring_peek_cqe(struct uring *u);
+void uring_cqe_seen(struct uring *u);
+
+// Register fds as fixed files 0..n-1, for IOSQE_FIXED_FILE submissions
+int uring_register_files(struct uring *u, const int *fds, unsigned n);
+
+static inline void uring_prep_rw(struct io_uring_sqe *sqe, int op, int fd, const void *addr,
+                                 unsigned len, uint64_t off, uint64_t user_data) {
+    sqe->opcode = op;
+    sqe->fd = fd;
+    sqe->addr = (uintptr_t)addr;
+    sqe->len = len;
+    sqe->off = off;
+    sqe->user_data = user_data;
+}
+
+// Accept one connection on the fixed listener file, its peer written to
+// addr. One shot: a multishot accept reuses addr for every connection, which
+// is overwritten before its completions are read.
+static inline void uring_prep_accept(struct io_uring_sqe *sqe, int fixed_fd, struct sockaddr *addr,
+                                     socklen_t *addrlen, int flags, uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_ACCEPT, fixed_fd, addr, 0, (uintptr_t)addrlen, user_data);
+    sqe->flags |= IOSQE_FIXED_FILE;
+    sqe->accept_flags = flags;
+}
+
+static inline void uring_prep_recv(struct io_uring_sqe *sqe, int fd, void *buf, size_t len,
+                                   uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_RECV, fd, buf, len, 0, user_data);
+}
+
+static inline void uring_prep_send(struct io_uring_sqe *sqe, int fd, const void *buf, size_t len,
+                                   int flags, uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_SEND, fd, buf, len, 0, user_data);
+    sqe->msg_flags = flags;
+}
+
+static inline void uring_prep_sendmsg(struct io_uring_sqe *sqe, int fd, const struct msghdr *msg,
+                                      int flags, uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_SENDMSG, fd, msg, 1, 0, user_data);
+    sqe->msg_flags = flags;
+}
+
+// One-shot poll, or multishot when multi is set
+static inline void uring_prep_poll(struct io_uring_sqe *sqe, int fd, unsigned events, int multi,
+                                   uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_POLL_ADD, fd, NULL, multi ? IORING_POLL_ADD_MULTI : 0, 0, user_data);
+    sqe->poll32_events = events;
+}
+
+// Cancel the request submitted with user_data target
+static inline void uring_prep_cancel(struct io_uring_sqe *sqe, uint64_t target, uint64_t user_data) {
+    uring_prep_rw(sqe, IORING_OP_ASYNC_CANCEL, -1, (void *)(uintptr_t)target, 0, 0, user_data);
+}
+
+#endif // URING_H